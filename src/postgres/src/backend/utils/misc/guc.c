@@ -130,6 +130,7 @@ extern bool optimize_bounded_sort;
 
 static double yb_transaction_priority_lower_bound = 0.0;
 static double yb_transaction_priority_upper_bound = 1.0;
+static int	yb_follower_read_staleness_ms = 0;
 
 static int	GUC_check_errcode_value;
 
@@ -202,6 +203,7 @@ static const char *show_data_directory_mode(void);
 
 extern void YBCAssignTransactionPriorityLowerBound(double newval, void* extra);
 extern void YBCAssignTransactionPriorityUpperBound(double newval, void* extra);
+extern void YBCAssignFollowerReadStalenessMs(int newval, void* extra);
 
 /* Private functions in guc-file.l that need to be called from guc.c */
 static ConfigVariable *ProcessConfigFileInternal(GucContext context,
@@ -3085,6 +3087,18 @@ static struct config_int ConfigureNamesInt[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"yb_follower_read_staleness_ms", PGC_USERSET, CLIENT_CONN_STATEMENT,
+			gettext_noop("Sets the maximum staleness of data read by read only transactions "
+						 "from the closest replica."),
+			gettext_noop("A value of 0 turns off follower reads."),
+			GUC_UNIT_MS
+		},
+		&yb_follower_read_staleness_ms,
+		0, 0, INT_MAX,
+		NULL, YBCAssignFollowerReadStalenessMs, NULL
+	},
+
 	/* End-of-list marker */
 	{
 		{NULL, 0, 0, NULL, NULL}, NULL, 0, 0, 0, NULL, NULL, NULL
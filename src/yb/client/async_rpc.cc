@@ -110,7 +110,8 @@ AsyncRpc::AsyncRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
       batcher_(data->batcher),
       trace_(new Trace),
       tablet_invoker_(LocalTabletServerOnly(data->ops),
-                      yb_consistency_level == YBConsistencyLevel::CONSISTENT_PREFIX,
+                      yb_consistency_level == YBConsistencyLevel::CONSISTENT_PREFIX ||
+                          yb_consistency_level == YBConsistencyLevel::BOUNDED_STALENESS,
                       data->batcher->client_,
                       this,
                       this,
@@ -118,6 +119,8 @@ AsyncRpc::AsyncRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
                       mutable_retrier(),
                       trace_.get()),
       ops_(std::move(data->ops)),
+      segments_(std::move(data->segments)),
+      finished_callback_(std::move(data->finished_callback)),
       start_(MonoTime::Now()),
       async_rpc_metrics_(data->batcher->async_rpc_metrics()) {
   mutable_retrier()->mutable_controller()->set_allow_local_calls_in_curr_thread(
@@ -141,7 +144,7 @@ void AsyncRpc::SendRpc() {
 
   retained_self_ = shared_from_this();
   // For now, if this is a retry, execute this rpc on the leader even if
-  // the consistency level is YBConsistencyLevel::CONSISTENT_PREFIX or
+  // the consistency level is YBConsistencyLevel::CONSISTENT_PREFIX, BOUNDED_STALENESS or
   // FLAGS_redis_allow_reads_from_followers is set to true.
   // TODO(hector): Temporarily blacklist the follower that couldn't serve the read so we can retry
   // on another follower.
@@ -165,8 +168,22 @@ void AsyncRpc::Finished(const Status& status) {
   Status new_status = status;
   if (tablet_invoker_.Done(&new_status)) {
     ProcessResponseFromTserver(new_status);
-    batcher_->RemoveInFlightOpsAfterFlushing(ops_, new_status, MakeFlushExtraResult());
-    batcher_->CheckForFinishedFlush();
+    if (segments_.empty()) {
+      batcher_->RemoveInFlightOpsAfterFlushing(ops_, new_status, MakeFlushExtraResult());
+      batcher_->CheckForFinishedFlush();
+    } else {
+      const auto flush_extra_result = MakeFlushExtraResult();
+      ForEachSegment([this, &new_status, &flush_extra_result](
+          Batcher* batcher, size_t begin, size_t end) {
+        batcher->RemoveInFlightOpsAfterFlushing(
+            InFlightOps(ops_.begin() + begin, ops_.begin() + end), new_status,
+            flush_extra_result);
+        batcher->CheckForFinishedFlush();
+      });
+    }
+    if (finished_callback_) {
+      finished_callback_();
+    }
     retained_self_.reset();
   }
 }
@@ -284,6 +301,14 @@ AsyncRpcBase<Req, Resp>::AsyncRpcBase(AsyncRpcData* data, YBConsistencyLevel con
       }
     }
   }
+  // Coalesced RPC should carry the latest hybrid time observed by any of its batchers.
+  for (const auto& segment : segments_) {
+    const ConsistentReadPoint* segment_read_point = segment.batcher->read_point();
+    if (segment_read_point) {
+      req_.set_propagated_hybrid_time(std::max<uint64_t>(
+          req_.propagated_hybrid_time(), segment_read_point->Now().ToUint64()));
+    }
+  }
   auto& transaction_metadata = batcher_->transaction_metadata();
   if (!transaction_metadata.transaction_id.is_nil()) {
     SetTransactionMetadata(transaction_metadata, &req_);
@@ -552,7 +577,9 @@ void WriteRpc::ProcessResponseFromTserver(const Status& status) {
   if (resp_.has_trace_buffer()) {
     TRACE_TO(trace_, "Received from server: $0", resp_.trace_buffer());
   }
-  batcher_->ProcessWriteResponse(*this, status);
+  ForEachSegment([this, &status](Batcher* batcher, size_t begin, size_t end) {
+    batcher->ProcessWriteResponse(*this, status, begin, end);
+  });
   if (!CommonResponseCheck(status)) {
     SwapRequestsAndResponses(true);
     return;
@@ -567,6 +594,8 @@ ReadRpc::ReadRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
   req_.set_consistency_level(yb_consistency_level);
   req_.set_proxy_uuid(data->batcher->proxy_uuid());
 
+  // The whole batch is served by the same replica, so it uses the tightest bound of its ops.
+  int64_t max_staleness_ms = std::numeric_limits<int64_t>::max();
   int ctr = 0;
   for (auto& op : ops_) {
     switch (op->yb_op->type()) {
@@ -587,6 +616,9 @@ ReadRpc::ReadRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
         if (ql_op->read_time()) {
           ql_op->read_time().AddToPB(&req_);
         }
+        if (ql_op->max_staleness().Initialized()) {
+          max_staleness_ms = std::min(max_staleness_ms, ql_op->max_staleness().ToMilliseconds());
+        }
         break;
       }
       case YBOperation::Type::PGSQL_READ: {
@@ -596,6 +628,10 @@ ReadRpc::ReadRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
         if (pgsql_op->read_time()) {
           pgsql_op->read_time().AddToPB(&req_);
         }
+        if (pgsql_op->max_staleness().Initialized()) {
+          max_staleness_ms = std::min(
+              max_staleness_ms, pgsql_op->max_staleness().ToMilliseconds());
+        }
         break;
       }
       case YBOperation::Type::PGSQL_WRITE: FALLTHROUGH_INTENDED;
@@ -611,6 +647,11 @@ ReadRpc::ReadRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
     VLOG(4) << ++ctr << ". Encoded row " << op->yb_op->ToString();
   }
 
+  if (yb_consistency_level == YBConsistencyLevel::BOUNDED_STALENESS) {
+    req_.set_max_staleness_ms(
+        max_staleness_ms == std::numeric_limits<int64_t>::max() ? 0 : max_staleness_ms);
+  }
+
   if (VLOG_IS_ON(3)) {
     VLOG(3) << "Created batch for " << data->tablet->tablet_id() << ":\n"
             << req_.ShortDebugString();
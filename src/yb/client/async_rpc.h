@@ -46,12 +46,23 @@ struct AsyncRpcMetrics {
   scoped_refptr<Histogram> time_to_send;
 };
 
+// Ops of a coalesced RPC that belong to the same batcher, see WriteCoalescer.
+struct AsyncRpcSegment {
+  scoped_refptr<Batcher> batcher;
+  // Index of the op next to the last op of this segment.
+  size_t end;
+};
+
 struct AsyncRpcData {
   scoped_refptr<Batcher> batcher;
   RemoteTablet* tablet = nullptr;
   bool allow_local_calls_in_curr_thread = false;
   bool need_consistent_read = false;
   InFlightOps ops;
+  // Filled only when RPC contains ops of several batchers, ops of each batcher are contiguous.
+  std::vector<AsyncRpcSegment> segments;
+  // Invoked after the response was processed.
+  std::function<void()> finished_callback;
 };
 
 struct FlushExtraResult {
@@ -102,6 +113,20 @@ class AsyncRpc : public rpc::Rpc, public TabletRpc {
   // Is this a local call?
   bool IsLocalCall() const;
 
+  // Invokes f(batcher, begin, end) for ops [begin, end) of each batcher of this RPC.
+  template <class F>
+  void ForEachSegment(const F& f) const {
+    if (segments_.empty()) {
+      f(batcher_.get(), 0, ops_.size());
+      return;
+    }
+    size_t begin = 0;
+    for (const auto& segment : segments_) {
+      f(segment.batcher.get(), begin, segment.end);
+      begin = segment.end;
+    }
+  }
+
   // Pointer back to the batcher. Processes the write response when it
   // completes, regardless of success or failure.
   scoped_refptr<Batcher> batcher_;
@@ -115,6 +140,10 @@ class AsyncRpc : public rpc::Rpc, public TabletRpc {
   // These operations are in kRequestSent state.
   InFlightOps ops_;
 
+  // Batchers of coalesced ops, empty when all ops belong to batcher_.
+  std::vector<AsyncRpcSegment> segments_;
+  std::function<void()> finished_callback_;
+
   MonoTime start_;
   std::shared_ptr<AsyncRpcMetrics> async_rpc_metrics_;
   rpc::RpcCommandPtr retained_self_;
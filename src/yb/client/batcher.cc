@@ -54,6 +54,7 @@
 #include "yb/client/session.h"
 #include "yb/client/table.h"
 #include "yb/client/transaction.h"
+#include "yb/client/write_coalescer.h"
 #include "yb/client/yb_op.h"
 
 #include "yb/common/wire_protocol.h"
@@ -455,7 +456,8 @@ void Batcher::TransactionReady(const Status& status, const BatcherPtr& self) {
   }
 }
 
-YB_DEFINE_ENUM(OpGroup, (kWrite)(kLeaderRead)(kConsistentPrefixRead));
+YB_DEFINE_ENUM(OpGroup,
+               (kWrite)(kLeaderRead)(kConsistentPrefixRead)(kBoundedStalenessRead));
 
 namespace {
 inline bool IsOkToReadFromFollower(const InFlightOpPtr& op) {
@@ -468,6 +470,19 @@ inline bool IsQLConsistentPrefixRead(const InFlightOpPtr& op) {
          std::static_pointer_cast<YBqlReadOp>(op->yb_op)->yb_consistency_level() ==
          YBConsistencyLevel::CONSISTENT_PREFIX;
 }
+
+inline bool IsBoundedStalenessRead(const InFlightOpPtr& op) {
+  switch (op->yb_op->type()) {
+    case YBOperation::Type::QL_READ:
+      return std::static_pointer_cast<YBqlReadOp>(op->yb_op)->yb_consistency_level() ==
+             YBConsistencyLevel::BOUNDED_STALENESS;
+    case YBOperation::Type::PGSQL_READ:
+      return std::static_pointer_cast<YBPgsqlReadOp>(op->yb_op)->yb_consistency_level() ==
+             YBConsistencyLevel::BOUNDED_STALENESS;
+    default:
+      return false;
+  }
+}
 } // namespace
 
 OpGroup GetOpGroup(const InFlightOpPtr& op) {
@@ -477,6 +492,9 @@ OpGroup GetOpGroup(const InFlightOpPtr& op) {
   if (IsOkToReadFromFollower(op) || IsQLConsistentPrefixRead(op)) {
     return OpGroup::kConsistentPrefixRead;
   }
+  if (IsBoundedStalenessRead(op)) {
+    return OpGroup::kBoundedStalenessRead;
+  }
 
   return OpGroup::kLeaderRead;
 }
@@ -562,6 +580,22 @@ void Batcher::ExecuteOperations() {
   // Use big enough value for preallocated storage, to avoid unnecessary allocations.
   boost::container::small_vector<std::shared_ptr<AsyncRpc>, 40> rpcs;
 
+  // Non-transactional writes could be coalesced with writes of other sessions.
+  WriteCoalescer* coalescer = !transaction && WriteCoalescer::Enabled()
+      ? client_->data_->write_coalescer_.get() : nullptr;
+  auto add_rpc = [this, coalescer, &rpcs](
+      InFlightOps::const_iterator begin, InFlightOps::const_iterator end,
+      bool allow_local_calls_in_curr_thread, bool need_consistent_read) {
+    auto* tablet = begin->get()->tablet.get();
+    if (coalescer && GetOpGroup(*begin) == OpGroup::kWrite &&
+        WriteCoalescer::CanCoalesce(begin, end)) {
+      coalescer->Add(this, tablet, begin, end);
+      return;
+    }
+    rpcs.push_back(CreateRpc(
+        tablet, begin, end, allow_local_calls_in_curr_thread, need_consistent_read));
+  };
+
   // Now flush the ops for each tablet.
   auto start = ops_queue_.begin();
   auto start_group = GetOpGroup(*start);
@@ -574,9 +608,7 @@ void Batcher::ExecuteOperations() {
       // Consistent read is not required when whole batch fits into one command.
       bool need_consistent_read = force_consistent_read || start != ops_queue_.begin() ||
                                   it != ops_queue_.end();
-      rpcs.push_back(CreateRpc(
-          start->get()->tablet.get(), start, it, /* allow_local_calls_in_curr_thread */ false,
-          need_consistent_read));
+      add_rpc(start, it, /* allow_local_calls_in_curr_thread */ false, need_consistent_read);
       start = it;
       start_group = it_group;
     }
@@ -584,9 +616,7 @@ void Batcher::ExecuteOperations() {
 
   // Consistent read is not required when whole batch fits into one command.
   bool need_consistent_read = force_consistent_read || start != ops_queue_.begin();
-  rpcs.push_back(CreateRpc(
-      start->get()->tablet.get(), start, ops_queue_.end(),
-      allow_local_calls_in_curr_thread_, need_consistent_read));
+  add_rpc(start, ops_queue_.end(), allow_local_calls_in_curr_thread_, need_consistent_read);
 
   LOG_IF(DFATAL, ops_number != ops_queue_.size())
     << "Ops queue was modified while creating RPCs";
@@ -653,6 +683,8 @@ std::shared_ptr<AsyncRpc> Batcher::CreateRpc(
       return std::make_shared<ReadRpc>(&data);
     case OpGroup::kConsistentPrefixRead:
       return std::make_shared<ReadRpc>(&data, YBConsistencyLevel::CONSISTENT_PREFIX);
+    case OpGroup::kBoundedStalenessRead:
+      return std::make_shared<ReadRpc>(&data, YBConsistencyLevel::BOUNDED_STALENESS);
   }
   FATAL_INVALID_ENUM_VALUE(OpGroup, op_group);
 }
@@ -683,7 +715,8 @@ void Batcher::RemoveInFlightOpsAfterFlushing(
   }
 }
 
-void Batcher::ProcessRpcStatus(const AsyncRpc &rpc, const Status &s) {
+void Batcher::ProcessRpcStatus(
+    const AsyncRpc &rpc, const Status &s, size_t begin, size_t end) {
   // TODO: there is a potential race here -- if the Batcher gets destructed while
   // RPCs are in-flight, then accessing state_ will crash. We probably need to keep
   // track of the in-flight RPCs, and in the destructor, change each of them to an
@@ -697,18 +730,19 @@ void Batcher::ProcessRpcStatus(const AsyncRpc &rpc, const Status &s) {
 
   if (PREDICT_FALSE(!s.ok())) {
     // Mark each of the ops as failed, since the whole RPC failed.
-    for (auto& in_flight_op : rpc.ops()) {
-      CombineErrorUnlocked(in_flight_op, s);
+    for (auto i = begin; i != end; ++i) {
+      CombineErrorUnlocked(rpc.ops()[i], s);
     }
   }
 }
 
 void Batcher::ProcessReadResponse(const ReadRpc &rpc, const Status &s) {
-  ProcessRpcStatus(rpc, s);
+  ProcessRpcStatus(rpc, s, 0, rpc.ops().size());
 }
 
-void Batcher::ProcessWriteResponse(const WriteRpc &rpc, const Status &s) {
-  ProcessRpcStatus(rpc, s);
+void Batcher::ProcessWriteResponse(
+    const WriteRpc &rpc, const Status &s, size_t begin, size_t end) {
+  ProcessRpcStatus(rpc, s, begin, end);
 
   if (s.ok() && rpc.resp().has_propagated_hybrid_time()) {
     client_->data_->UpdateLatestObservedHybridTime(rpc.resp().propagated_hybrid_time());
@@ -720,11 +754,18 @@ void Batcher::ProcessWriteResponse(const WriteRpc &rpc, const Status &s) {
     // like the tablet not being hosted?
 
     if (err_pb.row_index() >= rpc.ops().size()) {
-      LOG(ERROR) << "Received a per_row_error for an out-of-bound op index "
-                 << err_pb.row_index() << " (sent only "
-                 << rpc.ops().size() << " ops)";
-      LOG(ERROR) << "Response from tablet " << rpc.tablet().tablet_id() << ":\n"
-                 << rpc.resp().DebugString();
+      // Reported only once per RPC, by the batcher of its first op.
+      if (begin == 0) {
+        LOG(ERROR) << "Received a per_row_error for an out-of-bound op index "
+                   << err_pb.row_index() << " (sent only "
+                   << rpc.ops().size() << " ops)";
+        LOG(ERROR) << "Response from tablet " << rpc.tablet().tablet_id() << ":\n"
+                   << rpc.resp().DebugString();
+      }
+      continue;
+    }
+    if (err_pb.row_index() < begin || err_pb.row_index() >= end) {
+      // Op belongs to another batcher of the coalesced RPC.
       continue;
     }
     shared_ptr<YBOperation> yb_op = rpc.ops()[err_pb.row_index()]->yb_op;
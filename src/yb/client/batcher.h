@@ -237,10 +237,11 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
   // Cleans up an RPC response, scooping out any errors and passing them up
   // to the batcher.
   void ProcessReadResponse(const ReadRpc &rpc, const Status &s);
-  void ProcessWriteResponse(const WriteRpc &rpc, const Status &s);
+  // Ops [begin, end) of the write RPC belong to this batcher.
+  void ProcessWriteResponse(const WriteRpc &rpc, const Status &s, size_t begin, size_t end);
 
-  // Process RPC status.
-  void ProcessRpcStatus(const AsyncRpc &rpc, const Status &s);
+  // Process RPC status for ops [begin, end) of the RPC.
+  void ProcessRpcStatus(const AsyncRpc &rpc, const Status &s, size_t begin, size_t end);
 
   // Async Callbacks.
   void TabletLookupFinished(InFlightOpPtr op, const Result<internal::RemoteTabletPtr>& result);
@@ -39,6 +39,7 @@
 #include <vector>
 
 #include "yb/client/client.h"
+#include "yb/client/write_coalescer.h"
 #include "yb/common/entity_ids.h"
 #include "yb/common/index.h"
 #include "yb/common/wire_protocol.h"
@@ -278,6 +279,7 @@ class YBClient::Data {
   std::unique_ptr<rpc::ProxyCache> proxy_cache_;
   gscoped_ptr<DnsResolver> dns_resolver_;
   scoped_refptr<internal::MetaCache> meta_cache_;
+  std::shared_ptr<internal::WriteCoalescer> write_coalescer_;
   scoped_refptr<MetricEntity> metric_entity_;
 
   // Set of hostnames and IPs on the local host.
@@ -362,6 +362,8 @@ Status YBClientBuilder::DoBuild(rpc::Messenger* messenger, std::unique_ptr<YBCli
       "Could not locate the leader master");
 
   c->data_->meta_cache_.reset(new MetaCache(c.get()));
+  c->data_->write_coalescer_ = std::make_shared<internal::WriteCoalescer>(
+      c->data_->messenger_, c->data_->metric_entity_);
   c->data_->dns_resolver_.reset(new DnsResolver());
 
   // Init local host names used for locality decisions.
@@ -404,6 +406,9 @@ YBClient::~YBClient() {
 }
 
 void YBClient::Shutdown() {
+  if (data_->write_coalescer_) {
+    data_->write_coalescer_->Shutdown();
+  }
   if (data_->messenger_holder_) {
     data_->messenger_holder_->Shutdown();
   }
@@ -1352,6 +1357,10 @@ void YBClient::TEST_set_admin_operation_timeout(const MonoDelta& timeout) {
   data_->default_admin_operation_timeout_ = timeout;
 }
 
+size_t YBClient::TEST_num_coalesced_write_rpcs() const {
+  return data_->write_coalescer_ ? data_->write_coalescer_->TEST_num_coalesced_rpcs() : 0;
+}
+
 const MonoDelta& YBClient::default_admin_operation_timeout() const {
   return data_->default_admin_operation_timeout_;
 }
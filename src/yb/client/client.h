@@ -542,6 +542,9 @@ class YBClient {
 
   void TEST_set_admin_operation_timeout(const MonoDelta& timeout);
 
+  // Number of write RPCs that contained writes of several sessions, see WriteCoalescer.
+  size_t TEST_num_coalesced_write_rpcs() const;
+
   const MonoDelta& default_admin_operation_timeout() const;
   const MonoDelta& default_rpc_timeout() const;
 
@@ -44,6 +44,7 @@ DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(yb_num_shards_per_tserver);
 DECLARE_int64(db_block_cache_size_bytes);
 DECLARE_bool(flush_rocksdb_on_shutdown);
+DECLARE_int32(client_write_coalescing_max_delay_us);
 
 using namespace std::literals;
 
@@ -208,9 +209,11 @@ class QLDmlTest : public QLDmlTestBase {
   }
 
   Result<RowValue> ReadRow(const YBSessionPtr& session, const RowKey& key,
-                           YBConsistencyLevel consistency_level = YBConsistencyLevel::STRONG) {
+                           YBConsistencyLevel consistency_level = YBConsistencyLevel::STRONG,
+                           MonoDelta max_staleness = MonoDelta()) {
     auto op = SelectRow(session, kValueColumns, key);
     op->set_yb_consistency_level(consistency_level);
+    op->set_max_staleness(max_staleness);
     RETURN_NOT_OK(session->Flush());
     if (op->response().status() != QLResponsePB::YQL_STATUS_OK) {
       return STATUS_FORMAT(
@@ -1260,6 +1263,92 @@ TEST_F(QLDmlTest, ReadFollower) {
   ASSERT_TRUE(missing_rows.empty()) << "Missing rows: " << yb::ToString(missing_rows);
 }
 
+// Followers that are behind the staleness bound reject the read, so it is retried on the leader.
+// With zero bound every row should be visible right after it was written.
+TEST_F(QLDmlTest, ReadFollowerBoundedStaleness) {
+  constexpr int kNumRows = RegularBuildVsSanitizers(1000, 200);
+
+  ASSERT_NO_FATALS(InsertRows(kNumRows));
+
+  auto session = NewSession();
+  for (size_t i = 0; i != kNumRows; ++i) {
+    auto row = ASSERT_RESULT(ReadRow(
+        session, KeyForIndex(i), YBConsistencyLevel::BOUNDED_STALENESS, MonoDelta::kZero));
+    ASSERT_EQ(row, ValueForIndex(i));
+  }
+
+  // With large bound all rows become visible eventually.
+  for (size_t i = 0; i != kNumRows; ++i) {
+    ASSERT_OK(WaitFor([this, &session, i]() -> Result<bool> {
+      auto row = ReadRow(
+          session, KeyForIndex(i), YBConsistencyLevel::BOUNDED_STALENESS, 1h);
+      if (!row.ok() && row.status().IsNotFound()) {
+        return false;
+      }
+      RETURN_NOT_OK(row);
+      return *row == ValueForIndex(i);
+    }, 10s * kTimeMultiplier, "Read row from follower"));
+  }
+}
+
+// Writes of concurrent flushes are coalesced, and each of them should be applied.
+TEST_F(QLDmlTest, CoalesceWrites) {
+  FLAGS_client_write_coalescing_max_delay_us = 10000;
+  constexpr int kNumRows = RegularBuildVsSanitizers(2000, 500);
+
+  ASSERT_NO_FATALS(InsertRows(kNumRows));
+  ASSERT_GT(client_->TEST_num_coalesced_write_rpcs(), 0);
+
+  auto session = NewSession();
+  for (size_t i = 0; i != kNumRows; ++i) {
+    auto row = ASSERT_RESULT(ReadRow(session, KeyForIndex(i)));
+    ASSERT_EQ(row, ValueForIndex(i));
+  }
+}
+
+// Conditional writes read the current row, so they should not be coalesced with other writes.
+TEST_F(QLDmlTest, DontCoalesceConditionalWrites) {
+  FLAGS_client_write_coalescing_max_delay_us = 10000;
+  constexpr int kNumRows = RegularBuildVsSanitizers(500, 100);
+
+  auto session = NewSession();
+  std::vector<std::future<Status>> futures;
+  std::vector<YBqlWriteOpPtr> ops;
+  for (int i = 0; i != kNumRows; ++i) {
+    // Each row is inserted twice, only one of inserts should be applied.
+    for (int j = 0; j != 2; ++j) {
+      const YBqlWriteOpPtr op = table_.NewWriteOp(QLWriteRequestPB::QL_STMT_INSERT);
+      auto* const req = op->mutable_request();
+      const auto key = KeyForIndex(i);
+      QLAddInt32HashValue(req, key.h1);
+      QLAddStringHashValue(req, key.h2);
+      QLAddInt32RangeValue(req, key.r1);
+      QLAddStringRangeValue(req, key.r2);
+      table_.AddInt32ColumnValue(req, "c1", j);
+      table_.AddStringColumnValue(req, "c2", ValueForIndex(i).c2);
+      req->mutable_if_expr()->mutable_condition()->set_op(QL_OP_NOT_EXISTS);
+      ASSERT_OK(session->Apply(op));
+      futures.push_back(session->FlushFuture());
+      ops.push_back(op);
+    }
+  }
+  for (auto& future : futures) {
+    ASSERT_OK(future.get());
+  }
+
+  ASSERT_EQ(client_->TEST_num_coalesced_write_rpcs(), 0);
+  int applied = 0;
+  for (const auto& op : ops) {
+    ASSERT_EQ(op->response().status(), QLResponsePB::YQL_STATUS_OK);
+    auto rowblock = RowsResult(op.get()).GetRowBlock();
+    ASSERT_EQ(rowblock->row_count(), 1);
+    if (rowblock->row(0).column(0).bool_value()) {
+      ++applied;
+    }
+  }
+  ASSERT_EQ(applied, kNumRows);
+}
+
 TEST_F(QLDmlTest, DeletePartialRangeKey) {
   auto session = NewSession();
   RowKey row_key{1, "a", 2, "b"};
@@ -61,6 +61,8 @@ DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(delay_init_tablet_peer_ms);
 DECLARE_bool(fail_in_apply_if_no_metadata);
 DECLARE_bool(delete_intents_sst_files);
+DECLARE_bool(enable_wait_queues);
+DECLARE_uint64(wait_queue_max_wait_ms);
 
 namespace yb {
 namespace client {
@@ -554,6 +556,41 @@ TEST_F(QLTransactionTest, SimpleWriteConflict) {
   ASSERT_NOK(transaction->CommitFuture().get());
 }
 
+// Transaction that waits in the wait queue should not hold in-memory locks, otherwise transaction
+// that it waits for could not write the same key again until the wait times out.
+TEST_F(QLTransactionTest, WaitQueueWriteConflict) {
+  FLAGS_enable_wait_queues = true;
+  FLAGS_wait_queue_max_wait_ms = 60000;
+  const auto kMaxTime = 10s * kTimeMultiplier;
+
+  auto txn1 = CreateTransaction();
+  auto session1 = CreateSession(txn1);
+  ASSERT_OK(WriteRow(session1, 0 /* key */, 1 /* value */));
+
+  auto txn2 = CreateTransaction();
+  auto session2 = CreateSession(txn2);
+  ASSERT_OK(WriteRow(session2, 0 /* key */, 2 /* value */, WriteOpType::INSERT, Flush::kFalse));
+  auto flush_future = session2->FlushFuture();
+  // Let the second transaction reach the wait queue.
+  std::this_thread::sleep_for(1s);
+  ASSERT_EQ(flush_future.wait_for(0s), std::future_status::timeout);
+
+  auto start = MonoTime::Now();
+  ASSERT_OK(WriteRow(session1, 0 /* key */, 3 /* value */));
+  ASSERT_OK(txn1->CommitFuture().get());
+  ASSERT_LT(MonoTime::Now() - start, MonoDelta(kMaxTime));
+
+  // The second transaction is woken up when the first one is applied.
+  ASSERT_EQ(flush_future.wait_for(kMaxTime), std::future_status::ready);
+  auto status = flush_future.get();
+  if (status.ok()) {
+    // It still conflicts with the committed transaction.
+    ASSERT_NOK(txn2->CommitFuture().get());
+  }
+
+  ASSERT_EQ(ASSERT_RESULT(SelectRow(CreateSession(), 0 /* key */)), 3);
+}
+
 void QLTransactionTest::TestReadOnlyTablets(IsolationLevel isolation_level,
                                             bool perform_write,
                                             bool written_intents_expected) {
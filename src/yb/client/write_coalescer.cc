@@ -0,0 +1,306 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/client/write_coalescer.h"
+
+#include <algorithm>
+
+#include "yb/client/async_rpc.h"
+#include "yb/client/batcher.h"
+#include "yb/client/in_flight_op.h"
+#include "yb/client/meta_cache.h"
+#include "yb/client/table.h"
+#include "yb/client/yb_op.h"
+
+#include "yb/common/ql_protocol_util.h"
+
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/scheduler.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+
+DEFINE_int32(client_write_coalescing_max_delay_us, 0,
+             "Max time that non-transactional writes could wait to be coalesced with writes of "
+             "other sessions to the same tablet into a single RPC. Writes wait only while "
+             "there is another coalesced RPC in flight to the tablet. 0 to disable coalescing.");
+TAG_FLAG(client_write_coalescing_max_delay_us, advanced);
+TAG_FLAG(client_write_coalescing_max_delay_us, runtime);
+
+DEFINE_int32(client_write_coalescing_max_batch_ops, 1024,
+             "Coalesced writes are sent without waiting as soon as that many operations to the "
+             "same tablet are accumulated.");
+TAG_FLAG(client_write_coalescing_max_batch_ops, advanced);
+TAG_FLAG(client_write_coalescing_max_batch_ops, runtime);
+
+METRIC_DEFINE_histogram(
+    server, yb_client_coalesced_write_batch_size, "yb.client coalesced write batch size",
+    yb::MetricUnit::kOperations, "Number of write operations sent in a single coalesced RPC",
+    100000, 2);
+METRIC_DEFINE_histogram(
+    server, yb_client_coalesced_write_delay, "yb.client coalesced write delay",
+    yb::MetricUnit::kMicroseconds,
+    "Microseconds that writes waited to be coalesced before sending", 60000000LU, 2);
+
+namespace yb {
+namespace client {
+namespace internal {
+
+WriteCoalescer::WriteCoalescer(
+    rpc::Messenger* messenger, const scoped_refptr<MetricEntity>& metric_entity)
+    : messenger_(messenger) {
+  if (metric_entity) {
+    batch_size_ = METRIC_yb_client_coalesced_write_batch_size.Instantiate(metric_entity);
+    delay_ = METRIC_yb_client_coalesced_write_delay.Instantiate(metric_entity);
+  }
+}
+
+WriteCoalescer::~WriteCoalescer() {
+  LOG_IF(DFATAL, !shutting_down_) << "Write coalescer destroyed without shutdown";
+}
+
+bool WriteCoalescer::Enabled() {
+  return FLAGS_client_write_coalescing_max_delay_us > 0;
+}
+
+namespace {
+
+// Blind write only overwrites or deletes specified columns, without reading the current row.
+bool IsBlindWrite(const YBOperation& op) {
+  if (op.type() != YBOperation::Type::QL_WRITE) {
+    return false;
+  }
+  const auto& schema = op.table()->InternalSchema();
+  if (schema.table_properties().is_transactional()) {
+    return false;
+  }
+  const auto& request = down_cast<const YBqlWriteOp&>(op).request();
+  if (RequireRead(request, schema) || request.has_where_expr() || request.returns_status() ||
+      !request.update_index_ids().empty()) {
+    return false;
+  }
+  // Counter updates, collection append and remove, subscripted and JSON updates depend on the
+  // current value of the column.
+  for (const auto& column_value : request.column_values()) {
+    if (!column_value.subscript_args().empty() || !column_value.json_args().empty() ||
+        !column_value.expr().has_value()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+bool WriteCoalescer::CanCoalesce(
+    InFlightOps::const_iterator begin, InFlightOps::const_iterator end) {
+  for (auto it = begin; it != end; ++it) {
+    if (!IsBlindWrite(*(**it).yb_op)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void WriteCoalescer::Add(Batcher* batcher, RemoteTablet* tablet,
+                         InFlightOps::const_iterator begin, InFlightOps::const_iterator end) {
+  const auto& tablet_id = tablet->tablet_id();
+  std::vector<Entry> to_send;
+  bool schedule_flush = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& queue = queues_[tablet_id];
+    if (!queue.tablet) {
+      queue.tablet = tablet;
+    }
+    queue.entries.push_back(Entry{BatcherPtr(batcher), InFlightOps(begin, end),
+                                  CoarseMonoClock::now()});
+    queue.num_ops += end - begin;
+    if (shutting_down_ || queue.rpcs_in_flight == 0 ||
+        queue.num_ops >= static_cast<size_t>(FLAGS_client_write_coalescing_max_batch_ops)) {
+      to_send.swap(queue.entries);
+      queue.num_ops = 0;
+      ++queue.rpcs_in_flight;
+    } else if (!queue.flush_scheduled) {
+      queue.flush_scheduled = true;
+      schedule_flush = true;
+    }
+  }
+
+  if (schedule_flush) {
+    std::weak_ptr<WriteCoalescer> weak_self = shared_from_this();
+    messenger_->scheduler().Schedule(
+        [weak_self, tablet_id](const Status& status) {
+          auto self = weak_self.lock();
+          if (self) {
+            self->Flush(tablet_id);
+          }
+        },
+        std::chrono::microseconds(FLAGS_client_write_coalescing_max_delay_us));
+  }
+
+  if (!to_send.empty()) {
+    Send(RemoteTabletPtr(tablet), std::move(to_send));
+  }
+}
+
+void WriteCoalescer::Flush(const TabletId& tablet_id) {
+  RemoteTabletPtr tablet;
+  std::vector<Entry> to_send;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = queues_.find(tablet_id);
+    if (it == queues_.end()) {
+      return;
+    }
+    auto& queue = it->second;
+    queue.flush_scheduled = false;
+    if (queue.entries.empty()) {
+      if (queue.rpcs_in_flight == 0) {
+        queues_.erase(it);
+      }
+      return;
+    }
+    to_send.swap(queue.entries);
+    queue.num_ops = 0;
+    ++queue.rpcs_in_flight;
+    tablet = queue.tablet;
+  }
+
+  Send(tablet, std::move(to_send));
+}
+
+void WriteCoalescer::RpcFinished(const TabletId& tablet_id) {
+  RemoteTabletPtr tablet;
+  std::vector<Entry> to_send;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = queues_.find(tablet_id);
+    if (it == queues_.end()) {
+      return;
+    }
+    auto& queue = it->second;
+    --queue.rpcs_in_flight;
+    if (queue.entries.empty()) {
+      if (queue.rpcs_in_flight == 0 && !queue.flush_scheduled) {
+        queues_.erase(it);
+      }
+      return;
+    }
+    // Writes that were waiting for the completed RPC are sent immediately.
+    to_send.swap(queue.entries);
+    queue.num_ops = 0;
+    ++queue.rpcs_in_flight;
+    tablet = queue.tablet;
+  }
+
+  Send(tablet, std::move(to_send));
+}
+
+void WriteCoalescer::Send(const RemoteTabletPtr& tablet, std::vector<Entry> entries) {
+  std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+    return lhs.batcher->deadline() < rhs.batcher->deadline();
+  });
+
+  // RPC uses deadline of its first batcher, i.e. the earliest one. So the RPC never outlives any
+  // of its batchers, and entries with much later deadline are sent in a separate RPC, to avoid
+  // timing them out prematurely.
+  const auto max_deadline_delta =
+      std::chrono::microseconds(FLAGS_client_write_coalescing_max_delay_us);
+  std::vector<std::pair<std::vector<Entry>::iterator, std::vector<Entry>::iterator>> groups;
+  auto group_begin = entries.begin();
+  for (auto it = entries.begin(); it != entries.end(); ++it) {
+    if (it->batcher->deadline() > group_begin->batcher->deadline() + max_deadline_delta) {
+      groups.emplace_back(group_begin, it);
+      group_begin = it;
+    }
+  }
+  groups.emplace_back(group_begin, entries.end());
+
+  if (groups.size() > 1) {
+    // Caller accounted only one RPC in flight.
+    std::lock_guard<std::mutex> lock(mutex_);
+    queues_[tablet->tablet_id()].rpcs_in_flight += groups.size() - 1;
+  }
+
+  for (const auto& group : groups) {
+    DoSend(tablet, group.first, group.second);
+  }
+}
+
+void WriteCoalescer::DoSend(const RemoteTabletPtr& tablet,
+                            std::vector<Entry>::iterator begin, std::vector<Entry>::iterator end) {
+  AsyncRpcData data;
+  data.batcher = begin->batcher;
+  data.tablet = tablet.get();
+  const auto now = CoarseMonoClock::now();
+  const bool coalesced = end - begin > 1;
+  for (auto it = begin; it != end; ++it) {
+    data.ops.insert(data.ops.end(), it->ops.begin(), it->ops.end());
+    if (coalesced) {
+      data.segments.push_back(AsyncRpcSegment{it->batcher, data.ops.size()});
+    }
+    if (delay_) {
+      delay_->Increment(ToMicroseconds(now - it->added));
+    }
+  }
+  if (batch_size_) {
+    batch_size_->Increment(data.ops.size());
+  }
+  if (coalesced) {
+    num_coalesced_rpcs_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  std::weak_ptr<WriteCoalescer> weak_self = shared_from_this();
+  data.finished_callback = [weak_self, tablet_id = tablet->tablet_id()] {
+    auto self = weak_self.lock();
+    if (self) {
+      self->RpcFinished(tablet_id);
+    }
+  };
+
+  // Retryable request ids are allocated by the client, that is shared by all batchers of this
+  // coalescer, so ids taken through the first batcher are valid for the whole RPC. Read time is
+  // not used by writes to non-transactional tables, and propagated hybrid time is the maximum over
+  // all batchers.
+  std::make_shared<WriteRpc>(&data)->SendRpc();
+}
+
+void WriteCoalescer::Shutdown() {
+  std::vector<std::pair<RemoteTabletPtr, std::vector<Entry>>> to_send;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (shutting_down_) {
+      return;
+    }
+    shutting_down_ = true;
+    for (auto& id_and_queue : queues_) {
+      auto& queue = id_and_queue.second;
+      if (!queue.entries.empty()) {
+        to_send.emplace_back(queue.tablet, std::move(queue.entries));
+        queue.entries.clear();
+        queue.num_ops = 0;
+        ++queue.rpcs_in_flight;
+      }
+    }
+  }
+
+  for (auto& tablet_and_entries : to_send) {
+    Send(tablet_and_entries.first, std::move(tablet_and_entries.second));
+  }
+}
+
+} // namespace internal
+} // namespace client
+} // namespace yb
@@ -0,0 +1,118 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CLIENT_WRITE_COALESCER_H
+#define YB_CLIENT_WRITE_COALESCER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/client/client_fwd.h"
+
+#include "yb/common/entity_ids.h"
+
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/rpc/rpc_fwd.h"
+
+#include "yb/util/monotime.h"
+
+namespace yb {
+
+class Histogram;
+class MetricEntity;
+
+namespace client {
+namespace internal {
+
+// Coalesces non-transactional writes of different batchers, i.e. different sessions, that are
+// headed to the same tablet into a single WriteRpc.
+//
+// When there is no RPC in flight to the tablet, writes are sent immediately, so idle clients don't
+// pay any additional latency. Otherwise writes wait until the in flight RPC completes, until
+// client_write_coalescing_max_delay_us passes or until client_write_coalescing_max_batch_ops are
+// accumulated, whichever comes first. So the achieved batch size adapts to the load.
+class WriteCoalescer : public std::enable_shared_from_this<WriteCoalescer> {
+ public:
+  WriteCoalescer(rpc::Messenger* messenger, const scoped_refptr<MetricEntity>& metric_entity);
+  ~WriteCoalescer();
+
+  // Whether coalescing is turned on by client_write_coalescing_max_delay_us.
+  static bool Enabled();
+
+  // Whether write ops [begin, end) could be coalesced with writes of other sessions.
+  // The tablet evaluates all read-modify-write ops of a batch against the same snapshot, so only
+  // blind writes to non-transactional tables are coalesced.
+  static bool CanCoalesce(InFlightOps::const_iterator begin, InFlightOps::const_iterator end);
+
+  // Takes ownership of write ops [begin, end) of the batcher, that all belong to the tablet.
+  // The ops are sent as part of a coalesced RPC, results are reported back to the batcher.
+  void Add(Batcher* batcher, RemoteTablet* tablet,
+           InFlightOps::const_iterator begin, InFlightOps::const_iterator end);
+
+  // Sends all pending writes, further writes are sent immediately.
+  void Shutdown();
+
+  // Number of sent RPCs that contained writes of more than one batcher.
+  size_t TEST_num_coalesced_rpcs() const {
+    return num_coalesced_rpcs_.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct Entry {
+    BatcherPtr batcher;
+    InFlightOps ops;
+    CoarseTimePoint added;
+  };
+
+  struct TabletQueue {
+    RemoteTabletPtr tablet;
+    std::vector<Entry> entries;
+    size_t num_ops = 0;
+    size_t rpcs_in_flight = 0;
+    bool flush_scheduled = false;
+  };
+
+  // Sends all entries pending for the tablet.
+  void Flush(const TabletId& tablet_id);
+
+  // Sends entries, sorted by deadline, in a single RPC.
+  void DoSend(const RemoteTabletPtr& tablet,
+              std::vector<Entry>::iterator begin, std::vector<Entry>::iterator end);
+
+  void Send(const RemoteTabletPtr& tablet, std::vector<Entry> entries);
+
+  void RpcFinished(const TabletId& tablet_id);
+
+  rpc::Messenger* const messenger_;
+
+  scoped_refptr<Histogram> batch_size_;
+  scoped_refptr<Histogram> delay_;
+
+  std::mutex mutex_;
+  std::unordered_map<TabletId, TabletQueue> queues_;
+  bool shutting_down_ = false;
+
+  std::atomic<size_t> num_coalesced_rpcs_{0};
+
+  DISALLOW_COPY_AND_ASSIGN(WriteCoalescer);
+};
+
+} // namespace internal
+} // namespace client
+} // namespace yb
+
+#endif // YB_CLIENT_WRITE_COALESCER_H
@@ -41,6 +41,8 @@
 #include "yb/common/partition.h"
 #include "yb/common/read_hybrid_time.h"
 
+#include "yb/util/monotime.h"
+
 namespace yb {
 
 class RedisWriteRequestPB;
@@ -358,6 +360,10 @@ class YBqlReadOp : public YBqlOp {
     yb_consistency_level_ = yb_consistency_level;
   }
 
+  // Max staleness of data returned by a follower for BOUNDED_STALENESS consistency level.
+  MonoDelta max_staleness() const { return max_staleness_; }
+  void set_max_staleness(MonoDelta value) { max_staleness_ = value; }
+
   std::vector<ColumnSchema> MakeColumnSchemasFromRequest() const;
   Result<QLRowBlock> MakeRowBlock() const;
 
@@ -373,6 +379,7 @@ class YBqlReadOp : public YBqlOp {
   std::unique_ptr<QLReadRequestPB> ql_read_request_;
   YBConsistencyLevel yb_consistency_level_;
   ReadHybridTime read_time_;
+  MonoDelta max_staleness_;
 };
 
 std::vector<ColumnSchema> MakeColumnSchemasFromColDesc(
@@ -488,6 +495,10 @@ class YBPgsqlReadOp : public YBPgsqlOp {
     yb_consistency_level_ = yb_consistency_level;
   }
 
+  // Max staleness of data returned by a follower for BOUNDED_STALENESS consistency level.
+  MonoDelta max_staleness() const { return max_staleness_; }
+  void set_max_staleness(MonoDelta value) { max_staleness_ = value; }
+
   std::vector<ColumnSchema> MakeColumnSchemasFromRequest() const;
   Result<QLRowBlock> MakeRowBlock() const;
 
@@ -510,6 +521,7 @@ class YBPgsqlReadOp : public YBPgsqlOp {
   std::unique_ptr<PgsqlReadRequestPB> read_request_;
   YBConsistencyLevel yb_consistency_level_;
   ReadHybridTime read_time_;
+  MonoDelta max_staleness_;
 };
 
 // This class is not thread-safe, though different YBNoOp objects on
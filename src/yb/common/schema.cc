@@ -96,6 +96,9 @@ void TableProperties::ToTablePropertiesPB(TablePropertiesPB *pb) const {
     pb->set_num_tablets(num_tablets_);
   }
   pb->set_is_ysql_catalog_table(is_ysql_catalog_table_);
+  if (use_packed_row_) {
+    pb->set_use_packed_row(use_packed_row_);
+  }
 }
 
 TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB& pb) {
@@ -124,6 +127,9 @@ TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB&
   if (pb.has_is_ysql_catalog_table()) {
     table_properties.set_is_ysql_catalog_table(pb.is_ysql_catalog_table());
   }
+  if (pb.has_use_packed_row()) {
+    table_properties.SetUsePackedRow(pb.use_packed_row());
+  }
   return table_properties;
 }
 
@@ -160,6 +166,7 @@ void TableProperties::Reset() {
   use_mangled_column_name_ = false;
   num_tablets_ = 0;
   is_ysql_catalog_table_ = false;
+  use_packed_row_ = false;
 }
 
 string TableProperties::ToString() const {
@@ -172,6 +179,9 @@ string TableProperties::ToString() const {
   if (HasCopartitionTableId()) {
     result += Format("copartition_table_id: $0 ", copartition_table_id_);
   }
+  if (use_packed_row_) {
+    result += "use_packed_row: true ";
+  }
   return result + Format(
       "consistency_level: $0 is_ysql_catalog_table: $1 }",
       consistency_level_,
@@ -454,6 +454,14 @@ class TableProperties {
     return is_ysql_catalog_table_;
   }
 
+  void SetUsePackedRow(bool value) {
+    use_packed_row_ = value;
+  }
+
+  bool use_packed_row() const {
+    return use_packed_row_;
+  }
+
   void ToTablePropertiesPB(TablePropertiesPB *pb) const;
 
   static TableProperties FromTablePropertiesPB(const TablePropertiesPB& pb);
@@ -475,6 +483,7 @@ class TableProperties {
   bool use_mangled_column_name_ = false;
   int num_tablets_ = 0;
   bool is_ysql_catalog_table_ = false;
+  bool use_packed_row_ = false;
 };
 
 // The schema for a set of rows.
@@ -47,11 +47,13 @@
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/util/random.h"
+#include "yb/util/size_literals.h"
 
 DEFINE_int32(num_batches, 10000,
              "Number of batches to write to/read from the Log in TestWriteManyBatches");
 
 DECLARE_int32(log_min_segments_to_retain);
+DECLARE_bool(log_mmap_closed_segments);
 DECLARE_bool(never_fsync);
 DECLARE_bool(writable_file_use_fsync);
 DECLARE_int32(o_direct_block_alignment_bytes);
@@ -63,6 +65,7 @@ namespace log {
 using std::shared_ptr;
 using consensus::MakeOpId;
 using strings::Substitute;
+using namespace yb::size_literals;  // NOLINT.
 
 extern const char* kTestTable;
 extern const char* kTestTablet;
@@ -1140,5 +1143,126 @@ TEST_F(LogTest, TestReadReplicatesHighIndex) {
   ASSERT_EQ(kSequenceLength, repls.size());
 }
 
+// Ensure that replicates of closed segments are read correctly through memory mapping, while
+// the in progress segment is still read from file.
+TEST_F(LogTest, TestReadReplicatesFromMappedSegments) {
+  FLAGS_log_mmap_closed_segments = true;
+  BuildLog();
+  log_->SetMaxSegmentSizeForTests(990);
+  const int kNumEntriesPerBatch = 100;
+
+  OpId op_id = MakeOpId(1, 1);
+  int num_entries = 0;
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  while (segments.size() < 3) {
+    ASSERT_OK(AppendNoOps(&op_id, kNumEntriesPerBatch));
+    num_entries += kNumEntriesPerBatch;
+    ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  }
+  ASSERT_TRUE(segments.front()->HasFooter());
+  ASSERT_FALSE(segments.back()->HasFooter());
+
+  auto* reader = log_->GetLogReader();
+  ReplicateMsgs repls;
+  ASSERT_OK(reader->ReadReplicatesInRange(1, num_entries, LogReader::kNoSizeLimit, &repls));
+  ASSERT_EQ(num_entries, repls.size());
+  for (int i = 0; i != num_entries; ++i) {
+    ASSERT_EQ(i + 1, repls[i]->id().index());
+  }
+
+  std::vector<int64_t> mapped_reads;
+  for (const auto& segment : segments) {
+    mapped_reads.push_back(segment->TEST_num_mapped_reads());
+    if (segment->HasFooter()) {
+      ASSERT_GT(mapped_reads.back(), 0) << segment->path();
+    } else {
+      ASSERT_EQ(mapped_reads.back(), 0) << segment->path();
+    }
+  }
+
+  // Full scan of closed segments is read from file.
+  size_t total_read = 0;
+  for (const auto& segment : segments) {
+    if (!segment->HasFooter()) {
+      continue;
+    }
+    auto read_entries = segment->ReadEntries();
+    ASSERT_OK(read_entries.status);
+    total_read += read_entries.entries.size();
+  }
+  ASSERT_GT(total_read, 0);
+  ASSERT_LT(total_read, num_entries);
+  for (size_t i = 0; i != segments.size(); ++i) {
+    ASSERT_EQ(mapped_reads[i], segments[i]->TEST_num_mapped_reads());
+  }
+}
+
+// Ensure that access to the mapping of the truncated segment is reported as error and does not
+// crash the process.
+TEST_F(LogTest, TestReadReplicatesFromTruncatedMappedSegment) {
+  FLAGS_log_mmap_closed_segments = true;
+  BuildLog();
+  log_->SetMaxSegmentSizeForTests(990);
+  const int kNumEntriesPerBatch = 100;
+
+  OpId op_id = MakeOpId(1, 1);
+  int num_entries = 0;
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  while (segments.size() < 2) {
+    ASSERT_OK(AppendNoOps(&op_id, kNumEntriesPerBatch));
+    num_entries += kNumEntriesPerBatch;
+    ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  }
+  const auto& segment = segments.front();
+  ASSERT_TRUE(segment->HasFooter());
+
+  auto* reader = log_->GetLogReader();
+  ReplicateMsgs repls;
+  ASSERT_OK(reader->ReadReplicatesInRange(1, 1, LogReader::kNoSizeLimit, &repls));
+  auto mapped_reads = segment->TEST_num_mapped_reads();
+  ASSERT_GT(mapped_reads, 0);
+
+  ASSERT_EQ(0, truncate(segment->path().c_str(), 0));
+
+  ASSERT_NOK(reader->ReadReplicatesInRange(1, 1, LogReader::kNoSizeLimit, &repls));
+  ASSERT_EQ(mapped_reads, segment->TEST_num_mapped_reads());
+}
+
+// Helper to compare reading of closed segments through memory mapping with reading them by pread.
+TEST_F(LogTest, TestReadReplicatesMappedVsPread) {
+  const int kNumIterations = AllowSlowTests() ? 100 : 2;
+  BuildLog();
+  log_->SetMaxSegmentSizeForTests(64_KB);
+  const int kNumEntriesPerBatch = 100;
+
+  OpId op_id = MakeOpId(1, 1);
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  while (segments.size() < 5) {
+    ASSERT_OK(AppendNoOps(&op_id, kNumEntriesPerBatch));
+    ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  }
+  // Read only the closed segments.
+  const int64_t last_index = segments[segments.size() - 2]->footer().max_replicate_index();
+
+  auto* reader = log_->GetLogReader();
+  for (bool use_mmap : {false, true}) {
+    FLAGS_log_mmap_closed_segments = use_mmap;
+    LOG_TIMING(INFO, Format("Read closed segments $0 times, mmap: $1", kNumIterations, use_mmap)) {
+      for (int i = 0; i != kNumIterations; ++i) {
+        ReplicateMsgs repls;
+        ASSERT_OK(reader->ReadReplicatesInRange(1, last_index, LogReader::kNoSizeLimit, &repls));
+        ASSERT_EQ(last_index, repls.size());
+      }
+    }
+  }
+  ASSERT_GT(segments.front()->TEST_num_mapped_reads(), 0);
+}
+
 } // namespace log
 } // namespace yb
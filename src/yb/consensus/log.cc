@@ -42,6 +42,7 @@
 #include "yb/consensus/log_index.h"
 #include "yb/consensus/log_metrics.h"
 #include "yb/consensus/log_reader.h"
+#include "yb/consensus/log_sync_scheduler.h"
 #include "yb/consensus/log_util.h"
 #include "yb/fs/fs_manager.h"
 #include "yb/gutil/map-util.h"
@@ -700,7 +701,11 @@ Status Log::Sync() {
       periodic_sync_needed_.store(false);
       periodic_sync_unsynced_bytes_ = 0;
       LOG_SLOW_EXECUTION(WARNING, 50, "Fsync log took a long time") {
-        RETURN_NOT_OK(active_segment_->Sync());
+        if (options_.sync_scheduler) {
+          RETURN_NOT_OK(options_.sync_scheduler->Sync(active_segment_->writable_file().get()));
+        } else {
+          RETURN_NOT_OK(active_segment_->Sync());
+        }
       }
     }
   }
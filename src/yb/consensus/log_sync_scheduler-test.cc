@@ -0,0 +1,132 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/log_sync_scheduler.h"
+
+#include <atomic>
+#include <thread>
+
+#include "yb/util/env.h"
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/metrics.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+METRIC_DECLARE_histogram(log_group_sync_batch_size);
+METRIC_DECLARE_counter(log_group_sync_saved_syncs);
+
+namespace yb {
+namespace log {
+
+namespace {
+
+// Counts syncs and makes each of them slow, so concurrent requests are grouped.
+class CountingWritableFile : public WritableFileWrapper {
+ public:
+  explicit CountingWritableFile(std::unique_ptr<WritableFile> target)
+      : WritableFileWrapper(std::move(target)) {}
+
+  CHECKED_STATUS Sync() override {
+    ++syncs_;
+    std::this_thread::sleep_for(2ms);
+    return WritableFileWrapper::Sync();
+  }
+
+  int syncs() const {
+    return syncs_.load();
+  }
+
+ private:
+  std::atomic<int> syncs_{0};
+};
+
+} // namespace
+
+class LogSyncSchedulerTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    metric_entity_ = METRIC_ENTITY_server.Instantiate(&registry_, "log_sync_scheduler-test");
+    for (int i = 0; i != kNumFiles; ++i) {
+      std::unique_ptr<WritableFile> file;
+      ASSERT_OK(env_->NewWritableFile(GetTestPath(Format("file_$0", i)), &file));
+      files_.emplace_back(new CountingWritableFile(std::move(file)));
+    }
+  }
+
+  static constexpr int kNumFiles = 4;
+
+  MetricRegistry registry_;
+  scoped_refptr<MetricEntity> metric_entity_;
+  std::vector<std::unique_ptr<CountingWritableFile>> files_;
+};
+
+TEST_F(LogSyncSchedulerTest, GroupSync) {
+  constexpr int kNumThreads = 16;
+  constexpr int kSyncsPerThread = 50;
+
+  LogSyncScheduler scheduler(GetTestDataDirectory(), metric_entity_);
+  ASSERT_OK(scheduler.Start());
+
+  std::vector<std::thread> threads;
+  std::atomic<int> failures{0};
+  for (int i = 0; i != kNumThreads; ++i) {
+    threads.emplace_back([this, i, &scheduler, &failures] {
+      auto* file = files_[i % kNumFiles].get();
+      for (int j = 0; j != kSyncsPerThread; ++j) {
+        if (!scheduler.Sync(file).ok()) {
+          ++failures;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  scheduler.Shutdown();
+
+  ASSERT_EQ(0, failures.load());
+  int total_syncs = 0;
+  for (const auto& file : files_) {
+    total_syncs += file->syncs();
+  }
+  LOG(INFO) << "Requests: " << kNumThreads * kSyncsPerThread << ", syncs: " << total_syncs;
+  ASSERT_LT(total_syncs, kNumThreads * kSyncsPerThread);
+
+  auto batch_size = METRIC_log_group_sync_batch_size.Instantiate(metric_entity_);
+  ASSERT_EQ(static_cast<uint64_t>(kNumThreads * kSyncsPerThread),
+            batch_size->histogram()->TotalSum());
+
+  // Requests merged with another request for the same file, all other requests were served by
+  // the sync of their own file.
+  auto saved_syncs = METRIC_log_group_sync_saved_syncs.Instantiate(metric_entity_)->value();
+  LOG(INFO) << "Saved syncs: " << saved_syncs;
+  ASSERT_GT(saved_syncs, 0);
+  ASSERT_EQ(total_syncs + saved_syncs, kNumThreads * kSyncsPerThread);
+}
+
+TEST_F(LogSyncSchedulerTest, SyncAfterShutdown) {
+  LogSyncScheduler scheduler(GetTestDataDirectory(), metric_entity_);
+  ASSERT_OK(scheduler.Start());
+  ASSERT_OK(scheduler.Sync(files_[0].get()));
+  scheduler.Shutdown();
+
+  // Requests after shutdown are executed by the caller.
+  ASSERT_OK(scheduler.Sync(files_[0].get()));
+  ASSERT_EQ(2, files_[0]->syncs());
+}
+
+} // namespace log
+} // namespace yb
@@ -0,0 +1,175 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/log_sync_scheduler.h"
+
+#include <algorithm>
+
+#include "yb/util/env.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/thread.h"
+
+DEFINE_bool(log_group_sync, false,
+            "Whether WAL syncs of all tablets located in the same WAL root directory should be "
+            "coalesced by a shared per directory sync thread. Requests for the same WAL file are "
+            "served by a single sync, and write back of all files of the batch is started "
+            "before any of them is synced.");
+TAG_FLAG(log_group_sync, advanced);
+
+DEFINE_int32(log_group_sync_max_delay_us, 0,
+             "Max time that log group sync waits for more sync requests after the first request "
+             "of the batch arrived. With 0 the batch consists of requests that arrived while the "
+             "previous batch was synced.");
+TAG_FLAG(log_group_sync_max_delay_us, advanced);
+TAG_FLAG(log_group_sync_max_delay_us, runtime);
+
+METRIC_DEFINE_histogram(server, log_group_sync_batch_size, "Log Group Sync Batch Size",
+                        yb::MetricUnit::kRequests,
+                        "Number of WAL sync requests coalesced by a single log group sync",
+                        10000, 2);
+
+METRIC_DEFINE_counter(server, log_group_sync_saved_syncs, "Log Group Sync Saved Syncs",
+                      yb::MetricUnit::kRequests,
+                      "Number of WAL sync requests that did not require a separate sync call "
+                      "because they were served by a sync of the same file in the same batch");
+
+METRIC_DEFINE_histogram(server, log_group_sync_latency, "Log Group Sync Latency",
+                        yb::MetricUnit::kMicroseconds,
+                        "Microseconds spent on syncing all WAL files of a log group sync batch",
+                        60000000LU, 2);
+
+namespace yb {
+namespace log {
+
+LogSyncScheduler::LogSyncScheduler(
+    std::string dir, const scoped_refptr<MetricEntity>& metric_entity)
+    : dir_(std::move(dir)) {
+  if (metric_entity) {
+    batch_size_ = METRIC_log_group_sync_batch_size.Instantiate(metric_entity);
+    saved_syncs_ = METRIC_log_group_sync_saved_syncs.Instantiate(metric_entity);
+    sync_latency_ = METRIC_log_group_sync_latency.Instantiate(metric_entity);
+  }
+}
+
+LogSyncScheduler::~LogSyncScheduler() {
+  Shutdown();
+}
+
+Status LogSyncScheduler::Start() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = true;
+  }
+  return Thread::Create("log", "log-group-sync", &LogSyncScheduler::Run, this, &thread_);
+}
+
+void LogSyncScheduler::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_) {
+      return;
+    }
+    stopping_ = true;
+  }
+  queue_cond_.notify_one();
+  if (thread_) {
+    CHECK_OK(ThreadJoiner(thread_.get()).Join());
+    thread_.reset();
+  }
+}
+
+Status LogSyncScheduler::Sync(WritableFile* file) {
+  SyncRequest request{file};
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (running_) {
+      queue_.push_back(&request);
+      queue_cond_.notify_one();
+      done_cond_.wait(lock, [&request] { return request.done; });
+      return request.status;
+    }
+  }
+  return file->Sync();
+}
+
+void LogSyncScheduler::Run() {
+  std::vector<SyncRequest*> batch;
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    queue_cond_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      break;
+    }
+    const auto max_delay = FLAGS_log_group_sync_max_delay_us;
+    if (max_delay > 0 && !stopping_) {
+      queue_cond_.wait_for(
+          lock, std::chrono::microseconds(max_delay), [this] { return stopping_; });
+    }
+    batch.swap(queue_);
+    lock.unlock();
+
+    SyncBatch(&batch);
+
+    lock.lock();
+    for (auto* request : batch) {
+      request->done = true;
+    }
+    batch.clear();
+    done_cond_.notify_all();
+  }
+  running_ = false;
+}
+
+void LogSyncScheduler::SyncBatch(std::vector<SyncRequest*>* batch) {
+  auto start = MonoTime::Now();
+
+  // The same log could request several syncs while the previous batch was synced, one sync
+  // after all of them were requested covers all of them.
+  std::sort(batch->begin(), batch->end(), [](SyncRequest* lhs, SyncRequest* rhs) {
+    return lhs->file < rhs->file;
+  });
+  std::vector<WritableFile*> files;
+  for (auto* request : *batch) {
+    if (files.empty() || files.back() != request->file) {
+      files.push_back(request->file);
+    }
+  }
+
+  // Pass buffered data of all files to the kernel and start write back, so the syncs below
+  // wait for write back of the whole batch in parallel. Errors are reported by the sync.
+  if (files.size() > 1) {
+    for (auto* file : files) {
+      WARN_NOT_OK(file->Flush(WritableFile::FLUSH_ASYNC), "Failed to start write back");
+    }
+  }
+
+  // Each file is synced separately, so each request gets status of its own file.
+  for (auto it = batch->begin(); it != batch->end();) {
+    auto* file = (**it).file;
+    auto status = file->Sync();
+    for (; it != batch->end() && (**it).file == file; ++it) {
+      (**it).status = status;
+    }
+  }
+
+  if (batch_size_) {
+    batch_size_->Increment(batch->size());
+    saved_syncs_->IncrementBy(batch->size() - files.size());
+    sync_latency_->Increment((MonoTime::Now() - start).ToMicroseconds());
+  }
+}
+
+} // namespace log
+} // namespace yb
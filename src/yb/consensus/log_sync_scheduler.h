@@ -0,0 +1,96 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_LOG_SYNC_SCHEDULER_H
+#define YB_CONSENSUS_LOG_SYNC_SCHEDULER_H
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "yb/gutil/macros.h"
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/status.h"
+
+namespace yb {
+
+class Counter;
+class Histogram;
+class MetricEntity;
+class Thread;
+class WritableFile;
+
+namespace log {
+
+// Group commit of WAL syncs for all logs located in the same WAL root directory.
+//
+// Each Log syncs its active segment from its own appender task, so a server with many tablets
+// issues a lot of concurrent fsyncs to the same disk. When Log is configured with a scheduler,
+// it passes sync requests to the scheduler thread instead. The thread collects requests for up
+// to log_group_sync_max_delay_us and syncs the collected batch, while requests that arrive
+// meanwhile form the next batch. Each file of the batch is synced once, after write back of all
+// files of the batch was started.
+class LogSyncScheduler {
+ public:
+  LogSyncScheduler(std::string dir, const scoped_refptr<MetricEntity>& metric_entity);
+  ~LogSyncScheduler();
+
+  CHECKED_STATUS Start();
+
+  // Syncs all pending requests and stops the scheduler thread. Requests that arrive after
+  // shutdown are executed in the calling thread.
+  void Shutdown();
+
+  // Blocks until file is synced as part of the group, returns result of the sync.
+  CHECKED_STATUS Sync(WritableFile* file);
+
+  const std::string& dir() const {
+    return dir_;
+  }
+
+ private:
+  struct SyncRequest {
+    WritableFile* file;
+    Status status;
+    bool done = false;
+  };
+
+  void Run();
+  void SyncBatch(std::vector<SyncRequest*>* batch);
+
+  const std::string dir_;
+
+  scoped_refptr<Histogram> batch_size_;
+  scoped_refptr<Counter> saved_syncs_;
+  scoped_refptr<Histogram> sync_latency_;
+
+  std::mutex mutex_;
+  // Signalled when new request is queued or shutdown is started.
+  std::condition_variable queue_cond_;
+  // Signalled when batch of requests is synced.
+  std::condition_variable done_cond_;
+  std::vector<SyncRequest*> queue_;
+  bool stopping_ = false;
+  bool running_ = false;
+
+  scoped_refptr<Thread> thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(LogSyncScheduler);
+};
+
+} // namespace log
+} // namespace yb
+
+#endif // YB_CONSENSUS_LOG_SYNC_SCHEDULER_H
@@ -32,6 +32,12 @@
 
 #include "yb/consensus/log_util.h"
 
+#include <fcntl.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <iostream>
 #include <limits>
@@ -53,6 +59,7 @@
 #include "yb/util/crc.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/env_util.h"
+#include "yb/util/errno.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/pb_util.h"
 #include "yb/util/size_literals.h"
@@ -87,6 +94,15 @@ DEFINE_bool(log_async_preallocate_segments, true,
             "Whether the WAL segments preallocation should happen asynchronously");
 TAG_FLAG(log_async_preallocate_segments, advanced);
 
+DEFINE_bool(log_mmap_closed_segments, false,
+            "Whether entries of closed WAL segments should be copied from memory mapping of the "
+            "segment file, instead of being read by pread. Only used to catch up "
+            "followers that fall behind, bootstrap and other full scans of segments always use "
+            "pread. Access to a page that could not be read, because of I/O error or "
+            "truncation of the file, is detected and the read falls back to pread.");
+TAG_FLAG(log_mmap_closed_segments, advanced);
+TAG_FLAG(log_mmap_closed_segments, runtime);
+
 DECLARE_string(fs_data_dirs);
 
 DEFINE_bool(require_durable_wal_write, false, "Whether durable WAL write is required."
@@ -164,6 +180,117 @@ ReadableLogSegment::ReadableLogSegment(
   env_util::OpenFileForRandom(Env::Default(), path_, &readable_file_checkpoint_);
 }
 
+namespace {
+
+// Access to a page of memory mapped file that could not be read, because of I/O error or
+// truncation of the file, is reported with SIGBUS. So reads from mapped segments are done by
+// GuardMappedRead, and such a signal interrupts the read with siglongjmp. Guarded code should only
+// copy data out of the mapping, it should not allocate memory or take locks.
+// The handler is installed with SA_NODEFER, so SIGBUS is not blocked while it runs and the signal
+// mask does not have to be restored by siglongjmp. It allows sigsetjmp to skip saving the mask,
+// which would cost a sigprocmask call per read.
+thread_local sigjmp_buf* mapped_read_guard = nullptr;
+struct sigaction prev_sigbus_action;
+
+void HandleSigBus(int signum, siginfo_t* info, void* context) {
+  if (mapped_read_guard) {
+    siglongjmp(*mapped_read_guard, 1);
+  }
+  // SIGBUS is not caused by guarded read, so pass it to the previous handler.
+  if (prev_sigbus_action.sa_flags & SA_SIGINFO) {
+    prev_sigbus_action.sa_sigaction(signum, info, context);
+  } else if (prev_sigbus_action.sa_handler != SIG_DFL &&
+             prev_sigbus_action.sa_handler != SIG_IGN) {
+    prev_sigbus_action.sa_handler(signum);
+  } else {
+    signal(signum, SIG_DFL);
+    raise(signum);
+  }
+}
+
+void InstallSigBusHandler() {
+  static std::once_flag once;
+  std::call_once(once, [] {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = &HandleSigBus;
+    action.sa_flags = SA_SIGINFO | SA_NODEFER;
+    sigemptyset(&action.sa_mask);
+    PCHECK(sigaction(SIGBUS, &action, &prev_sigbus_action) == 0);
+  });
+}
+
+// Invokes f, returns false if it was interrupted by SIGBUS.
+template <class F>
+bool GuardMappedRead(const F& f) {
+  sigjmp_buf guard;
+  if (sigsetjmp(guard, 0) != 0) {
+    mapped_read_guard = nullptr;
+    return false;
+  }
+  mapped_read_guard = &guard;
+  f();
+  mapped_read_guard = nullptr;
+  return true;
+}
+
+} // namespace
+
+ReadableLogSegment::~ReadableLogSegment() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+  }
+}
+
+bool ReadableLogSegment::ReadMapped(
+    int64_t offset, size_t size, UseMapping use_mapping, Slice* result) {
+  if (!use_mapping || !FLAGS_log_mmap_closed_segments || !HasFooter()) {
+    return false;
+  }
+  std::call_once(map_once_, &ReadableLogSegment::MapFile, this);
+  if (mapping_ == nullptr || mapping_failed_.load(std::memory_order_acquire) ||
+      offset < 0 || offset + size > mapping_size_) {
+    return false;
+  }
+  *result = Slice(mapping_ + offset, size);
+  return true;
+}
+
+void ReadableLogSegment::MappedReadFailed(int64_t offset, size_t size) {
+  LOG(WARNING) << "Failed to read " << size << " bytes at offset " << offset << " of mapped "
+               << path_ << ", reading it from file";
+  mapping_failed_.store(true, std::memory_order_release);
+}
+
+void ReadableLogSegment::MapFile() {
+  // Offsets in encrypted file don't match offsets of the entries.
+  if (readable_file_->IsEncrypted()) {
+    return;
+  }
+  auto size = file_size();
+  if (size <= 0) {
+    return;
+  }
+  int fd;
+  do {
+    fd = open(path_.c_str(), O_CLOEXEC | O_RDONLY);
+  } while (fd < 0 && errno == EINTR);
+  if (fd < 0) {
+    LOG(WARNING) << "Unable to open " << path_ << " for mapping: " << ErrnoToString(errno);
+    return;
+  }
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  int err = errno;
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    LOG(WARNING) << "Unable to mmap " << path_ << ": " << ErrnoToString(err);
+    return;
+  }
+  InstallSigBusHandler();
+  mapping_ = static_cast<uint8_t*>(mapping);
+  mapping_size_ = size;
+}
+
 Status ReadableLogSegment::Init(const LogSegmentHeaderPB& header,
                                 const LogSegmentFooterPB& footer,
                                 int64_t first_entry_offset) {
@@ -742,20 +869,35 @@ Status ReadableLogSegment::MakeCorruptionStatus(
 }
 
 Status ReadableLogSegment::ReadEntryHeaderAndBatch(int64_t* offset, faststring* tmp_buf,
-                                                   LogEntryBatchPB* batch) {
+                                                   LogEntryBatchPB* batch,
+                                                   UseMapping use_mapping) {
   EntryHeader header;
-  RETURN_NOT_OK(ReadEntryHeader(offset, &header));
-  RETURN_NOT_OK(ReadEntryBatch(offset, header, tmp_buf, batch));
+  RETURN_NOT_OK(ReadEntryHeader(offset, &header, use_mapping));
+  RETURN_NOT_OK(ReadEntryBatch(offset, header, tmp_buf, batch, use_mapping));
   return Status::OK();
 }
 
 
-Status ReadableLogSegment::ReadEntryHeader(int64_t *offset, EntryHeader* header) {
+Status ReadableLogSegment::ReadEntryHeader(
+    int64_t *offset, EntryHeader* header, UseMapping use_mapping) {
   uint8_t scratch[kEntryHeaderSize];
   Slice slice;
-  RETURN_NOT_OK_PREPEND(ReadFully(readable_file().get(), *offset, kEntryHeaderSize,
-                                  &slice, scratch),
-                        "Could not read log entry header");
+  Slice mapped;
+  if (ReadMapped(*offset, kEntryHeaderSize, use_mapping, &mapped)) {
+    if (GuardMappedRead([&mapped, &scratch] {
+          memcpy(scratch, mapped.data(), mapped.size());
+        })) {
+      slice = Slice(scratch, mapped.size());
+      ++num_mapped_reads_;
+    } else {
+      MappedReadFailed(*offset, kEntryHeaderSize);
+    }
+  }
+  if (slice.empty()) {
+    RETURN_NOT_OK_PREPEND(ReadFully(readable_file().get(), *offset, kEntryHeaderSize,
+                                    &slice, scratch),
+                          "Could not read log entry header");
+  }
 
   RETURN_NOT_OK(DecodeEntryHeader(slice, header));
   *offset += slice.size();
@@ -782,7 +924,8 @@ Status ReadableLogSegment::DecodeEntryHeader(const Slice& data, EntryHeader* hea
 Status ReadableLogSegment::ReadEntryBatch(int64_t *offset,
                                           const EntryHeader& header,
                                           faststring *tmp_buf,
-                                          LogEntryBatchPB* entry_batch) {
+                                          LogEntryBatchPB* entry_batch,
+                                          UseMapping use_mapping) {
   TRACE_EVENT2("log", "ReadableLogSegment::ReadEntryBatch",
                "path", path_,
                "range", Substitute("offset=$0 entry_len=$1",
@@ -802,18 +945,37 @@ Status ReadableLogSegment::ReadEntryBatch(int64_t *offset,
 
   tmp_buf->clear();
   tmp_buf->resize(header.msg_length);
+
+  // The batch is copied out of the mapping under the guard, so that parsing below does not touch
+  // the mapping.
   Slice entry_batch_slice;
+  Slice mapped;
+  if (ReadMapped(*offset, header.msg_length, use_mapping, &mapped)) {
+    uint8_t* buf = tmp_buf->data();
+    if (GuardMappedRead([&mapped, buf] {
+          memcpy(buf, mapped.data(), mapped.size());
+        })) {
+      entry_batch_slice = Slice(buf, mapped.size());
+      ++num_mapped_reads_;
+    } else {
+      MappedReadFailed(*offset, header.msg_length);
+    }
+  }
 
-  Status s =  readable_file()->Read(*offset,
-                                    header.msg_length,
-                                    &entry_batch_slice,
-                                    tmp_buf->data());
+  Status s;
+  if (entry_batch_slice.empty()) {
+    s = readable_file()->Read(*offset,
+                              header.msg_length,
+                              &entry_batch_slice,
+                              tmp_buf->data());
+
+    if (!s.ok()) return STATUS(IOError, Substitute("Could not read entry. Cause: $0",
+                                                   s.ToString()));
+  }
 
-  if (!s.ok()) return STATUS(IOError, Substitute("Could not read entry. Cause: $0",
-                                                 s.ToString()));
+  uint32_t read_crc = crc::Crc32c(entry_batch_slice.data(), entry_batch_slice.size());
 
   // Verify the CRC.
-  uint32_t read_crc = crc::Crc32c(entry_batch_slice.data(), entry_batch_slice.size());
   if (PREDICT_FALSE(read_crc != header.msg_crc)) {
     return STATUS(Corruption, Substitute("Entry CRC mismatch in byte range $0-$1: "
                                          "expected CRC=$2, computed=$3",
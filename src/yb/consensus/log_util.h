@@ -33,9 +33,11 @@
 #ifndef YB_CONSENSUS_LOG_UTIL_H_
 #define YB_CONSENSUS_LOG_UTIL_H_
 
+#include <atomic>
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -51,6 +53,7 @@
 #include "yb/util/monotime.h"
 #include "yb/util/opid.h"
 #include "yb/util/restart_safe_clock.h"
+#include "yb/util/strongly_typed_bool.h"
 
 // Used by other classes, now part of the API.
 DECLARE_bool(durable_wal_write);
@@ -67,6 +70,8 @@ struct OpIdBiggerThanFunctor;
 
 namespace log {
 
+YB_STRONGLY_TYPED_BOOL(UseMapping);
+
 // Suffix for temporary files
 extern const char kTmpSuffix[];
 
@@ -77,6 +82,7 @@ extern const size_t kEntryHeaderSize;
 extern const int kLogMajorVersion;
 extern const int kLogMinorVersion;
 
+class LogSyncScheduler;
 class ReadableLogSegment;
 
 // Options for the State Machine/Write Ahead Log
@@ -108,6 +114,10 @@ struct LogOptions {
 
   std::string peer_uuid;
 
+  // If not null, syncs of the log are coalesced with syncs of other logs in the same WAL root
+  // directory by this scheduler.
+  LogSyncScheduler* sync_scheduler = nullptr;
+
   LogOptions();
 };
 
@@ -226,6 +236,11 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
     return footer_;
   }
 
+  // Number of entry headers and batches that were read through memory mapping.
+  int64_t TEST_num_mapped_reads() const {
+    return num_mapped_reads_.load(std::memory_order_acquire);
+  }
+
   const std::shared_ptr<RandomAccessFile> readable_file() const {
     return readable_file_;
   }
@@ -267,7 +282,7 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
     uint32_t header_crc;
   };
 
-  ~ReadableLogSegment() {}
+  ~ReadableLogSegment();
 
   // Helper functions called by Init().
 
@@ -298,13 +313,16 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
                               const std::vector<std::unique_ptr<LogEntryPB>>& entries,
                               const Status& status) const;
 
+  // use_mapping allows reading through memory mapping of the closed segment, when it is enabled
+  // by log_mmap_closed_segments.
   CHECKED_STATUS ReadEntryHeaderAndBatch(int64_t* offset,
                                          faststring* tmp_buf,
-                                         LogEntryBatchPB* batch);
+                                         LogEntryBatchPB* batch,
+                                         UseMapping use_mapping = UseMapping::kFalse);
 
   // Reads a log entry header from the segment.
   // Also increments the passed offset* by the length of the entry.
-  CHECKED_STATUS ReadEntryHeader(int64_t *offset, EntryHeader* header);
+  CHECKED_STATUS ReadEntryHeader(int64_t *offset, EntryHeader* header, UseMapping use_mapping);
 
   // Decode a log entry header from the given slice, which must be kEntryHeaderSize
   // bytes long. Returns true if successful, false if corrupt.
@@ -318,10 +336,23 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
   CHECKED_STATUS ReadEntryBatch(int64_t *offset,
                                 const EntryHeader& header,
                                 faststring* tmp_buf,
-                                LogEntryBatchPB* entry_batch);
+                                LogEntryBatchPB* entry_batch,
+                                UseMapping use_mapping);
 
   void UpdateReadableToOffset(int64_t readable_to_offset);
 
+  // Points result to size bytes at offset in memory mapped segment file, without copying them.
+  // Returns false if segment is not mapped, then data should be read from readable_file_.
+  // Access to the result should be guarded against SIGBUS, see GuardMappedRead.
+  bool ReadMapped(int64_t offset, size_t size, UseMapping use_mapping, Slice* result);
+
+  // Called when access to the mapping failed. Further reads of this segment use readable_file_.
+  void MappedReadFailed(int64_t offset, size_t size);
+
+  // Maps the whole segment file to memory. Only closed segments are mapped, since they are
+  // not modified anymore.
+  void MapFile();
+
   const std::string path_;
 
   // The size of the readable file.
@@ -355,6 +386,13 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
   // the offset of the first entry in the log.
   int64_t first_entry_offset_;
 
+  std::once_flag map_once_;
+  // Memory mapped segment file, or nullptr if segment is not mapped.
+  uint8_t* mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+  std::atomic<bool> mapping_failed_{false};
+  std::atomic<int64_t> num_mapped_reads_{0};
+
   DISALLOW_COPY_AND_ASSIGN(ReadableLogSegment);
 };
 
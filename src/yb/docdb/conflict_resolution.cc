@@ -13,6 +13,7 @@
 
 #include "yb/docdb/conflict_resolution.h"
 
+#include "yb/common/clock.h"
 #include "yb/common/hybrid_time.h"
 #include "yb/common/pgsql_error.h"
 #include "yb/common/row_mark.h"
@@ -24,6 +25,7 @@
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent.h"
 #include "yb/docdb/shared_lock_manager.h"
+#include "yb/docdb/wait_queue.h"
 
 #include "yb/util/countdown_latch.h"
 #include "yb/util/metrics.h"
@@ -33,6 +35,16 @@
 using namespace std::literals;
 using namespace std::placeholders;
 
+DEFINE_bool(enable_wait_queues, false,
+            "Park transactions that conflict with pending transactions in the tablet wait queue, "
+            "instead of aborting conflicting transactions or failing the request right away.");
+DEFINE_uint64(wait_queue_max_wait_ms, 1000,
+              "Max time that transaction could spend in the wait queue during single conflict "
+              "resolution. After that conflicts are resolved using transaction priorities.");
+DEFINE_uint64(wait_queue_recheck_interval_ms, 100,
+              "Interval to recheck status of conflicting transactions while waiting in the wait "
+              "queue. Covers transactions that were aborted without notifying this tablet.");
+
 namespace yb {
 namespace docdb {
 
@@ -64,7 +76,9 @@ struct TransactionData {
 
 CHECKED_STATUS MakeConflictStatus(const TransactionId& our_id, const TransactionId& other_id,
                                   const char* reason, Counter* conflicts_metric) {
-  conflicts_metric->Increment();
+  if (conflicts_metric) {
+    conflicts_metric->Increment();
+  }
   return (STATUS(TryAgain, Format("$0 Conflicts with $1 transaction: $2", our_id, reason, other_id),
                  Slice(), TransactionError(TransactionErrorCode::kConflict)));
 }
@@ -85,6 +99,10 @@ class ConflictResolverContext {
   virtual CHECKED_STATUS CheckConflictWithCommitted(
       const TransactionId& id, HybridTime commit_time) = 0;
 
+  // Called when there are pending transactions that conflict with this one.
+  // Returns true if conflict resolution should stop, leaving those transactions unresolved.
+  virtual bool StopOnPendingTransactions(const std::vector<TransactionData>& transactions) = 0;
+
   virtual HybridTime GetResolutionHt() = 0;
 
   virtual bool IgnoreConflictsWith(const TransactionId& other) = 0;
@@ -234,6 +252,10 @@ class ConflictResolver {
         return Status::OK();
       }
 
+      if (context_.StopOnPendingTransactions(transactions_)) {
+        return Status::OK();
+      }
+
       RETURN_NOT_OK(context_.CheckPriority(this, &transactions_));
 
       RETURN_NOT_OK(AbortTransactions());
@@ -377,14 +399,16 @@ class TransactionConflictResolverContext : public ConflictResolverContext {
                                      const KeyValueWriteBatchPB& write_batch,
                                      HybridTime resolution_ht,
                                      HybridTime read_time,
-                                     Counter* conflicts_metric)
+                                     Counter* conflicts_metric,
+                                     TransactionIdSet* pending_transactions = nullptr)
       : doc_ops_(doc_ops),
         write_batch_(write_batch),
         resolution_ht_(resolution_ht),
         read_time_(read_time),
         transaction_id_(FullyDecodeTransactionId(
             write_batch.transaction().transaction_id())),
-        conflicts_metric_(conflicts_metric)
+        conflicts_metric_(conflicts_metric),
+        pending_transactions_(pending_transactions)
   {}
 
   virtual ~TransactionConflictResolverContext() {}
@@ -553,6 +577,16 @@ class TransactionConflictResolverContext : public ConflictResolverContext {
     return Status::OK();
   }
 
+  bool StopOnPendingTransactions(const std::vector<TransactionData>& transactions) override {
+    if (!pending_transactions_) {
+      return false;
+    }
+    for (const auto& transaction : transactions) {
+      pending_transactions_->insert(transaction.id);
+    }
+    return true;
+  }
+
   HybridTime GetResolutionHt() override {
     return resolution_ht_;
   }
@@ -582,6 +616,9 @@ class TransactionConflictResolverContext : public ConflictResolverContext {
   Status result_ = Status::OK();
   bool fetched_metadata_for_transactions_ = false;
   Counter* conflicts_metric_ = nullptr;
+
+  // When specified, conflicts are only collected into this set instead of being resolved.
+  TransactionIdSet* pending_transactions_;
 };
 
 class OperationConflictResolverContext : public ConflictResolverContext {
@@ -632,6 +669,10 @@ class OperationConflictResolverContext : public ConflictResolverContext {
     return Status::OK();
   }
 
+  bool StopOnPendingTransactions(const std::vector<TransactionData>& transactions) override {
+    return false;
+  }
+
   HybridTime GetResolutionHt() override {
     return resolution_ht_;
   }
@@ -674,6 +715,60 @@ Status ResolveTransactionConflicts(const DocOperations& doc_ops,
   return resolver.Resolve();
 }
 
+void WaitForConflictingTransactions(const DocOperations& doc_ops,
+                                    const KeyValueWriteBatchPB& write_batch,
+                                    ClockBase* clock,
+                                    HybridTime read_time,
+                                    const DocDB& doc_db,
+                                    PartialRangeKeyIntents partial_range_key_intents,
+                                    TransactionStatusManager* status_manager,
+                                    WaitQueue* wait_queue,
+                                    CoarseTimePoint deadline) {
+  if (!FLAGS_enable_wait_queues || !wait_queue) {
+    return;
+  }
+  auto transaction_id = FullyDecodeTransactionId(write_batch.transaction().transaction_id());
+  if (!transaction_id.ok()) {
+    return;
+  }
+
+  const auto wait_end = std::min(
+      deadline, CoarseMonoClock::now() + FLAGS_wait_queue_max_wait_ms * 1ms);
+  for (;;) {
+    TransactionIdSet pending_transactions;
+    {
+      // Resolver holds request scope, that could delay cleanup of aborted transactions, so it
+      // should be destroyed before waiting.
+      TransactionConflictResolverContext context(
+          doc_ops, write_batch, clock->Now(), read_time, nullptr /* conflicts_metric */,
+          &pending_transactions);
+      ConflictResolver resolver(doc_db, status_manager, partial_range_key_intents, &context);
+      auto status = resolver.Resolve();
+      if (!status.ok()) {
+        // Conflict would be detected again by ResolveTransactionConflicts.
+        VLOG(3) << *transaction_id << ", stop waiting: " << status;
+        return;
+      }
+    }
+    if (pending_transactions.empty()) {
+      return;
+    }
+
+    auto now = CoarseMonoClock::now();
+    if (now >= wait_end) {
+      VLOG(3) << *transaction_id << ", wait timed out";
+      return;
+    }
+    VLOG(4) << *transaction_id << ", wait for: " << yb::ToString(pending_transactions);
+    if (!wait_queue->Wait(
+            *transaction_id, pending_transactions,
+            std::min(wait_end, now + FLAGS_wait_queue_recheck_interval_ms * 1ms))) {
+      // Deadlock, so priority based resolution should break it.
+      return;
+    }
+  }
+}
+
 Result<HybridTime> ResolveOperationConflicts(const DocOperations& doc_ops,
                                              HybridTime resolution_ht,
                                              const DocDB& doc_db,
@@ -29,6 +29,7 @@ class Iterator;
 
 namespace yb {
 
+class ClockBase;
 class Counter;
 class HybridTime;
 class TransactionStatusManager;
@@ -55,6 +56,26 @@ CHECKED_STATUS ResolveTransactionConflicts(const DocOperations& doc_ops,
                                            TransactionStatusManager* status_manager,
                                            Counter* conflicts_metric);
 
+// Waits in the wait queue while there are pending transactions that conflict with the transaction
+// writing provided write_batch, until they are committed or aborted, for at most
+// wait_queue_max_wait_ms or until deadline. Does nothing if wait queues are disabled.
+// Blocks the calling thread, so it should be called before taking in-memory locks for the
+// operation. Conflicts are not resolved here, ResolveTransactionConflicts should be called after
+// that as usual.
+//
+// clock - used to pick hybrid time for requests to status tablets.
+// wait_queue - tablet wait queue, could be null.
+// deadline - deadline of the operation.
+void WaitForConflictingTransactions(const DocOperations& doc_ops,
+                                    const KeyValueWriteBatchPB& write_batch,
+                                    ClockBase* clock,
+                                    HybridTime read_time,
+                                    const DocDB& doc_db,
+                                    PartialRangeKeyIntents partial_range_key_intents,
+                                    TransactionStatusManager* status_manager,
+                                    WaitQueue* wait_queue,
+                                    CoarseTimePoint deadline);
+
 // Resolves conflicts for doc operations.
 // Read all intents that could conflict with provided doc_ops.
 // Forms set of conflicting transactions.
@@ -23,6 +23,7 @@
 
 #include "yb/docdb/doc_ql_scanspec.h"
 #include "yb/docdb/docdb_util.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/primitive_value_util.h"
 
 #include "yb/util/bfpg/tserver_opcodes.h"
@@ -41,6 +42,13 @@ DEFINE_bool(ycql_consistent_transactional_paging, false,
             "be stale. The latter is preferable for long scans. The data returned for the first "
             "page of results is never stale regardless of this flag.");
 
+DEFINE_bool(ycql_enable_packed_row, false,
+            "Whether new non-transactional YCQL tables should store values of all non-key "
+            "columns written by INSERT of the whole row as a single packed row entry, instead of "
+            "an entry per column. Checked by master when the table is created.");
+TAG_FLAG(ycql_enable_packed_row, advanced);
+TAG_FLAG(ycql_enable_packed_row, runtime);
+
 DECLARE_bool(trace_docdb_calls);
 
 namespace yb {
@@ -685,6 +693,75 @@ Status QLWriteOperation::ApplyForRegularColumns(const QLColumnValuePB& column_va
   return Status::OK();
 }
 
+Result<bool> QLWriteOperation::ApplyPackedRow(const DocOperationApplyData& data,
+                                              const QLTableRow& existing_row,
+                                              QLTableRow* new_row) {
+  using yb::bfql::TSOpcode;
+
+  // Packed row is written only when it replaces all non-key columns of the row and does not need
+  // column level ttl or write time.
+  if (!schema_.table_properties().use_packed_row() || txn_op_context_ || !encoded_pk_doc_key_ ||
+      request_.has_ttl() || request_.has_user_timestamp_usec() || schema_.has_statics() ||
+      schema_.table_properties().HasDefaultTimeToLive()) {
+    return false;
+  }
+  const size_t num_value_columns = schema_.num_columns() - schema_.num_key_columns();
+  if (num_value_columns == 0 ||
+      static_cast<size_t>(request_.column_values_size()) != num_value_columns) {
+    return false;
+  }
+
+  std::vector<std::pair<ColumnId, const QLColumnValuePB*>> column_values;
+  column_values.reserve(num_value_columns);
+  for (const auto& column_value : request_.column_values()) {
+    if (!column_value.has_column_id() || !column_value.json_args().empty() ||
+        !column_value.subscript_args().empty() ||
+        GetTSWriteInstruction(column_value.expr()) != TSOpcode::kScalarInsert) {
+      return false;
+    }
+    const ColumnId column_id(column_value.column_id());
+    const auto maybe_column = schema_.column_by_id(column_id);
+    if (!maybe_column.ok() || schema_.is_key_column(column_id) ||
+        maybe_column->type()->IsCollection() || maybe_column->type()->IsUserDefined()) {
+      return false;
+    }
+    column_values.emplace_back(column_id, &column_value);
+  }
+  std::sort(column_values.begin(), column_values.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+  for (size_t i = 1; i < column_values.size(); ++i) {
+    if (column_values[i - 1].first == column_values[i].first) {
+      return false;
+    }
+  }
+
+  std::vector<QLValue> expr_results(column_values.size());
+  RowPacker packer(request_.schema_version());
+  for (size_t i = 0; i != column_values.size(); ++i) {
+    const auto& column = *schema_.column_by_id(column_values[i].first);
+    RETURN_NOT_OK(EvalExpr(column_values[i].second->expr(), existing_row, &expr_results[i]));
+    const SubDocument sub_doc = SubDocument::FromQLValuePB(
+        expr_results[i].value(), column.sorting_type(), TSOpcode::kScalarInsert);
+    if (!IsPrimitiveValueType(sub_doc.value_type()) &&
+        sub_doc.value_type() != ValueType::kTombstone) {
+      return false;
+    }
+    packer.AddValue(column_values[i].first, sub_doc);
+  }
+
+  const DocPath sub_path(encoded_pk_doc_key_.as_slice(),
+                         PrimitiveValue::SystemColumnId(SystemColumnIds::kPackedRowColumn));
+  RETURN_NOT_OK(data.doc_write_batch->SetPrimitive(
+      sub_path, Value(packer.Complete()), data.read_time, data.deadline, request_.query_id()));
+
+  if (update_indexes_) {
+    for (size_t i = 0; i != column_values.size(); ++i) {
+      new_row->AllocColumn(column_values[i].first, expr_results[i]);
+    }
+  }
+  return true;
+}
+
 Status QLWriteOperation::Apply(const DocOperationApplyData& data) {
   QLTableRow existing_row;
   if (request_.has_if_expr()) {
@@ -770,31 +847,34 @@ Status QLWriteOperation::Apply(const DocOperationApplyData& data) {
             sub_path, value, data.read_time, data.deadline, request_.query_id()));
       }
 
-      for (const auto& column_value : request_.column_values()) {
-        if (!column_value.has_column_id()) {
-          return STATUS_FORMAT(InvalidArgument, "column id missing: $0",
-                               column_value.DebugString());
-        }
-        const ColumnId column_id(column_value.column_id());
-        const auto maybe_column = schema_.column_by_id(column_id);
-        RETURN_NOT_OK(maybe_column);
-        const ColumnSchema& column = *maybe_column;
+      // Insert of the whole row could be stored as a single packed row entry.
+      if (!is_insert || !VERIFY_RESULT(ApplyPackedRow(data, existing_row, &new_row))) {
+        for (const auto& column_value : request_.column_values()) {
+          if (!column_value.has_column_id()) {
+            return STATUS_FORMAT(InvalidArgument, "column id missing: $0",
+                                 column_value.DebugString());
+          }
+          const ColumnId column_id(column_value.column_id());
+          const auto maybe_column = schema_.column_by_id(column_id);
+          RETURN_NOT_OK(maybe_column);
+          const ColumnSchema& column = *maybe_column;
 
-        DocPath sub_path(
-            column.is_static() ?
-                encoded_hashed_doc_key_.as_slice() : encoded_pk_doc_key_.as_slice(),
-            PrimitiveValue(column_id));
-
-        QLValue expr_result;
-        if (!column_value.json_args().empty()) {
-          RETURN_NOT_OK(ApplyForJsonOperators(column_value, data, sub_path, ttl,
-                                              user_timestamp, column, &new_row, is_insert));
-        } else if (!column_value.subscript_args().empty()) {
-          RETURN_NOT_OK(ApplyForSubscriptArgs(column_value, existing_row, data, ttl,
-                                              user_timestamp, column, &sub_path));
-        } else {
-          RETURN_NOT_OK(ApplyForRegularColumns(column_value, existing_row, data, sub_path, ttl,
-                                               user_timestamp, column, column_id, &new_row));
+          DocPath sub_path(
+              column.is_static() ?
+                  encoded_hashed_doc_key_.as_slice() : encoded_pk_doc_key_.as_slice(),
+              PrimitiveValue(column_id));
+
+          QLValue expr_result;
+          if (!column_value.json_args().empty()) {
+            RETURN_NOT_OK(ApplyForJsonOperators(column_value, data, sub_path, ttl,
+                                                user_timestamp, column, &new_row, is_insert));
+          } else if (!column_value.subscript_args().empty()) {
+            RETURN_NOT_OK(ApplyForSubscriptArgs(column_value, existing_row, data, ttl,
+                                                user_timestamp, column, &sub_path));
+          } else {
+            RETURN_NOT_OK(ApplyForRegularColumns(column_value, existing_row, data, sub_path, ttl,
+                                                 user_timestamp, column, column_id, &new_row));
+          }
         }
       }
 
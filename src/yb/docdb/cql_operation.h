@@ -107,6 +107,12 @@ class QLWriteOperation :
   // Initialize hashed_doc_key_ and/or pk_doc_key_.
   CHECKED_STATUS InitializeKeys(bool hashed_key, bool primary_key);
 
+  // Writes values of all non-key columns of the insert as a single packed row entry.
+  // Returns false without writing anything when the insert could not be packed.
+  Result<bool> ApplyPackedRow(const DocOperationApplyData& data,
+                              const QLTableRow& existing_row,
+                              QLTableRow* new_row);
+
   CHECKED_STATUS ReadColumns(const DocOperationApplyData& data,
                              Schema *static_projection,
                              Schema *non_static_projection,
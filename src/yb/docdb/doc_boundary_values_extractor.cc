@@ -13,10 +13,14 @@
 //
 //
 
+#include "yb/gutil/endian.h"
+
+#include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksdb/db/dbformat.h"
 
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/value.h"
 
 namespace yb {
 namespace docdb {
@@ -30,6 +34,16 @@ Status GetPrimitiveValue(const rocksdb::UserBoundaryValues& values,
 namespace {
 
 constexpr rocksdb::UserBoundaryTag kDocHybridTimeTag = 1;
+// Hybrid time at which the record expires, for records with explicit TTL, tombstones and records
+// that could not be decoded. HybridTime::kMax when the record never expires.
+constexpr rocksdb::UserBoundaryTag kExplicitExpirationTag = 2;
+// Write hybrid time of the record, for records that expire according to the table level TTL.
+constexpr rocksdb::UserBoundaryTag kTableTtlWriteTimeTag = 3;
+// The earliest hybrid time at which the record could become visible to reads. It differs from the
+// hybrid time of the record for transactional records, that are visible at their intent time.
+constexpr rocksdb::UserBoundaryTag kVisibleTimeTag = 4;
+// Write hybrid time of the merge records, i.e. records that update TTL of the earlier records.
+constexpr rocksdb::UserBoundaryTag kMergeRecordTimeTag = 5;
 // Here we reserve some tags for future use.
 // Because Tag is persistent.
 constexpr rocksdb::UserBoundaryTag kRangeComponentsStart = 10;
@@ -80,6 +94,70 @@ class DocHybridTimeValue : public rocksdb::UserBoundaryValue {
   Slice encoded_;
 };
 
+// Wrapper for UserBoundaryValue that stores HybridTime with specified tag.
+class HybridTimeBoundaryValue : public rocksdb::UserBoundaryValue {
+ public:
+  HybridTimeBoundaryValue(rocksdb::UserBoundaryTag tag, HybridTime value) : tag_(tag) {
+    BigEndian::Store64(buffer_, value.ToUint64());
+  }
+
+  static CHECKED_STATUS Create(
+      rocksdb::UserBoundaryTag tag, Slice data, rocksdb::UserBoundaryValuePtr* value) {
+    CHECK_NOTNULL(value);
+    if (data.size() != sizeof(buffer_)) {
+      return STATUS_FORMAT(Corruption, "Wrong size of encoded hybrid time: $0", data.size());
+    }
+
+    *value = std::make_shared<HybridTimeBoundaryValue>(
+        tag, HybridTime(BigEndian::Load64(data.data())));
+    return Status::OK();
+  }
+
+  static HybridTime Decode(const Slice& data) {
+    return data.size() == sizeof(uint64_t) ? HybridTime(BigEndian::Load64(data.data()))
+                                           : HybridTime::kInvalid;
+  }
+
+  virtual ~HybridTimeBoundaryValue() {}
+
+  rocksdb::UserBoundaryTag Tag() override {
+    return tag_;
+  }
+
+  Slice Encode() override {
+    return Slice(buffer_, sizeof(buffer_));
+  }
+
+  HybridTime value() const {
+    return HybridTime(BigEndian::Load64(buffer_));
+  }
+
+  int CompareTo(const UserBoundaryValue& pre_rhs) override {
+    const auto* rhs = down_cast<const HybridTimeBoundaryValue*>(&pre_rhs);
+    return value().CompareTo(rhs->value());
+  }
+
+ private:
+  rocksdb::UserBoundaryTag tag_;
+  char buffer_[sizeof(uint64_t)];
+};
+
+// Returns hybrid time at which the record written at write_time with specified TTL expires.
+HybridTime ExpirationTime(HybridTime write_time, MonoDelta ttl) {
+  // TTL below one millisecond is treated as no TTL, the same way as in ComputeTTL.
+  if (!ttl.Initialized() || ttl.Equals(Value::kMaxTtl) || ttl.IsNegative() ||
+      ttl.ToMilliseconds() == 0) {
+    return HybridTime::kMax;
+  }
+  // Round TTL up, so the result is never earlier than the actual expiration.
+  uint64_t ttl_micros = (ttl.ToNanoseconds() + MonoTime::kNanosecondsPerMicrosecond - 1) /
+                        MonoTime::kNanosecondsPerMicrosecond;
+  if (ttl_micros >= kMaxHybridTimePhysicalMicros - write_time.GetPhysicalValueMicros()) {
+    return HybridTime::kMax;
+  }
+  return write_time.AddMicroseconds(ttl_micros);
+}
+
 // Wrapper for UserBoundaryValue that stores PrimitiveValue with index.
 class PrimitiveBoundaryValue : public rocksdb::UserBoundaryValue {
  public:
@@ -147,6 +225,10 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     if (tag == kDocHybridTimeTag) {
       return DocHybridTimeValue::Create(data, value);
     }
+    if (tag == kExplicitExpirationTag || tag == kTableTtlWriteTimeTag || tag == kVisibleTimeTag ||
+        tag == kMergeRecordTimeTag) {
+      return HybridTimeBoundaryValue::Create(tag, data, value);
+    }
     if (tag >= kRangeComponentsStart) {
       return PrimitiveBoundaryValue::Create(tag - kRangeComponentsStart, data, value);
     }
@@ -177,6 +259,8 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     RETURN_NOT_OK(DocHybridTimeValue::Create(slices.back(), &temp));
     values->push_back(std::move(temp));
 
+    RETURN_NOT_OK(ExtractTimes(slices.back(), value, values));
+
     for (size_t i = 0; i != size; ++i) {
       RETURN_NOT_OK(PrimitiveBoundaryValue::Create(i, slices[i], &temp));
       values->push_back(std::move(temp));
@@ -187,6 +271,54 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     return Status::OK();
   }
 
+  // Adds visibility time and expiration of the record to values. Records that could not be decoded
+  // are treated as never expiring, since the expiration is used to drop whole files.
+  CHECKED_STATUS ExtractTimes(
+      Slice encoded_doc_ht, Slice value, rocksdb::UserBoundaryValues* values) {
+    DocHybridTime doc_ht;
+    RETURN_NOT_OK(doc_ht.FullyDecodeFrom(encoded_doc_ht));
+    auto write_time = doc_ht.hybrid_time();
+    auto visible_time = write_time;
+    auto expiration = HybridTime::kMax;
+    bool table_ttl = false;
+    bool merge_record = false;
+
+    Value decoded_value;
+    Slice value_slice = value;
+    if (decoded_value.DecodeControlFields(&value_slice).ok()) {
+      // Transactional record could be visible since its intent time.
+      auto intent_doc_ht = decoded_value.intent_doc_ht();
+      if (intent_doc_ht.is_valid()) {
+        visible_time = std::min(visible_time, intent_doc_ht.hybrid_time());
+      }
+      // Merge records could extend TTL of the earlier records, so they never expire.
+      merge_record = decoded_value.merge_flags() != 0;
+      if (!merge_record) {
+        if (DecodeValueType(value_slice) == ValueType::kTombstone) {
+          expiration = write_time;
+        } else if (decoded_value.ttl().Equals(Value::kMaxTtl)) {
+          table_ttl = true;
+        } else {
+          expiration = ExpirationTime(write_time, decoded_value.ttl());
+        }
+      }
+    }
+
+    values->push_back(std::make_shared<HybridTimeBoundaryValue>(kVisibleTimeTag, visible_time));
+    if (table_ttl) {
+      values->push_back(
+          std::make_shared<HybridTimeBoundaryValue>(kTableTtlWriteTimeTag, write_time));
+    } else {
+      values->push_back(
+          std::make_shared<HybridTimeBoundaryValue>(kExplicitExpirationTag, expiration));
+    }
+    if (merge_record) {
+      values->push_back(
+          std::make_shared<HybridTimeBoundaryValue>(kMergeRecordTimeTag, write_time));
+    }
+    return Status::OK();
+  }
+
   rocksdb::UserFrontierPtr CreateFrontier() override {
     return new docdb::ConsensusFrontier();
   }
@@ -252,6 +384,33 @@ Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime
   return time_value->value(out);
 }
 
+HybridTime GetMinVisibleHybridTime(const rocksdb::LightweightBoundaries& smallest) {
+  const auto* value = smallest.user_value_with_tag(kVisibleTimeTag);
+  return value ? HybridTimeBoundaryValue::Decode(*value) : HybridTime::kInvalid;
+}
+
+HybridTime GetMaxExpiration(const rocksdb::UserBoundaryValues& largest, MonoDelta table_ttl) {
+  auto explicit_expiration = rocksdb::UserValueWithTag(largest, kExplicitExpirationTag);
+  auto table_ttl_write_time = rocksdb::UserValueWithTag(largest, kTableTtlWriteTimeTag);
+  if (!explicit_expiration && !table_ttl_write_time) {
+    // File was written without expiration metadata.
+    return HybridTime::kMax;
+  }
+  auto result = HybridTime::kMin;
+  if (explicit_expiration) {
+    result = down_cast<HybridTimeBoundaryValue*>(explicit_expiration.get())->value();
+  }
+  if (table_ttl_write_time) {
+    auto write_time = down_cast<HybridTimeBoundaryValue*>(table_ttl_write_time.get())->value();
+    result.MakeAtLeast(ExpirationTime(write_time, table_ttl));
+  }
+  return result;
+}
+
+bool HasMergeRecords(const rocksdb::UserBoundaryValues& largest) {
+  return rocksdb::UserValueWithTag(largest, kMergeRecordTimeTag) != nullptr;
+}
+
 rocksdb::UserBoundaryTag TagForRangeComponent(size_t index) {
   return PrimitiveBoundaryValue::TagForIndex(index);
 }
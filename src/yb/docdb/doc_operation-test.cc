@@ -11,6 +11,7 @@
 // under the License.
 //
 
+#include <numeric>
 #include <thread>
 
 #include "yb/rocksdb/statistics.h"
@@ -935,6 +936,182 @@ SubDocKey(DocKey(0x0000, [1], []), [ColumnId(3); HT{ physical: 1000 logical: 1 w
   EXPECT_EQ(30, row_block.row(0).column(3).int32_value());
 }
 
+TEST_F(DocOperationTest, TestQLPackedRow) {
+  const HybridTime t0 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(1000, 0);
+  const HybridTime t1 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(2000, 0);
+  const HybridTime t2 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(3000, 0);
+  const HybridTime t3 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(4000, 0);
+  const HybridTime t4 = HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(5000, 0);
+  Schema schema = CreateSchema();
+  schema.mutable_table_properties()->SetUsePackedRow(true);
+
+  // Updates single column of the row, null value is written as a tombstone.
+  auto update_column = [this, &schema](int32_t column_id, const int32_t* value, HybridTime ht) {
+    QLWriteRequestPB ql_writereq_pb;
+    QLResponsePB ql_writeresp_pb;
+    ql_writereq_pb.set_type(QLWriteRequestPB_QLStmtType_QL_STMT_UPDATE);
+    ql_writereq_pb.set_hash_code(kFixedHashCode);
+    AddPrimaryKeyColumn(&ql_writereq_pb, 1);
+    auto column = ql_writereq_pb.add_column_values();
+    column->set_column_id(column_id);
+    auto* expr_value = column->mutable_expr()->mutable_value();
+    if (value) {
+      expr_value->set_int32_value(*value);
+    }
+    WriteQL(&ql_writereq_pb, schema, &ql_writeresp_pb, ht);
+  };
+
+  const int32_t kOldValue = 5;
+  update_column(1, &kOldValue, t0);
+
+  // Insert without ttl of all columns is stored as a packed row.
+  {
+    QLWriteRequestPB ql_writereq_pb;
+    QLResponsePB ql_writeresp_pb;
+    ql_writereq_pb.set_type(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT);
+    ql_writereq_pb.set_hash_code(kFixedHashCode);
+    AddPrimaryKeyColumn(&ql_writereq_pb, 1);
+    AddColumnValues(schema, {1, 2, 3}, &ql_writereq_pb);
+    WriteQL(&ql_writereq_pb, schema, &ql_writeresp_pb, t1);
+  }
+
+  AssertDocDbDebugDumpStrEq(R"#(
+SubDocKey(DocKey(0x0000, [1], []), [SystemColumnId(0); HT{ physical: 2000 }]) -> null
+SubDocKey(DocKey(0x0000, [1], []), [SystemColumnId(1); HT{ physical: 2000 w: 1 }]) -> \
+    PackedRow{ schema_version: 0 1: 1 2: 2 3: 3 }
+SubDocKey(DocKey(0x0000, [1], []), [ColumnId(1); HT{ physical: 1000 }]) -> 5
+      )#");
+
+  QLRowBlock row_block = ReadQLRow(schema, 1, t1);
+  ASSERT_EQ(1, row_block.row_count());
+  EXPECT_EQ(1, row_block.row(0).column(0).int32_value());
+  EXPECT_EQ(1, row_block.row(0).column(1).int32_value());
+  EXPECT_EQ(2, row_block.row(0).column(2).int32_value());
+  EXPECT_EQ(3, row_block.row(0).column(3).int32_value());
+
+  // Column level updates written after the packed row take precedence over packed values.
+  const int32_t kNewValue = 20;
+  update_column(2, &kNewValue, t2);
+  update_column(3, nullptr, t3);
+
+  auto check_updated_row = [this, &schema](HybridTime read_time) {
+    QLRowBlock row_block = ReadQLRow(schema, 1, read_time);
+    ASSERT_EQ(1, row_block.row_count());
+    EXPECT_EQ(1, row_block.row(0).column(0).int32_value());
+    EXPECT_EQ(1, row_block.row(0).column(1).int32_value());
+    EXPECT_EQ(20, row_block.row(0).column(2).int32_value());
+    EXPECT_TRUE(row_block.row(0).column(3).IsNull());
+  };
+
+  ASSERT_NO_FATALS(check_updated_row(t4));
+
+  // Reads before the updates still see packed values.
+  row_block = ReadQLRow(schema, 1, t1);
+  ASSERT_EQ(1, row_block.row_count());
+  EXPECT_EQ(2, row_block.row(0).column(2).int32_value());
+  EXPECT_EQ(3, row_block.row(0).column(3).int32_value());
+
+  // Compaction removes the column entry overwritten by the packed row, but keeps the tombstone
+  // that overwrites the packed value.
+  FullyCompactHistoryBefore(t4);
+
+  AssertDocDbDebugDumpStrEq(R"#(
+SubDocKey(DocKey(0x0000, [1], []), [SystemColumnId(0); HT{ physical: 2000 }]) -> null
+SubDocKey(DocKey(0x0000, [1], []), [SystemColumnId(1); HT{ physical: 2000 w: 1 }]) -> \
+    PackedRow{ schema_version: 0 1: 1 2: 2 3: 3 }
+SubDocKey(DocKey(0x0000, [1], []), [ColumnId(2); HT{ physical: 3000 }]) -> 20
+SubDocKey(DocKey(0x0000, [1], []), [ColumnId(3); HT{ physical: 4000 }]) -> DEL
+      )#");
+
+  ASSERT_NO_FATALS(check_updated_row(t4));
+}
+
+// Compares number of RocksDB entries and time of writes and scans of wide rows stored with and
+// without packed row.
+TEST_F(DocOperationTest, QLPackedRowWideTable) {
+  constexpr int kNumRows = 1000;
+  // Number of RocksDB iterator seeks and nexts of the packed scan of the previous table.
+  uint64_t prev_packed_scan_ops = 0;
+  for (int num_value_columns : {10, 100}) {
+    std::vector<ColumnSchema> columns;
+    columns.emplace_back("k", INT32, false, true);
+    for (int i = 1; i <= num_value_columns; ++i) {
+      columns.emplace_back(Format("c$0", i), INT32, false, false);
+    }
+    std::vector<int32_t> values(num_value_columns);
+    std::iota(values.begin(), values.end(), 1);
+
+    // Number of RocksDB iterator seeks and nexts of the scan without packed rows.
+    uint64_t unpacked_scan_ops = 0;
+    for (bool packed : {false, true}) {
+      Schema schema(columns, CreateColumnIds(columns.size()), 1);
+      schema.mutable_table_properties()->SetUsePackedRow(packed);
+      ASSERT_OK(DestroyRocksDB());
+      ASSERT_OK(ReopenRocksDB());
+
+      auto start = MonoTime::Now();
+      for (int row = 0; row != kNumRows; ++row) {
+        QLWriteRequestPB ql_writereq_pb;
+        QLResponsePB ql_writeresp_pb;
+        ql_writereq_pb.set_type(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT);
+        ql_writereq_pb.set_hash_code(kFixedHashCode);
+        AddPrimaryKeyColumn(&ql_writereq_pb, row);
+        AddColumnValues(schema, values, &ql_writereq_pb);
+        WriteQL(&ql_writereq_pb, schema, &ql_writeresp_pb,
+                HybridTime::FromMicrosecondsAndLogicalValue(1000 + row, 0));
+      }
+      const auto write_time = MonoTime::Now() - start;
+
+      uint64_t num_entries = 0;
+      ASSERT_TRUE(rocksdb()->GetIntProperty(
+          rocksdb::DB::Properties::kEstimateNumKeys, &num_entries));
+      // Liveness column and either packed row or an entry per column.
+      ASSERT_EQ(kNumRows * (packed ? 2 : num_value_columns + 1), num_entries);
+
+      auto* statistics = rocksdb()->GetDBOptions().statistics.get();
+      auto scan_ops = [statistics] {
+        return statistics->getTickerCount(rocksdb::NUMBER_DB_SEEK) +
+               statistics->getTickerCount(rocksdb::NUMBER_DB_NEXT);
+      };
+      const auto ops_before_scan = scan_ops();
+      start = MonoTime::Now();
+      DocRowwiseIterator iter(schema, schema, kNonTransactionalOperationContext,
+                              doc_db(), CoarseTimePoint::max() /* deadline */,
+                              ReadHybridTime::FromMicros(1000 + kNumRows));
+      ASSERT_OK(iter.Init());
+      int num_rows = 0;
+      while (ASSERT_RESULT(iter.HasNext())) {
+        QLTableRow row;
+        ASSERT_OK(iter.NextRow(&row));
+        ASSERT_EQ(num_value_columns + 1, row.ColumnCount());
+        ASSERT_EQ(num_value_columns, row.TestValue(num_value_columns).value.int32_value());
+        ++num_rows;
+      }
+      const auto scan_time = MonoTime::Now() - start;
+      const auto num_scan_ops = scan_ops() - ops_before_scan;
+      ASSERT_EQ(kNumRows, num_rows);
+
+      LOG(INFO) << num_value_columns << " columns, packed: " << packed
+                << ", entries: " << num_entries << ", write time: " << write_time
+                << ", scan time: " << scan_time << ", seeks and nexts: " << num_scan_ops;
+
+      if (!packed) {
+        unpacked_scan_ops = num_scan_ops;
+        // At least one iterator operation for each column of each row.
+        ASSERT_GE(num_scan_ops, static_cast<uint64_t>(kNumRows * num_value_columns));
+      } else {
+        ASSERT_LT(num_scan_ops, unpacked_scan_ops);
+        // Columns are read from the packed row, so number of iterator operations per row does not
+        // depend on the number of columns.
+        if (prev_packed_scan_ops) {
+          ASSERT_LT(num_scan_ops, prev_packed_scan_ops * 2);
+        }
+        prev_packed_scan_ops = num_scan_ops;
+      }
+    }
+  }
+}
+
 namespace {
 
 size_t GenerateFiles(int total_batches, DocOperationTest* test) {
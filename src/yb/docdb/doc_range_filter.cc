@@ -0,0 +1,204 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/doc_range_filter.h"
+
+#include <algorithm>
+
+#include <gflags/gflags.h>
+
+#include "yb/rocksdb/table/table_reader.h"
+
+#include "yb/util/flag_tags.h"
+
+DEFINE_bool(use_docdb_range_filter, true,
+            "Whether to build range filters of SST files and use them to skip files during range "
+            "scans.");
+DEFINE_int32(docdb_range_filter_max_prefix_bytes, 32,
+             "Maximal length of the key prefixes stored in the range filter of SST file.");
+TAG_FLAG(docdb_range_filter_max_prefix_bytes, advanced);
+DEFINE_int32(docdb_range_filter_max_entries, 1024,
+             "Maximal number of the key prefixes stored in the range filter of SST file. Prefixes "
+             "are shortened to fit into this limit.");
+TAG_FLAG(docdb_range_filter_max_entries, advanced);
+
+namespace yb {
+namespace docdb {
+
+const char kDocRangeFilterPropertyName[] = "yb.docdb.range_filter";
+
+namespace {
+
+constexpr size_t kMaxPrefixSize = 0xff;
+
+Slice Truncate(const Slice& key, size_t size) {
+  return Slice(key.data(), std::min(key.size(), size));
+}
+
+class DocRangeFilterCollector : public rocksdb::TablePropertiesCollector {
+ public:
+  DocRangeFilterCollector()
+      : prefix_size_(std::min<size_t>(
+            std::max(FLAGS_docdb_range_filter_max_prefix_bytes, 0), kMaxPrefixSize)),
+        max_entries_(std::max(FLAGS_docdb_range_filter_max_entries, 1)) {}
+
+  Status AddUserKey(const Slice& key, const Slice& value, rocksdb::EntryType type,
+                    rocksdb::SequenceNumber seq, uint64_t file_size) override {
+    if (prefix_size_ == 0) {
+      return Status::OK();
+    }
+    // Keys are added in sorted order, so it is enough to compare with the last prefix.
+    auto prefix = Truncate(key, prefix_size_);
+    if (!prefixes_.empty() && Slice(prefixes_.back()) == prefix) {
+      return Status::OK();
+    }
+    prefixes_.push_back(prefix.ToBuffer());
+    while (prefixes_.size() > max_entries_ && prefix_size_ != 0) {
+      Shorten();
+    }
+    return Status::OK();
+  }
+
+  Status Finish(rocksdb::UserCollectedProperties* properties) override {
+    // File without range filter is never skipped, so there is no reason to store empty filter.
+    if (prefix_size_ == 0 || prefixes_.empty()) {
+      return Status::OK();
+    }
+    std::string filter;
+    filter.reserve(1 + prefixes_.size() * (prefix_size_ + 1));
+    filter.push_back(static_cast<char>(prefix_size_));
+    for (const auto& prefix : prefixes_) {
+      filter.append(prefix);
+      filter.append(prefix_size_ - prefix.size(), '\0');
+      filter.push_back(static_cast<char>(prefix.size()));
+    }
+    properties->emplace(kDocRangeFilterPropertyName, std::move(filter));
+    return Status::OK();
+  }
+
+  rocksdb::UserCollectedProperties GetReadableProperties() const override {
+    return {
+      {"yb.docdb.range_filter.prefix_size", std::to_string(prefix_size_)},
+      {"yb.docdb.range_filter.num_prefixes", std::to_string(prefixes_.size())},
+    };
+  }
+
+  const char* Name() const override {
+    return "DocRangeFilterCollector";
+  }
+
+ private:
+  // Truncates all prefixes to shorter length and removes duplicates.
+  void Shorten() {
+    prefix_size_ = prefix_size_ * 3 / 4;
+    if (prefix_size_ == 0) {
+      prefixes_.clear();
+      return;
+    }
+    for (auto& prefix : prefixes_) {
+      if (prefix.size() > prefix_size_) {
+        prefix.resize(prefix_size_);
+      }
+    }
+    prefixes_.erase(std::unique(prefixes_.begin(), prefixes_.end()), prefixes_.end());
+  }
+
+  size_t prefix_size_;
+  const size_t max_entries_;
+  std::vector<std::string> prefixes_;
+};
+
+class DocRangeFileFilter : public rocksdb::TableAwareReadFileFilter {
+ public:
+  DocRangeFileFilter(const Slice& lower, const Slice& upper)
+      : lower_(lower.ToBuffer()), upper_(upper.ToBuffer()) {}
+
+  bool Filter(rocksdb::TableReader* reader) const override {
+    auto properties = reader->GetTableProperties();
+    if (!properties) {
+      return true;
+    }
+    const auto& user_properties = properties->user_collected_properties;
+    auto it = user_properties.find(kDocRangeFilterPropertyName);
+    if (it == user_properties.end()) {
+      return true;
+    }
+    return DocRangeFilterMayMatch(it->second, lower_, upper_);
+  }
+
+ private:
+  const std::string lower_;
+  const std::string upper_;
+};
+
+} // namespace
+
+bool DocRangeFilterMayMatch(const Slice& filter, const Slice& lower, const Slice& upper) {
+  if (filter.empty()) {
+    return true;
+  }
+  const size_t prefix_size = static_cast<uint8_t>(filter[0]);
+  const size_t entry_size = prefix_size + 1;
+  if (prefix_size == 0 || (filter.size() - 1) % entry_size != 0) {
+    return true;
+  }
+  const size_t num_entries = (filter.size() - 1) / entry_size;
+  auto entry = [filter, prefix_size, entry_size](size_t index) {
+    const uint8_t* data = filter.data() + 1 + index * entry_size;
+    return Slice(data, std::min<size_t>(data[prefix_size], prefix_size));
+  };
+
+  // Any key at or after lower has prefix at or after the prefix of lower.
+  const auto lower_prefix = Truncate(lower, prefix_size);
+  size_t left = 0, right = num_entries;
+  while (left < right) {
+    size_t middle = (left + right) / 2;
+    if (entry(middle).compare(lower_prefix) < 0) {
+      left = middle + 1;
+    } else {
+      right = middle;
+    }
+  }
+  if (left == num_entries) {
+    return false;
+  }
+  if (upper.empty()) {
+    return true;
+  }
+
+  // Prefixes at or before the prefix of upper, or starting with it, form the beginning of the
+  // sorted set. So it is enough to check the first prefix at or after the prefix of lower.
+  const auto upper_prefix = Truncate(upper, prefix_size);
+  const auto candidate = entry(left);
+  return candidate.compare(upper_prefix) <= 0 || candidate.starts_with(upper_prefix);
+}
+
+rocksdb::TablePropertiesCollector* DocRangeFilterCollectorFactory::CreateTablePropertiesCollector(
+    rocksdb::TablePropertiesCollectorFactory::Context context) {
+  return new DocRangeFilterCollector();
+}
+
+const char* DocRangeFilterCollectorFactory::Name() const {
+  return "DocRangeFilterCollectorFactory";
+}
+
+std::shared_ptr<rocksdb::TableAwareReadFileFilter> CreateDocRangeFileFilter(
+    const Slice& lower, const Slice& upper) {
+  if (!FLAGS_use_docdb_range_filter || (lower.empty() && upper.empty())) {
+    return nullptr;
+  }
+  return std::make_shared<DocRangeFileFilter>(lower, upper);
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,64 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_DOC_RANGE_FILTER_H
+#define YB_DOCDB_DOC_RANGE_FILTER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "yb/rocksdb/options.h"
+#include "yb/rocksdb/table_properties.h"
+
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace docdb {
+
+// Range filter of the SST file is a sorted set of distinct key prefixes of the same maximal length,
+// i.e. a trie truncated at fixed depth. It answers whether the file could contain keys in the
+// specified range, with false positives but without false negatives. Unlike the DocDB aware bloom
+// filter, it works for ranges that do not fully specify hashed components of the key.
+//
+// The filter is built by DocRangeFilterCollector and stored in the table properties of the file
+// under kDocRangeFilterPropertyName, with the following content:
+//
+//   prefix_size (prefix padded by zeros to prefix_size, prefix_length)*
+//
+// where prefix_size and prefix_length are single bytes. Prefixes are shortened while the filter is
+// being built, so the number of prefixes does not exceed docdb_range_filter_max_entries.
+extern const char kDocRangeFilterPropertyName[];
+
+// Returns whether file with specified range filter could contain keys that are at or after lower
+// and at or before upper, or start with upper. Empty bound means no bound.
+bool DocRangeFilterMayMatch(const Slice& filter, const Slice& lower, const Slice& upper);
+
+class DocRangeFilterCollectorFactory : public rocksdb::TablePropertiesCollectorFactory {
+ public:
+  rocksdb::TablePropertiesCollector* CreateTablePropertiesCollector(
+      rocksdb::TablePropertiesCollectorFactory::Context context) override;
+
+  const char* Name() const override;
+};
+
+// Returns filter that skips SST files that do not contain keys in range specified by lower and
+// upper, using their range filters. Returns nullptr when range filters are disabled or the range
+// is not bounded.
+std::shared_ptr<rocksdb::TableAwareReadFileFilter> CreateDocRangeFileFilter(
+    const Slice& lower, const Slice& upper);
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_DOC_RANGE_FILTER_H
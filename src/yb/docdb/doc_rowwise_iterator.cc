@@ -20,6 +20,7 @@
 
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ql_scanspec.h"
+#include "yb/docdb/doc_range_filter.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb-internal.h"
@@ -479,8 +480,14 @@ DocRowwiseIterator::DocRowwiseIterator(
       has_bound_key_(false),
       pending_op_(pending_op_counter),
       done_(false) {
-  projection_subkeys_.reserve(projection.num_columns() + 1);
+  projection_subkeys_.reserve(projection.num_columns() + 2);
   projection_subkeys_.push_back(PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn));
+  if (schema.table_properties().use_packed_row() &&
+      projection.num_columns() > projection.num_key_columns()) {
+    // Values of projected columns could be stored in the packed row.
+    projection_subkeys_.push_back(
+        PrimitiveValue::SystemColumnId(SystemColumnIds::kPackedRowColumn));
+  }
   for (size_t i = projection_.num_key_columns(); i < projection.num_columns(); i++) {
     projection_subkeys_.emplace_back(projection.column_id(i));
   }
@@ -560,9 +567,13 @@ Status DocRowwiseIterator::DoInit(const T& doc_spec) {
   const auto mode = is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER
                                        : BloomFilterMode::DONT_USE_BLOOM_FILTER;
 
+  // Range filters are used when bloom filters are not applicable.
+  auto range_filter = is_fixed_point_get
+      ? nullptr : CreateDocRangeFileFilter(lower_doc_key.AsSlice(), upper_doc_key.AsSlice());
   db_iter_ = CreateIntentAwareIterator(
       doc_db_, mode, lower_doc_key.AsSlice(), doc_spec.QueryId(), txn_op_context_,
-      deadline_, read_time_, doc_spec.CreateFileFilter());
+      deadline_, read_time_, doc_spec.CreateFileFilter(), nullptr /* iterate_upper_bound */,
+      std::move(range_filter));
 
   row_ready_ = false;
 
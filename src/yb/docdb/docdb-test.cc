@@ -17,6 +17,7 @@
 #include <string>
 
 #include "yb/rocksdb/db.h"
+#include "yb/rocksdb/rate_limiter.h"
 #include "yb/rocksdb/status.h"
 #include "yb/rocksdb/util/statistics.h"
 
@@ -33,9 +34,11 @@
 #include "yb/server/hybrid_clock.h"
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/doc_range_filter.h"
 
 #include "yb/util/minmax.h"
 #include "yb/util/path_util.h"
+#include "yb/util/random_util.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/string_trim.h"
 #include "yb/util/test_macros.h"
@@ -60,7 +63,14 @@ using namespace std::chrono_literals;
 
 DECLARE_bool(use_docdb_aware_bloom_filter);
 DECLARE_int32(max_nexts_to_avoid_seek);
+DECLARE_int32(docdb_range_filter_max_prefix_bytes);
+DECLARE_int32(docdb_range_filter_max_entries);
 DECLARE_bool(docdb_sort_weak_intents_in_tests);
+DECLARE_int32(rocksdb_max_subcompactions);
+DECLARE_uint64(rocksdb_compaction_size_threshold_bytes);
+DECLARE_int64(db_block_size_bytes);
+DECLARE_bool(rocksdb_compact_flush_rate_limit_per_data_dir);
+DECLARE_bool(use_read_time_file_filter);
 
 #define ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(str) ASSERT_NO_FATALS(AssertDocDbDebugDumpStrEq(str))
 
@@ -1935,6 +1945,173 @@ SubDocKey(DocKey([], ["k1"]), ["s3"; HT{ physical: 2000 }]) -> "v3"; ttl: 0.000s
       )#");
 }
 
+TEST_F(DocDBTest, ExpiredFilesCompactionTest) {
+  ASSERT_OK(DisableCompactions());
+  const DocKey doc_key(PrimitiveValues("k1"));
+  KeyBytes encoded_doc_key(doc_key.Encode());
+  // File 1 contains value that is hidden by the expired value from file 2, so file 2 could not be
+  // dropped without reading it.
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("s1")),
+      PrimitiveValue("v1"), 1000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("s1")),
+      Value(PrimitiveValue("v2"), 1ms), 2000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("s2")),
+      PrimitiveValue("v3"), 5000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_EQ(3, NumSSTableFiles());
+
+  // Compaction opens an iterator for each input file that is read and one more to verify the
+  // output file.
+  auto num_iterators = [this] {
+    return options().statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS);
+  };
+  auto iterators_before = num_iterators();
+  FullyCompactHistoryBefore(4000_usec_ht);
+  ASSERT_EQ(3 + 1, num_iterators() - iterators_before);
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(R"#(
+      SubDocKey(DocKey([], ["k1"]), ["s2"; HT{ physical: 5000 }]) -> "v3"
+      )#");
+
+  // File 4 contains only expired values older than all other records, so it is dropped.
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("s3")),
+      Value(PrimitiveValue("v4"), 1ms), 3000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("s4")),
+      Value(PrimitiveValue("v5"), 1ms), 6000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_EQ(3, NumSSTableFiles());
+
+  iterators_before = num_iterators();
+  FullyCompactHistoryBefore(6500_usec_ht);
+  // File 4 is not opened.
+  ASSERT_EQ(2 + 1, num_iterators() - iterators_before);
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(R"#(
+      SubDocKey(DocKey([], ["k1"]), ["s2"; HT{ physical: 5000 }]) -> "v3"
+      SubDocKey(DocKey([], ["k1"]), ["s4"; HT{ physical: 6000 }]) -> "v5"; ttl: 0.001s
+      )#");
+
+  // Table TTL also expires values without explicit TTL.
+  SetTableTTL(1);
+  FullyCompactHistoryBefore(8000_usec_ht);
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ("");
+}
+
+TEST_F(DocDBTest, ReadTimeFileFilterTest) {
+  ASSERT_OK(DisableCompactions());
+  const DocKey doc_key(PrimitiveValues("k1"));
+  KeyBytes encoded_doc_key(doc_key.Encode());
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("s1")),
+      PrimitiveValue("v1"), 1000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  // File 2 contains only records written after the global limit of the read.
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("s2")),
+      PrimitiveValue("v2"), 3000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  // File 3 contains transactional record committed after the global limit, but its intent was
+  // written before the global limit.
+  std::string value;
+  value.push_back(ValueTypeAsChar::kHybridTime);
+  DocHybridTime(1500_usec_ht, 0).AppendEncodedInDocDbFormat(&value);
+  value += PrimitiveValue("v3").ToValue();
+  ASSERT_OK(rocksdb()->Put(
+      rocksdb::WriteOptions(),
+      SubDocKey(doc_key, PrimitiveValue("s3"), 3000_usec_ht).Encode().AsSlice(), value));
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_EQ(3, NumSSTableFiles());
+
+  auto read_time = ReadHybridTime::SingleTime(2000_usec_ht);
+  read_time.local_limit = read_time.global_limit = 2500_usec_ht;
+  auto read_and_count_iterators = [this, &doc_key, &read_time] {
+    auto iterators_before =
+        options().statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS);
+    const auto encoded_subdoc_key = SubDocKey(doc_key).EncodeWithoutHt();
+    SubDocument doc_from_rocksdb;
+    bool subdoc_found_in_rocksdb = false;
+    GetSubDocumentData data = { encoded_subdoc_key, &doc_from_rocksdb, &subdoc_found_in_rocksdb };
+    EXPECT_OK(GetSubDocument(
+        doc_db(), data, rocksdb::kDefaultQueryId,
+        kNonTransactionalOperationContext, CoarseTimePoint::max() /* deadline */, read_time));
+    EXPECT_TRUE(subdoc_found_in_rocksdb);
+    EXPECT_STR_EQ_VERBOSE_TRIMMED(R"#(
+{
+  "s1": "v1"
+}
+        )#", doc_from_rocksdb.ToString());
+    return options().statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS) -
+           iterators_before;
+  };
+
+  // Only file 2 is skipped.
+  ASSERT_EQ(2, read_and_count_iterators());
+
+  FLAGS_use_read_time_file_filter = false;
+  ASSERT_EQ(3, read_and_count_iterators());
+}
+
+namespace {
+
+// Keeps the whole history, except for the first retention directive that removes history before
+// 1 second.
+class FirstCallRemovesHistoryRetentionPolicy : public HistoryRetentionPolicy {
+ public:
+  HistoryRetentionDirective GetRetentionDirective() override {
+    auto history_cutoff = num_calls_.fetch_add(1) == 0 ? 1000000_usec_ht : HybridTime::kMin;
+    return {history_cutoff, std::make_shared<ColumnIds>(), MonoDelta::kMax};
+  }
+
+  int num_calls() const {
+    return num_calls_.load();
+  }
+
+ private:
+  std::atomic<int> num_calls_{0};
+};
+
+} // namespace
+
+// All subcompactions of the same compaction should use the same history cutoff.
+TEST_F(DocDBTest, SubcompactionsShareRetentionDirective) {
+  constexpr int kNumDocs = 1000;
+  constexpr int kNumFiles = 4;
+
+  FLAGS_rocksdb_max_subcompactions = 4;
+  FLAGS_rocksdb_compaction_size_threshold_bytes = 1;
+  FLAGS_db_block_size_bytes = 1_KB;
+  ASSERT_OK(ReinitDBOptions());
+  auto retention_policy = std::make_shared<FirstCallRemovesHistoryRetentionPolicy>();
+  rocksdb_options_.compaction_filter_factory = std::make_shared<DocDBCompactionFilterFactory>(
+      retention_policy, &KeyBounds::kNoBounds);
+  rocksdb_options_.disable_auto_compactions = true;
+  ASSERT_OK(ReopenRocksDB());
+
+  // Each file contains a new version of every document, so all of them cover the whole key range.
+  for (int i = 1; i <= kNumFiles; ++i) {
+    for (int doc = 0; doc != kNumDocs; ++doc) {
+      const DocKey doc_key(PrimitiveValues(Format("doc_$0", doc)));
+      ASSERT_OK(SetPrimitive(
+          DocPath(doc_key.Encode(), PrimitiveValue("c")), PrimitiveValue(Format("v$0", i)),
+          HybridTime::FromMicros(i * 1000)));
+    }
+    ASSERT_OK(FlushRocksDbAndWait());
+  }
+  ASSERT_EQ(kNumFiles, NumSSTableFiles());
+
+  ASSERT_OK(FullyCompactDB(rocksdb()));
+
+  // Compaction was split into subcompactions, and all of them removed the history.
+  ASSERT_GT(NumSSTableFiles(), 1);
+  ASSERT_EQ(retention_policy->num_calls(), 1);
+  rocksdb::ReadOptions read_opts;
+  unique_ptr<rocksdb::Iterator> iter(rocksdb()->NewIterator(read_opts));
+  int num_records = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ++num_records;
+  }
+  ASSERT_EQ(num_records, kNumDocs);
+}
+
 TEST_F(DocDBTest, MinorCompactionNoDeletions) {
   ASSERT_OK(DisableCompactions());
   const DocKey doc_key(PrimitiveValues("k"));
@@ -2543,6 +2720,104 @@ TEST_F(DocDBTest, BloomFilterTest) {
   ASSERT_NO_FATALS(CheckBloom(2, &total_bloom_useful, 2, &total_table_iterators));
 }
 
+TEST_F(DocDBTest, RangeFilter) {
+  FLAGS_docdb_range_filter_max_prefix_bytes = 4;
+  FLAGS_docdb_range_filter_max_entries = 4;
+  DocRangeFilterCollectorFactory factory;
+  std::unique_ptr<rocksdb::TablePropertiesCollector> collector(
+      factory.CreateTablePropertiesCollector(rocksdb::TablePropertiesCollectorFactory::Context()));
+  for (const auto* key : {"aaaa1", "aaaa2", "aaab", "bbbb", "cc", "dddd"}) {
+    ASSERT_OK(collector->AddUserKey(key, "", rocksdb::kEntryPut, 0, 0));
+  }
+  rocksdb::UserCollectedProperties properties;
+  ASSERT_OK(collector->Finish(&properties));
+  const auto& filter = properties[kDocRangeFilterPropertyName];
+  // 5 distinct prefixes do not fit into the limit, so prefixes are shortened to 3 bytes.
+  ASSERT_EQ(1 + 4 * 4, filter.size());
+  ASSERT_EQ(3, filter[0]);
+
+  ASSERT_TRUE(DocRangeFilterMayMatch(filter, "", ""));
+  ASSERT_TRUE(DocRangeFilterMayMatch(filter, "aaaa", "aaab"));
+  ASSERT_TRUE(DocRangeFilterMayMatch(filter, "b", "c"));
+  ASSERT_TRUE(DocRangeFilterMayMatch(filter, "ca", "cc"));
+  ASSERT_TRUE(DocRangeFilterMayMatch(filter, "dd", ""));
+  ASSERT_TRUE(DocRangeFilterMayMatch(filter, "", "a"));
+  ASSERT_FALSE(DocRangeFilterMayMatch(filter, "ab", "ba"));
+  ASSERT_FALSE(DocRangeFilterMayMatch(filter, "bbc", "cb"));
+  ASSERT_FALSE(DocRangeFilterMayMatch(filter, "e", ""));
+  ASSERT_FALSE(DocRangeFilterMayMatch(filter, "cd", "dc"));
+}
+
+TEST_F(DocDBTest, RangeFilterOnlyForRegularDB) {
+  const DocKey doc_key(PrimitiveValues("k1"));
+  KeyBytes encoded_doc_key(doc_key.Encode());
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("s1")),
+      PrimitiveValue("v1"), 1000_usec_ht));
+  Result<TransactionId> txn = FullyDecodeTransactionId("0000000000000001");
+  ASSERT_OK(txn);
+  SetTransactionIsolationLevel(IsolationLevel::SNAPSHOT_ISOLATION);
+  SetCurrentTransactionId(*txn);
+  ASSERT_OK(SetPrimitive(DocPath(encoded_doc_key, PrimitiveValue("s2")),
+      PrimitiveValue("v2"), 2000_usec_ht));
+  ResetCurrentTransactionId();
+
+  rocksdb::FlushOptions flush_options;
+  flush_options.wait = true;
+  for (auto* db : {rocksdb(), intents_db()}) {
+    ASSERT_OK(db->Flush(flush_options));
+    rocksdb::TablePropertiesCollection props;
+    ASSERT_OK(db->GetPropertiesOfAllTables(&props));
+    ASSERT_EQ(1, props.size());
+    const auto& user_properties = props.begin()->second->user_collected_properties;
+    ASSERT_EQ(db == rocksdb(), user_properties.count(kDocRangeFilterPropertyName) != 0);
+  }
+}
+
+TEST_F(DocDBTest, RangeFilterSkipsFiles) {
+  constexpr int kNumFiles = 100;
+  constexpr int kNumSeeks = 1000;
+  ASSERT_OK(DisableCompactions());
+
+  // Each file contains keys at both ends of the key space, so neither boundary values nor bloom
+  // filters could exclude it from scan of the keys in the middle.
+  for (int i = 0; i != kNumFiles; ++i) {
+    for (const auto* prefix : {"a", "z"}) {
+      ASSERT_OK(SetPrimitive(
+          DocPath(DocKey(PrimitiveValues(Format("$0$1", prefix, i))).Encode(),
+                  PrimitiveValue("s")),
+          PrimitiveValue("v"), HybridTime::FromMicros(1000 + i)));
+    }
+    ASSERT_OK(FlushRocksDbAndWait());
+  }
+  ASSERT_EQ(kNumFiles, NumSSTableFiles());
+
+  const auto lower = DocKey(PrimitiveValues("m")).Encode();
+  const auto upper = DocKey(PrimitiveValues("n")).Encode();
+  auto scan = [this, &lower, &upper](bool use_range_filter) {
+    auto iterators_before =
+        options().statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS);
+    auto start = MonoTime::Now();
+    for (int i = 0; i != kNumSeeks; ++i) {
+      auto iter = CreateRocksDBIterator(
+          rocksdb(), &KeyBounds::kNoBounds, BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none,
+          rocksdb::kDefaultQueryId, nullptr /* file_filter */, nullptr /* iterate_upper_bound */,
+          use_range_filter ? CreateDocRangeFileFilter(lower.AsSlice(), upper.AsSlice())
+                           : nullptr);
+      iter.Seek(lower.AsSlice());
+      EXPECT_TRUE(!iter.Valid() || iter.key().compare(upper.AsSlice()) >= 0);
+    }
+    auto iterators =
+        options().statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS) - iterators_before;
+    LOG(INFO) << kNumSeeks << " seeks to empty range " << (use_range_filter ? "with" : "without")
+              << " range filter over " << kNumFiles << " files took " << MonoTime::Now() - start
+              << ", opened " << iterators << " file iterators";
+    return iterators;
+  };
+
+  ASSERT_EQ(kNumFiles * kNumSeeks, scan(false));
+  ASSERT_EQ(0, scan(true));
+}
+
 TEST_F(DocDBTest, MergingIterator) {
   // Test for the case described in https://yugabyte.atlassian.net/browse/ENG-1677.
 
@@ -3256,6 +3531,48 @@ TEST_F(DocDBTest, ForceFlushedFrontier) {
   ASSERT_EQ(*new_user_frontier_ptr, *rocksdb_->GetFlushedFrontier());
 }
 
+// Flushes and compactions of tablets in the same data directory share a rate limiter, when
+// rocksdb_compact_flush_rate_limit_per_data_dir is set.
+TEST_F(DocDBTest, DataDirRateLimiter) {
+  tablet::TabletOptions tablet_options;
+  auto rate_limiter = [&tablet_options](const std::string& data_root_dir) {
+    rocksdb::Options options;
+    docdb::InitRocksDBOptions(
+        &options, "" /* log_prefix */, nullptr /* statistics */, tablet_options, data_root_dir);
+    return options.rate_limiter;
+  };
+
+  const std::string kDataDir1 = "/DataDirRateLimiter/data1";
+  const std::string kDataDir2 = "/DataDirRateLimiter/data2";
+
+  FLAGS_rocksdb_compact_flush_rate_limit_per_data_dir = false;
+  auto own_limiter1 = rate_limiter(kDataDir1);
+  auto own_limiter2 = rate_limiter(kDataDir1);
+  ASSERT_NE(own_limiter1, nullptr);
+  ASSERT_NE(own_limiter1, own_limiter2);
+  ASSERT_EQ(docdb::GetDataDirRateLimiters().count(kDataDir1), 0);
+
+  FLAGS_rocksdb_compact_flush_rate_limit_per_data_dir = true;
+  auto dir1_limiter1 = rate_limiter(kDataDir1);
+  auto dir1_limiter2 = rate_limiter(kDataDir1);
+  auto dir2_limiter = rate_limiter(kDataDir2);
+  ASSERT_NE(dir1_limiter1, nullptr);
+  ASSERT_EQ(dir1_limiter1, dir1_limiter2);
+  ASSERT_NE(dir1_limiter1, dir2_limiter);
+  ASSERT_NE(dir1_limiter1, own_limiter1);
+
+  auto limiters = docdb::GetDataDirRateLimiters();
+  ASSERT_EQ(limiters[kDataDir1], dir1_limiter1);
+  ASSERT_EQ(limiters[kDataDir2], dir2_limiter);
+
+  // Writes of both tablets are accounted in the same budget.
+  const int64_t kBytes = 1_KB;
+  dir1_limiter1->Request(kBytes, rocksdb::Env::IO_LOW);
+  dir1_limiter2->Request(kBytes, rocksdb::Env::IO_LOW);
+  ASSERT_EQ(dir1_limiter1->GetTotalBytesThrough(), 2 * kBytes);
+  ASSERT_EQ(dir2_limiter->GetTotalBytesThrough(), 0);
+}
+
 // Handy code to analyze some DB.
 TEST_F(DocDBTest, DISABLED_DumpDB) {
   tablet::TabletOptions tablet_options;
@@ -3292,5 +3609,81 @@ TEST_F(DocDBTest, DISABLED_DumpDB) {
   LOG(INFO) << "TXN meta: " << txn_meta << ", rev key: " << rev_key << ", intents: " << intent;
 }
 
+// Sorted point lookups through a shared iterator, as HMGET and IN-list scans do, mostly seek
+// within the data block where the iterator is already positioned. Compares their results with
+// lookups through a separate iterator per key.
+TEST_F(DocDBTest, SortedLookupsThroughSharedIterator) {
+  constexpr int kNumRows = 20000;
+  constexpr int kNumLookups = 2000;
+  constexpr int kHash = 1;
+
+  auto make_key = [](int i) {
+    return DocKey(kHash, {PrimitiveValue::Int32(kHash)}, {PrimitiveValue::Int32(i)}).Encode();
+  };
+  for (int i = 0; i != kNumRows; ++i) {
+    // Even keys only, so lookups of odd keys are misses.
+    ASSERT_OK(SetPrimitive(DocPath(make_key(i * 2), PrimitiveValue("v")),
+                           Value(PrimitiveValue(static_cast<int64_t>(i))), 1000_usec_ht));
+  }
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  std::vector<int> key_indexes;
+  for (int i = 0; i != kNumLookups; ++i) {
+    key_indexes.push_back(RandomUniformInt(0, kNumRows * 2 - 1));
+  }
+  // Duplicate keys are looked up again through the same iterator.
+  key_indexes.push_back(key_indexes.front());
+  std::sort(key_indexes.begin(), key_indexes.end());
+  std::vector<KeyBytes> keys;
+  for (auto index : key_indexes) {
+    keys.push_back(make_key(index));
+  }
+
+  auto read = [this, &keys](bool shared_iterator, std::vector<SubDocument>* docs,
+                            std::vector<bool>* found) {
+    docs->clear();
+    docs->resize(keys.size());
+    std::unique_ptr<bool[]> found_flags(new bool[keys.size()]);
+    auto start = MonoTime::Now();
+    std::unique_ptr<IntentAwareIterator> iter;
+    for (size_t i = 0; i != keys.size(); ++i) {
+      GetSubDocumentData data(keys[i].AsSlice(), &(*docs)[i], &found_flags[i]);
+      if (shared_iterator) {
+        if (!iter) {
+          iter = CreateIntentAwareIterator(
+              doc_db(), BloomFilterMode::USE_BLOOM_FILTER, keys[i].AsSlice(),
+              rocksdb::kDefaultQueryId, kNonTransactionalOperationContext,
+              CoarseTimePoint::max() /* deadline */, ReadHybridTime::Max());
+        }
+        RETURN_NOT_OK(GetSubDocument(
+            iter.get(), data, nullptr /* projection */, SeekFwdSuffices::kFalse));
+      } else {
+        RETURN_NOT_OK(GetSubDocument(
+            doc_db(), data, rocksdb::kDefaultQueryId, kNonTransactionalOperationContext,
+            CoarseTimePoint::max() /* deadline */));
+      }
+    }
+    LOG(INFO) << (shared_iterator ? "Shared" : "Separate") << " iterator lookups of "
+              << keys.size() << " keys took " << MonoTime::Now() - start;
+    found->assign(found_flags.get(), found_flags.get() + keys.size());
+    return Status::OK();
+  };
+
+  std::vector<SubDocument> expected_docs, docs;
+  std::vector<bool> expected_found, found;
+  ASSERT_OK(read(false, &expected_docs, &expected_found));
+  ASSERT_OK(read(true, &docs, &found));
+  int num_found = 0;
+  for (size_t i = 0; i != keys.size(); ++i) {
+    ASSERT_EQ(expected_found[i], found[i]) << "Key: " << keys[i].ToString();
+    if (found[i]) {
+      ++num_found;
+      ASSERT_EQ(expected_docs[i].ToString(), docs[i].ToString()) << "Key: " << keys[i].ToString();
+    }
+  }
+  LOG(INFO) << "Found: " << num_found;
+  ASSERT_GT(num_found, 0);
+}
+
 }  // namespace docdb
 }  // namespace yb
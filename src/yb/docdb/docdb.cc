@@ -34,6 +34,7 @@
 #include "yb/docdb/docdb_util.h"
 #include "yb/docdb/intent.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/shared_lock_manager.h"
 #include "yb/docdb/subdocument.h"
@@ -942,6 +943,93 @@ CHECKED_STATUS BuildSubDocument(
   return Status::OK();
 }
 
+// Finds the packed row of the document that is not overwritten at max_overwrite_ht. On success
+// packed_row refers to the memory of packed_row_value and packed_row_ht is the time it was written.
+// packed_row_ht is left unchanged when the row does not have such packed row.
+CHECKED_STATUS ReadPackedRow(
+    IntentAwareIterator* iter, const Slice& key_without_ht, DocHybridTime max_overwrite_ht,
+    std::string* packed_row_value, PackedRow* packed_row, DocHybridTime* packed_row_ht) {
+  DocHybridTime write_time = max_overwrite_ht;
+  Slice value;
+  RETURN_NOT_OK(iter->FindLatestRecord(key_without_ht, &write_time, &value));
+  if (write_time == max_overwrite_ht) {
+    return Status::OK();
+  }
+  Value doc_value;
+  RETURN_NOT_OK(doc_value.Decode(value));
+  if (doc_value.value_type() != ValueType::kPackedRow) {
+    return Status::OK();
+  }
+  *packed_row_value = doc_value.primitive_value().GetPackedRow();
+  RETURN_NOT_OK(packed_row->Decode(*packed_row_value));
+  *packed_row_ht = write_time;
+  return Status::OK();
+}
+
+// Builds value of the column from its packed row value, the same way BuildSubDocument does for
+// a column level entry.
+CHECKED_STATUS BuildPackedColumn(
+    const Slice& packed_value, DocHybridTime packed_row_ht, const GetSubDocumentData& data,
+    const ReadHybridTime& read_time, SubDocument* result) {
+  Value doc_value;
+  RETURN_NOT_OK(doc_value.Decode(packed_value));
+  if (doc_value.value_type() == ValueType::kTombstone) {
+    return Status::OK();
+  }
+  if (!IsPrimitiveValueType(doc_value.value_type())) {
+    return STATUS_FORMAT(Corruption,
+        "Expected primitive value type in packed row, got $0", doc_value.value_type());
+  }
+
+  // Packed row is written without ttl, so only the table level ttl applies to it.
+  const HybridTime write_ht = packed_row_ht.hybrid_time();
+  const MonoDelta ttl = data.exp.ttl.IsNegative() ? -data.exp.ttl : data.exp.ttl;
+  bool has_expired;
+  RETURN_NOT_OK(HasExpiredTTL(write_ht, ttl, read_time.read, &has_expired));
+  if (has_expired) {
+    return Status::OK();
+  }
+  if (ttl == Value::kMaxTtl) {
+    doc_value.mutable_primitive_value()->SetTtl(-1);
+  } else {
+    int64_t time_since_write_seconds = (
+        server::HybridClock::GetPhysicalValueMicros(read_time.read) -
+        server::HybridClock::GetPhysicalValueMicros(write_ht)) /
+        MonoTime::kMicrosecondsPerSecond;
+    int64_t ttl_seconds = std::max(static_cast<int64_t>(0),
+        ttl.ToMilliseconds() / MonoTime::kMillisecondsPerSecond - time_since_write_seconds);
+    doc_value.mutable_primitive_value()->SetTtl(ttl_seconds);
+  }
+  doc_value.mutable_primitive_value()->SetWriteTime(write_ht.GetPhysicalValueMicros());
+  *result = SubDocument(doc_value.primitive_value());
+  return Status::OK();
+}
+
+// Checks whether the document has entries for the subkey, when iterator is positioned at the first
+// entry after the previously read subkey of the same document. So subkeys without entries are
+// skipped without a seek. Iterator is moved forward only when it points before the subkey.
+Result<bool> SubKeyHasEntries(
+    IntentAwareIterator* iter, const KeyBytes& subkey, size_t subdocument_key_size) {
+  const Slice subdocument_key(subkey.data().data(), subdocument_key_size);
+  for (;;) {
+    if (!iter->valid()) {
+      return false;
+    }
+    auto key = VERIFY_RESULT(iter->FetchKey()).key;
+    if (!key.starts_with(subdocument_key)) {
+      return false;
+    }
+    if (key.starts_with(subkey.AsSlice())) {
+      return true;
+    }
+    if (key.compare(subkey.AsSlice()) > 0) {
+      return false;
+    }
+    // Entries of subkeys that are not projected, skip them.
+    iter->SeekForward(subkey.AsSlice());
+  }
+}
+
 }  // namespace
 
 yb::Status FindLastWriteTime(
@@ -1134,19 +1222,64 @@ yb::Status GetSubDocument(
   key_bytes.Reserve(data.subdocument_key.size() + kMaxBytesPerEncodedHybridTime + 32);
   key_bytes.AppendRawBytes(data.subdocument_key);
   const size_t subdocument_key_size = key_bytes.size();
+  // Packed row of the document, it precedes column subkeys in the projection.
+  std::string packed_row_value;
+  PackedRow packed_row;
+  DocHybridTime packed_row_ht = DocHybridTime::kMin;
+  // Whether iterator is already positioned at the first entry after the previous subkey, so
+  // columns that are stored only in the packed row could be read without a seek.
+  bool iter_after_previous_subkey = false;
   for (const PrimitiveValue& subkey : *projection) {
     // Append subkey to subdocument key. Reserve extra kMaxBytesPerEncodedHybridTime + 1 bytes in
     // key_bytes to avoid the internal buffer from getting reallocated and moved by SeekForward()
     // appending the hybrid time, thereby invalidating the buffer pointer saved by prefix_scope.
     subkey.AppendToKey(&key_bytes);
     key_bytes.Reserve(key_bytes.size() + kMaxBytesPerEncodedHybridTime + 1);
-    // This seek is to initialize the iterator for BuildSubDocument call.
+    SubDocument descendant(ValueType::kInvalid);
+    const Slice* packed_value = packed_row_ht != DocHybridTime::kMin &&
+                                subkey.value_type() == ValueType::kColumnId
+        ? packed_row.GetValue(subkey.GetColumnId()) : nullptr;
+    if (packed_value && iter_after_previous_subkey &&
+        !VERIFY_RESULT(SubKeyHasEntries(db_iter, key_bytes, subdocument_key_size))) {
+      // Column does not have column level entries, so its value is taken from the packed row.
+      RETURN_NOT_OK(BuildPackedColumn(
+          *packed_value, packed_row_ht, data, db_iter->read_time(), &descendant));
+      *data.doc_found = descendant.value_type() != ValueType::kInvalid;
+      data.result->SetChild(subkey, std::move(descendant));
+      key_bytes.Truncate(subdocument_key_size);
+      continue;
+    }
+    iter_after_previous_subkey = false;
     IntentAwareIteratorPrefixScope prefix_scope(key_bytes, db_iter);
+    // This seek is to initialize the iterator for BuildSubDocument call.
     db_iter->SeekForward(&key_bytes);
-    SubDocument descendant(ValueType::kInvalid);
+    if (subkey == PrimitiveValue::SystemColumnId(SystemColumnIds::kPackedRowColumn)) {
+      RETURN_NOT_OK(ReadPackedRow(
+          db_iter, key_bytes, max_overwrite_ht, &packed_row_value, &packed_row, &packed_row_ht));
+      db_iter->SeekPastSubKey(key_bytes);
+      iter_after_previous_subkey = true;
+      key_bytes.Truncate(subdocument_key_size);
+      continue;
+    }
+    DocHybridTime low_ts = max_overwrite_ht;
+    if (packed_value) {
+      // Column level entries written before the packed row are overwritten by it.
+      DocHybridTime column_ht = packed_row_ht;
+      RETURN_NOT_OK(db_iter->FindLatestRecord(key_bytes, &column_ht));
+      if (column_ht == packed_row_ht) {
+        RETURN_NOT_OK(BuildPackedColumn(
+            *packed_value, packed_row_ht, data, db_iter->read_time(), &descendant));
+        *data.doc_found = descendant.value_type() != ValueType::kInvalid;
+        data.result->SetChild(subkey, std::move(descendant));
+        key_bytes.Truncate(subdocument_key_size);
+        continue;
+      }
+      low_ts = packed_row_ht;
+      db_iter->SeekForward(&key_bytes);
+    }
     int64 num_values_observed = 0;
     RETURN_NOT_OK(BuildSubDocument(
-        db_iter, data.Adjusted(key_bytes, &descendant), max_overwrite_ht,
+        db_iter, data.Adjusted(key_bytes, &descendant), low_ts,
         &num_values_observed));
     *data.doc_found = descendant.value_type() != ValueType::kInvalid;
     data.result->SetChild(subkey, std::move(descendant));
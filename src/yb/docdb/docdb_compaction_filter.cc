@@ -13,16 +13,19 @@
 
 #include "yb/docdb/docdb_compaction_filter.h"
 
+#include <algorithm>
 #include <memory>
 
 #include <glog/logging.h>
 
 #include "yb/rocksdb/compaction_filter.h"
+#include "yb/rocksdb/db/version_edit.h"
 #include "yb/util/string_util.h"
 
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/docdb-internal.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/value.h"
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/rocksutil/yb_rocksdb.h"
@@ -37,6 +40,10 @@ using rocksdb::FilterDecision;
 namespace yb {
 namespace docdb {
 
+CHECKED_STATUS GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime* out);
+HybridTime GetMaxExpiration(const rocksdb::UserBoundaryValues& largest, MonoDelta table_ttl);
+bool HasMergeRecords(const rocksdb::UserBoundaryValues& largest);
+
 // ------------------------------------------------------------------------------------------------
 
 DocDBCompactionFilter::DocDBCompactionFilter(
@@ -129,8 +136,15 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
   // k1 col2 T9   Truncating the stack to [T10], setting prev_overwrite_ht to 10, and therefore
   //              deciding to remove this entry because 9 < 10.
   //
-  const DocHybridTime prev_overwrite_ht =
+  DocHybridTime prev_overwrite_ht =
       overwrite_.empty() ? DocHybridTime::kMin : overwrite_.back().doc_ht;
+
+  // Column level entries of a row are fully overwritten by the packed row of that row, that is
+  // visible at history cutoff and lists the column.
+  const bool covered_by_packed_row = VERIFY_RESULT(IsCoveredByPackedRow(key));
+  if (covered_by_packed_row && overwrite_.size() == 1) {
+    prev_overwrite_ht = max(prev_overwrite_ht, packed_row_ht_);
+  }
   const Expiration prev_exp =
       overwrite_.empty() ? Expiration() : overwrite_.back().expiration;
 
@@ -209,6 +223,16 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
   RETURN_NOT_OK(Value::DecodePrimitiveValueType(existing_value, &value_type, nullptr, &ttl));
   const Expiration curr_exp(ht.hybrid_time(), ttl);
 
+  // Versions of the packed row key are processed from the latest one, so the first one at or below
+  // history cutoff is the packed row that is visible at history cutoff.
+  if (new_stack_size == 2 && Slice(key.data(), sub_key_ends_[0]) != Slice(packed_row_doc_key_)) {
+    ColumnId column_id;
+    if (VERIFY_RESULT(DecodeFirstColumnId(key, ValueType::kSystemColumnId, &column_id)) &&
+        column_id.rep() == static_cast<ColumnIdRep>(SystemColumnIds::kPackedRowColumn)) {
+      RETURN_NOT_OK(AssignPackedRow(key, ht, value_type, existing_value));
+    }
+  }
+
   // If within the merge block.
   //     If the row is a TTL row, delete it.
   //     Otherwise, replace it with the cached TTL (i.e., apply merge).
@@ -256,12 +280,13 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
   if (has_expired) {
     // This is consistent with the condition we're testing for deletes at the bottom of the function
     // because ht_at_or_below_cutoff is implied by has_expired.
-    if (is_major_compaction_) {
+    if (is_major_compaction_ && !covered_by_packed_row) {
       return FilterDecision::kDiscard;
     }
 
     // During minor compactions, expired values are written back as tombstones because removing the
-    // record might expose earlier values which would be incorrect.
+    // record might expose earlier values which would be incorrect. The same applies to values that
+    // overwrite packed row, since removing them would expose the packed value.
     *value_changed = true;
     *new_value = Value::EncodedTombstone();
   } else if (within_merge_block_) {
@@ -287,9 +312,52 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
   // Tombstones at or below the history cutoff hybrid_time can always be cleaned up on full (major)
   // compactions. However, we do need to update the overwrite hybrid time stack in this case (as we
   // just did), because this deletion (tombstone) entry might be the only reason for cleaning up
-  // more entries appearing at earlier hybrid times.
-  return value_type == ValueType::kTombstone && is_major_compaction_ ? FilterDecision::kDiscard
-                                                                     : FilterDecision::kKeep;
+  // more entries appearing at earlier hybrid times. Tombstones of columns stored in the packed row
+  // are kept while the packed row exists.
+  return value_type == ValueType::kTombstone && is_major_compaction_ && !covered_by_packed_row
+      ? FilterDecision::kDiscard : FilterDecision::kKeep;
+}
+
+Result<bool> DocDBCompactionFilter::DecodeFirstColumnId(
+    const Slice& key, ValueType column_value_type, ColumnId* column_id) const {
+  if (sub_key_ends_.size() < 2 ||
+      static_cast<ValueType>(key[sub_key_ends_[0]]) != column_value_type) {
+    return false;
+  }
+  Slice column_id_slice(key.data() + sub_key_ends_[0] + 1, key.data() + sub_key_ends_[1]);
+  auto column_id_as_int64 = VERIFY_RESULT(util::FastDecodeSignedVarInt(&column_id_slice));
+  RETURN_NOT_OK(ColumnId::FromInt64(column_id_as_int64, column_id));
+  return true;
+}
+
+Result<bool> DocDBCompactionFilter::IsCoveredByPackedRow(const Slice& key) const {
+  if (packed_row_columns_.empty() ||
+      Slice(key.data(), sub_key_ends_[0]) != Slice(packed_row_doc_key_)) {
+    return false;
+  }
+  ColumnId column_id;
+  if (!VERIFY_RESULT(DecodeFirstColumnId(key, ValueType::kColumnId, &column_id))) {
+    return false;
+  }
+  return std::binary_search(packed_row_columns_.begin(), packed_row_columns_.end(), column_id);
+}
+
+Status DocDBCompactionFilter::AssignPackedRow(
+    const Slice& key, DocHybridTime ht, ValueType value_type, const Slice& existing_value) {
+  packed_row_doc_key_.assign(key.cdata(), sub_key_ends_[0]);
+  packed_row_ht_ = ht;
+  packed_row_columns_.clear();
+  if (value_type != ValueType::kPackedRow) {
+    return Status::OK();
+  }
+  Value value;
+  RETURN_NOT_OK(value.Decode(existing_value));
+  PackedRow packed_row;
+  RETURN_NOT_OK(packed_row.Decode(value.primitive_value().GetPackedRow()));
+  for (size_t i = 0; i != packed_row.num_columns(); ++i) {
+    packed_row_columns_.push_back(packed_row.column_id(i));
+  }
+  return Status::OK();
 }
 
 void DocDBCompactionFilter::AssignPrevSubDocKey(
@@ -306,6 +374,65 @@ rocksdb::UserFrontierPtr DocDBCompactionFilter::GetLargestUserFrontier() const {
   return rocksdb::UserFrontierPtr(consensus_frontier);
 }
 
+std::vector<rocksdb::FileMetaData*> DocDBCompactionFilter::FilesToDrop(
+    const std::vector<rocksdb::FileMetaData*>& inputs) {
+  if (!is_major_compaction_ || !retention_.history_cutoff.is_valid()) {
+    return {};
+  }
+
+  struct FileInfo {
+    rocksdb::FileMetaData* file;
+    HybridTime min_write_time;
+    HybridTime max_write_time;
+    bool expired;
+  };
+  std::vector<FileInfo> infos;
+  infos.reserve(inputs.size());
+  for (auto* file : inputs) {
+    // Merge records extend TTL of the earlier records, so dropping files by their own expiration
+    // is not safe when there are any.
+    if (HasMergeRecords(file->largest.user_values)) {
+      return {};
+    }
+    DocHybridTime smallest, largest;
+    if (!GetDocHybridTime(file->smallest.user_values, &smallest).ok() ||
+        !GetDocHybridTime(file->largest.user_values, &largest).ok()) {
+      return {};
+    }
+    auto max_expiration = GetMaxExpiration(file->largest.user_values, retention_.table_ttl);
+    infos.push_back(FileInfo {
+      .file = file,
+      .min_write_time = smallest.hybrid_time(),
+      .max_write_time = largest.hybrid_time(),
+      .expired = max_expiration < retention_.history_cutoff,
+    });
+  }
+
+  std::sort(infos.begin(), infos.end(), [](const FileInfo& lhs, const FileInfo& rhs) {
+    return lhs.max_write_time < rhs.max_write_time;
+  });
+
+  // Expired record acts as a deletion of the earlier records of the same key, so a file could be
+  // dropped only together with all files containing older records.
+  std::vector<HybridTime> suffix_min_write_time(infos.size() + 1, HybridTime::kMax);
+  for (size_t i = infos.size(); i-- > 0;) {
+    suffix_min_write_time[i] = std::min(suffix_min_write_time[i + 1], infos[i].min_write_time);
+  }
+  size_t num_dropped = 0;
+  for (size_t i = 0; i != infos.size() && infos[i].expired; ++i) {
+    if (infos[i].max_write_time < suffix_min_write_time[i + 1]) {
+      num_dropped = i + 1;
+    }
+  }
+
+  std::vector<rocksdb::FileMetaData*> result;
+  result.reserve(num_dropped);
+  for (size_t i = 0; i != num_dropped; ++i) {
+    result.push_back(infos[i].file);
+  }
+  return result;
+}
+
 const char* DocDBCompactionFilter::Name() const {
   return "DocDBCompactionFilter";
 }
@@ -328,10 +455,31 @@ unique_ptr<CompactionFilter> DocDBCompactionFilterFactory::CreateCompactionFilte
       key_bounds_);
 }
 
+std::vector<unique_ptr<CompactionFilter>> DocDBCompactionFilterFactory::CreateCompactionFilters(
+    const CompactionFilter::Context& context, size_t num_subcompactions) {
+  const auto retention = retention_policy_->GetRetentionDirective();
+  std::vector<unique_ptr<CompactionFilter>> result;
+  result.reserve(num_subcompactions);
+  for (size_t i = 0; i != num_subcompactions; ++i) {
+    result.push_back(std::make_unique<DocDBCompactionFilter>(
+        retention, IsMajorCompaction(context.is_full_compaction), key_bounds_));
+  }
+  return result;
+}
+
 const char* DocDBCompactionFilterFactory::Name() const {
   return "DocDBCompactionFilterFactory";
 }
 
+Slice DocDBCompactionFilterFactory::SubcompactionBoundary(const Slice& user_key) const {
+  auto doc_key_size = DocKey::EncodedSize(user_key, DocKeyPart::WHOLE_DOC_KEY);
+  if (!doc_key_size.ok()) {
+    // Keys sampled from the index could be shortened separators, that are not valid keys.
+    return Slice();
+  }
+  return Slice(user_key.data(), *doc_key_size);
+}
+
 // ------------------------------------------------------------------------------------------------
 
 HistoryRetentionDirective ManualHistoryRetentionPolicy::GetRetentionDirective() {
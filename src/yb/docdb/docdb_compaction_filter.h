@@ -77,6 +77,12 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
   // ConsensusFrontier, so that it can be persisted in RocksDB metadata and recovered on bootstrap.
   rocksdb::UserFrontierPtr GetLargestUserFrontier() const override;
 
+  // During major compactions, returns the oldest input files whose records all expired by the
+  // history cutoff, when all other input files contain only newer records. Records of such files
+  // would be discarded by Filter, and could not hide any record that is kept.
+  std::vector<rocksdb::FileMetaData*> FilesToDrop(
+      const std::vector<rocksdb::FileMetaData*>& inputs) override;
+
  private:
   // Assigns prev_subdoc_key_ from memory addressed by data. The length of key is taken from
   // sub_key_ends_ and same_bytes are reused.
@@ -87,6 +93,17 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
       int level, const Slice& key, const Slice& existing_value, std::string* new_value,
       bool* value_changed);
 
+  // Decodes the first subkey of the current key, when it is a column id of column_value_type.
+  Result<bool> DecodeFirstColumnId(
+      const Slice& key, ValueType column_value_type, ColumnId* column_id) const;
+
+  // Whether the current key belongs to a column that is stored in packed_row_columns_.
+  Result<bool> IsCoveredByPackedRow(const Slice& key) const;
+
+  // Remembers the packed row of the current key that is visible at history cutoff.
+  CHECKED_STATUS AssignPackedRow(
+      const Slice& key, DocHybridTime ht, ValueType value_type, const Slice& existing_value);
+
   const HistoryRetentionDirective retention_;
   const KeyBounds* key_bounds_;
   const IsMajorCompaction is_major_compaction_;
@@ -139,6 +156,12 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
 
   std::vector<OverwriteData> overwrite_;
 
+  // Packed row of the last processed row, that is visible at history cutoff. Column level entries
+  // written before packed_row_ht_ for the listed columns are overwritten by it.
+  std::string packed_row_doc_key_;
+  DocHybridTime packed_row_ht_;
+  std::vector<ColumnId> packed_row_columns_;
+
   // We use this to only log a message that the filter is being used once on the first call to
   // the Filter function.
   bool filter_usage_logged_ = false;
@@ -160,8 +183,16 @@ class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
   ~DocDBCompactionFilterFactory() override;
   std::unique_ptr<rocksdb::CompactionFilter> CreateCompactionFilter(
       const rocksdb::CompactionFilter::Context& context) override;
+  // Retention directive is taken once for all subcompactions, so all of them use the same history
+  // cutoff.
+  std::vector<std::unique_ptr<rocksdb::CompactionFilter>> CreateCompactionFilters(
+      const rocksdb::CompactionFilter::Context& context, size_t num_subcompactions) override;
   const char* Name() const override;
 
+  // DocDBCompactionFilter keeps state across all keys of the same document, so subcompactions are
+  // split at the document boundary.
+  Slice SubcompactionBoundary(const Slice& user_key) const override;
+
  private:
   std::shared_ptr<HistoryRetentionPolicy> retention_policy_;
   const KeyBounds* key_bounds_;
@@ -25,6 +25,7 @@ class IntentAwareIterator;
 class KeyValueWriteBatchPB;
 class QLWriteOperation;
 class PgsqlWriteOperation;
+class WaitQueue;
 
 struct DocDB;
 
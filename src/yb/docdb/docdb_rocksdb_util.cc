@@ -13,17 +13,22 @@
 
 #include "yb/docdb/docdb_rocksdb_util.h"
 
-#include <thread>
+#include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include "yb/common/transaction.h"
 
+#include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/rate_limiter.h"
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/util/compression.h"
 
 #include "yb/docdb/bounded_rocksdb_iterator.h"
+#include "yb/docdb/doc_range_filter.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/rocksutil/yb_rocksdb.h"
@@ -59,8 +64,17 @@ DEFINE_int32(rocksdb_universal_compaction_min_merge_width, 4,
              "The minimum number of files in a single compaction run.");
 DEFINE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec, 256_MB,
              "Use to control write rate of flush and compaction.");
+DEFINE_bool(rocksdb_compact_flush_rate_limit_per_data_dir, false,
+            "Whether rocksdb_compact_flush_rate_limit_bytes_per_sec limits the total write rate of "
+            "flushes and compactions of all tablets placed in the same data directory, instead of "
+            "the write rate of each tablet separately. A compaction that would wait for the "
+            "saturated limiter yields its thread to compactions of other directories.");
 DEFINE_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024,
              "Threshold beyond which compaction is considered large.");
+DEFINE_int32(rocksdb_max_subcompactions, 1,
+             "Maximal number of parallel subcompactions, that large compaction is split into. "
+             "Compaction is split only when each subcompaction gets at least "
+             "rocksdb_compaction_size_threshold_bytes / rocksdb_max_subcompactions bytes.");
 DEFINE_uint64(rocksdb_max_file_size_for_compaction, 0,
              "Maximal allowed file size to participate in RocksDB compaction. 0 - unlimited.");
 DEFINE_int32(rocksdb_max_write_buffer_number, 2,
@@ -86,6 +100,10 @@ DEFINE_int32(memstore_size_mb, 128,
 
 DEFINE_bool(use_docdb_aware_bloom_filter, true,
             "Whether to use the DocDbAwareFilterPolicy for both bloom storage and seeks.");
+DEFINE_bool(use_read_time_file_filter, true,
+            "Whether reads should skip SST files that contain only records written after the "
+            "read time.");
+DECLARE_bool(use_docdb_range_filter);
 DEFINE_int32(max_nexts_to_avoid_seek, 1,
              "The number of next calls to try before doing resorting to do a rocksdb seek.");
 DEFINE_bool(trace_docdb_calls, false, "Whether we should trace calls into the docdb.");
@@ -113,6 +131,7 @@ namespace yb {
 namespace docdb {
 
 std::shared_ptr<rocksdb::BoundaryValuesExtractor> DocBoundaryValuesExtractorInstance();
+HybridTime GetMinVisibleHybridTime(const rocksdb::LightweightBoundaries& smallest);
 
 void SeekForward(const rocksdb::Slice& slice, rocksdb::Iterator *iter) {
   if (!iter->Valid() || iter->key().compare(slice) >= 0) {
@@ -196,13 +215,34 @@ void PerformRocksDBSeek(
 
 namespace {
 
+// Skips files that contain only records which become visible after the global limit of the read
+// time. Such records are ignored by IntentAwareIterator, so they could not affect the read.
+class ReadTimeFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  ReadTimeFileFilter(HybridTime global_limit, std::shared_ptr<rocksdb::ReadFileFilter> next)
+      : global_limit_(global_limit), next_(std::move(next)) {}
+
+  bool Filter(const rocksdb::FdWithBoundaries& file) const override {
+    if (next_ && !next_->Filter(file)) {
+      return false;
+    }
+    auto min_visible_time = GetMinVisibleHybridTime(file.smallest);
+    return !min_visible_time.is_valid() || min_visible_time <= global_limit_;
+  }
+
+ private:
+  const HybridTime global_limit_;
+  const std::shared_ptr<rocksdb::ReadFileFilter> next_;
+};
+
 rocksdb::ReadOptions PrepareReadOptions(
     rocksdb::DB* rocksdb,
     BloomFilterMode bloom_filter_mode,
     const boost::optional<const Slice>& user_key_for_filter,
     const rocksdb::QueryId query_id,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter,
-    const Slice* iterate_upper_bound) {
+    const Slice* iterate_upper_bound,
+    std::shared_ptr<rocksdb::TableAwareReadFileFilter> range_filter) {
   rocksdb::ReadOptions read_opts;
   read_opts.query_id = query_id;
   if (FLAGS_use_docdb_aware_bloom_filter &&
@@ -210,6 +250,8 @@ rocksdb::ReadOptions PrepareReadOptions(
     DCHECK(user_key_for_filter);
     read_opts.table_aware_file_filter = rocksdb->GetOptions().table_factory->
         NewTableAwareReadFileFilter(read_opts, user_key_for_filter.get());
+  } else {
+    read_opts.table_aware_file_filter = std::move(range_filter);
   }
   read_opts.file_filter = std::move(file_filter);
   read_opts.iterate_upper_bound = iterate_upper_bound;
@@ -225,9 +267,11 @@ BoundedRocksDbIterator CreateRocksDBIterator(
     const boost::optional<const Slice>& user_key_for_filter,
     const rocksdb::QueryId query_id,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter,
-    const Slice* iterate_upper_bound) {
+    const Slice* iterate_upper_bound,
+    std::shared_ptr<rocksdb::TableAwareReadFileFilter> range_filter) {
   rocksdb::ReadOptions read_opts = PrepareReadOptions(rocksdb, bloom_filter_mode,
-      user_key_for_filter, query_id, std::move(file_filter), iterate_upper_bound);
+      user_key_for_filter, query_id, std::move(file_filter), iterate_upper_bound,
+      std::move(range_filter));
   return BoundedRocksDbIterator(rocksdb, read_opts, docdb_key_bounds);
 }
 
@@ -240,10 +284,17 @@ unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter,
-    const Slice* iterate_upper_bound) {
+    const Slice* iterate_upper_bound,
+    std::shared_ptr<rocksdb::TableAwareReadFileFilter> range_filter) {
+  if (FLAGS_use_read_time_file_filter && read_time.global_limit.is_valid() &&
+      read_time.global_limit != HybridTime::kMax) {
+    file_filter = std::make_shared<ReadTimeFileFilter>(
+        read_time.global_limit, std::move(file_filter));
+  }
   // TODO(dtxn) do we need separate options for intents db?
   rocksdb::ReadOptions read_opts = PrepareReadOptions(doc_db.regular, bloom_filter_mode,
-      user_key_for_filter, query_id, std::move(file_filter), iterate_upper_bound);
+      user_key_for_filter, query_id, std::move(file_filter), iterate_upper_bound,
+      std::move(range_filter));
   return std::make_unique<IntentAwareIterator>(
       doc_db, read_opts, deadline, read_time, txn_op_context);
 }
@@ -252,6 +303,21 @@ namespace {
 
 std::mutex rocksdb_flags_mutex;
 
+std::atomic<PriorityThreadPool*> priority_thread_pool_for_compactions_and_flushes_instance{nullptr};
+
+std::mutex data_dir_rate_limiters_mutex;
+std::map<std::string, std::shared_ptr<rocksdb::RateLimiter>> data_dir_rate_limiters;
+
+std::shared_ptr<rocksdb::RateLimiter> DataDirRateLimiter(const std::string& data_dir) {
+  std::lock_guard<std::mutex> lock(data_dir_rate_limiters_mutex);
+  auto& result = data_dir_rate_limiters[data_dir];
+  if (!result) {
+    result.reset(
+        rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec));
+  }
+  return result;
+}
+
 // Auto initialize some of the RocksDB flags that are defaulted to -1.
 void AutoInitRocksDBFlags(rocksdb::Options* options) {
   const int kNumCpus = base::NumCPUs();
@@ -309,10 +375,20 @@ void AutoInitRocksDBFlags(rocksdb::Options* options) {
 
 } // namespace
 
+PriorityThreadPool* GetPriorityThreadPoolForCompactionsAndFlushes() {
+  return priority_thread_pool_for_compactions_and_flushes_instance.load(std::memory_order_acquire);
+}
+
+std::map<std::string, std::shared_ptr<rocksdb::RateLimiter>> GetDataDirRateLimiters() {
+  std::lock_guard<std::mutex> lock(data_dir_rate_limiters_mutex);
+  return data_dir_rate_limiters;
+}
+
 void InitRocksDBOptions(
     rocksdb::Options* options, const string& log_prefix,
     const shared_ptr<rocksdb::Statistics>& statistics,
-    const tablet::TabletOptions& tablet_options) {
+    const tablet::TabletOptions& tablet_options,
+    const std::string& data_root_dir) {
   AutoInitRocksDBFlags(options);
   SetLogPrefix(options, log_prefix);
   options->create_if_missing = true;
@@ -333,6 +409,8 @@ void InitRocksDBOptions(
       FLAGS_priority_thread_pool_size);
   options->priority_thread_pool_for_compactions_and_flushes =
       &priority_thread_pool_for_compactions_and_flushes;
+  priority_thread_pool_for_compactions_and_flushes_instance.store(
+      &priority_thread_pool_for_compactions_and_flushes, std::memory_order_release);
 
   if (FLAGS_num_reserved_small_compaction_threads != -1) {
     options->num_reserved_small_compaction_threads = FLAGS_num_reserved_small_compaction_threads;
@@ -355,6 +433,7 @@ void InitRocksDBOptions(
     table_options.no_block_cache = true;
     table_options.cache_index_and_filter_blocks = false;
   }
+  table_options.readahead_thread_pool = tablet_options.readahead_thread_pool;
   table_options.block_size = FLAGS_db_block_size_bytes;
   table_options.filter_block_size = FLAGS_db_filter_block_size_bytes;
   table_options.index_block_size = FLAGS_db_index_block_size_bytes;
@@ -366,6 +445,12 @@ void InitRocksDBOptions(
         table_options.filter_block_size * 8, options->info_log.get()));
   }
 
+  // Removed from options of the intents DB, whose keys are not DocDB keys.
+  if (FLAGS_use_docdb_range_filter) {
+    options->table_properties_collector_factories.push_back(
+        std::make_shared<DocRangeFilterCollectorFactory>());
+  }
+
   if (FLAGS_use_multi_level_index) {
     table_options.index_type = rocksdb::IndexType::kMultiLevelBinarySearch;
   } else {
@@ -401,9 +486,14 @@ void InitRocksDBOptions(
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
+    options->max_subcompactions = std::max(FLAGS_rocksdb_max_subcompactions, 1);
     if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec > 0) {
-      options->rate_limiter.reset(
-          rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec));
+      if (FLAGS_rocksdb_compact_flush_rate_limit_per_data_dir && !data_root_dir.empty()) {
+        options->rate_limiter = DataDirRateLimiter(data_root_dir);
+      } else {
+        options->rate_limiter.reset(
+            rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec));
+      }
     }
   } else {
     options->level0_slowdown_writes_trigger = std::numeric_limits<int>::max();
@@ -14,6 +14,10 @@
 #ifndef YB_DOCDB_DOCDB_ROCKSDB_UTIL_H_
 #define YB_DOCDB_DOCDB_ROCKSDB_UTIL_H_
 
+#include <map>
+#include <memory>
+#include <string>
+
 #include <boost/optional.hpp>
 
 #include "yb/common/read_hybrid_time.h"
@@ -87,7 +91,8 @@ BoundedRocksDbIterator CreateRocksDBIterator(
     const boost::optional<const Slice>& user_key_for_filter,
     const rocksdb::QueryId query_id,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter = nullptr,
-    const Slice* iterate_upper_bound = nullptr);
+    const Slice* iterate_upper_bound = nullptr,
+    std::shared_ptr<rocksdb::TableAwareReadFileFilter> range_filter = nullptr);
 
 // Values and transactions committed later than high_ht can be skipped, so we won't spend time
 // for re-requesting pending transaction status if we already know it wasn't committed at high_ht.
@@ -100,15 +105,26 @@ std::unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter = nullptr,
-    const Slice* iterate_upper_bound = nullptr);
+    const Slice* iterate_upper_bound = nullptr,
+    std::shared_ptr<rocksdb::TableAwareReadFileFilter> range_filter = nullptr);
 
 // Initialize the RocksDB 'options'.
 // The 'statistics' object provided by the caller will be used by RocksDB to maintain the stats for
 // the tablet.
+// When 'data_root_dir' is specified and rocksdb_compact_flush_rate_limit_per_data_dir is set, write
+// rate of flushes and compactions is limited together with other tablets in this data directory.
 void InitRocksDBOptions(
     rocksdb::Options* options, const std::string& log_prefix,
     const std::shared_ptr<rocksdb::Statistics>& statistics,
-    const tablet::TabletOptions& tablet_options);
+    const tablet::TabletOptions& tablet_options,
+    const std::string& data_root_dir = std::string());
+
+// Returns thread pool used for flushes and compactions of all tablets, or nullptr when RocksDB
+// options were not initialized yet.
+PriorityThreadPool* GetPriorityThreadPoolForCompactionsAndFlushes();
+
+// Returns rate limiters of flushes and compactions shared by tablets, keyed by data directory.
+std::map<std::string, std::shared_ptr<rocksdb::RateLimiter>> GetDataDirRateLimiters();
 
 // Sets logs prefix for RocksDB options. This will also reinitialize options->info_log.
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix);
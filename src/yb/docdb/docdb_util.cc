@@ -61,7 +61,9 @@ Status DocDBRocksDBUtil::OpenRocksDB() {
   rocksdb_.reset(rocksdb);
 
   rocksdb = nullptr;
-  RETURN_NOT_OK(rocksdb::DB::Open(rocksdb_options_, IntentsDBDir(), &rocksdb));
+  auto intents_options = rocksdb_options_;
+  intents_options.table_properties_collector_factories.clear();
+  RETURN_NOT_OK(rocksdb::DB::Open(intents_options, IntentsDBDir(), &rocksdb));
   intents_db_.reset(rocksdb);
 
   return Status::OK();
@@ -0,0 +1,120 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/packed_row.h"
+
+#include <algorithm>
+
+#include "yb/util/fast_varint.h"
+
+using yb::util::FastAppendUnsignedVarIntToStr;
+using yb::util::FastDecodeUnsignedVarInt;
+
+namespace yb {
+namespace docdb {
+
+RowPacker::RowPacker(uint32_t schema_version) : schema_version_(schema_version) {
+}
+
+void RowPacker::AddValue(ColumnId column_id, const PrimitiveValue& value) {
+  DCHECK(num_columns_ == 0 || column_id > last_column_id_)
+      << "Columns should be added in increasing order: " << column_id << " after "
+      << last_column_id_;
+  auto encoded_value = value.ToValue();
+  FastAppendUnsignedVarIntToStr(column_id.rep(), &columns_);
+  FastAppendUnsignedVarIntToStr(encoded_value.size(), &columns_);
+  columns_ += encoded_value;
+  last_column_id_ = column_id;
+  ++num_columns_;
+}
+
+PrimitiveValue RowPacker::Complete() {
+  std::string result;
+  result.reserve(columns_.size() + 16);
+  FastAppendUnsignedVarIntToStr(schema_version_, &result);
+  FastAppendUnsignedVarIntToStr(num_columns_, &result);
+  result += columns_;
+  return PrimitiveValue::PackedRow(std::move(result));
+}
+
+Status PackedRow::Decode(const Slice& packed_row) {
+  Slice input = packed_row;
+  schema_version_ = VERIFY_RESULT(FastDecodeUnsignedVarInt(&input));
+  auto num_columns = VERIFY_RESULT(FastDecodeUnsignedVarInt(&input));
+  columns_.clear();
+  columns_.reserve(num_columns);
+  for (uint64_t i = 0; i != num_columns; ++i) {
+    ColumnId column_id;
+    RETURN_NOT_OK(ColumnId::FromInt64(VERIFY_RESULT(FastDecodeUnsignedVarInt(&input)), &column_id));
+    auto value_size = VERIFY_RESULT(FastDecodeUnsignedVarInt(&input));
+    if (value_size > input.size()) {
+      return STATUS_FORMAT(
+          Corruption, "Value of column $0 does not fit into packed row: $1 vs $2",
+          column_id, value_size, input.size());
+    }
+    if (!columns_.empty() && columns_.back().first >= column_id) {
+      return STATUS_FORMAT(
+          Corruption, "Columns of packed row are not sorted: $0 after $1",
+          column_id, columns_.back().first);
+    }
+    columns_.emplace_back(column_id, Slice(input.data(), value_size));
+    input.remove_prefix(value_size);
+  }
+  if (!input.empty()) {
+    return STATUS_FORMAT(
+        Corruption, "Extra $0 bytes after $1 columns of packed row", input.size(), num_columns);
+  }
+  return Status::OK();
+}
+
+const Slice* PackedRow::GetValue(ColumnId column_id) const {
+  auto it = std::lower_bound(
+      columns_.begin(), columns_.end(), column_id,
+      [](const std::pair<ColumnId, Slice>& lhs, ColumnId rhs) { return lhs.first < rhs; });
+  if (it == columns_.end() || it->first != column_id) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+Result<bool> PackedRow::GetValue(ColumnId column_id, PrimitiveValue* out) const {
+  auto value = GetValue(column_id);
+  if (!value) {
+    return false;
+  }
+  RETURN_NOT_OK(out->DecodeFromValue(*value));
+  return true;
+}
+
+std::string PackedRow::ToString() const {
+  std::string result = Format("{ schema_version: $0", schema_version_);
+  PrimitiveValue value;
+  for (const auto& column : columns_) {
+    auto status = value.DecodeFromValue(column.second);
+    result += Format(" $0: $1", column.first, status.ok() ? value.ToString() : status.ToString());
+  }
+  result += " }";
+  return result;
+}
+
+std::string PackedRowToString(const Slice& packed_row) {
+  PackedRow row;
+  auto status = row.Decode(packed_row);
+  if (!status.ok()) {
+    return Format("PackedRow($0, $1)", status, packed_row.ToDebugHexString());
+  }
+  return "PackedRow" + row.ToString();
+}
+
+}  // namespace docdb
+}  // namespace yb
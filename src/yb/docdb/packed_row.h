@@ -0,0 +1,96 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_PACKED_ROW_H
+#define YB_DOCDB_PACKED_ROW_H
+
+#include <string>
+
+#include <boost/container/small_vector.hpp>
+
+#include "yb/common/schema.h"
+
+#include "yb/docdb/primitive_value.h"
+
+#include "yb/util/slice.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace docdb {
+
+// Packed row stores values of all non-key columns of a QL row in a single RocksDB entry, instead of
+// an entry per column. It is written to the kPackedRowColumn system column of the row, next to the
+// liveness column, as a PrimitiveValue of kPackedRow type with the following content:
+//
+//   schema_version num_columns (column_id value_size value)*
+//
+// Numbers are encoded as unsigned varints, columns are sorted by id and each value is encoded the
+// same way as a standalone column value (see PrimitiveValue::ToValue). Null column is stored as a
+// tombstone, so packed row lists all columns that were present in the schema when it was written.
+//
+// Packed row fully overwrites listed columns at its write time. So column level entries written
+// before it are ignored by reads and removed by compactions, while column level entries written
+// after it take precedence over the packed values.
+class RowPacker {
+ public:
+  explicit RowPacker(uint32_t schema_version);
+
+  // Columns should be added in increasing order of their ids.
+  void AddValue(ColumnId column_id, const PrimitiveValue& value);
+
+  // Returns packed row with all added columns.
+  PrimitiveValue Complete();
+
+ private:
+  const uint32_t schema_version_;
+  ColumnId last_column_id_;
+  size_t num_columns_ = 0;
+  std::string columns_;
+};
+
+// Decoded view of a packed row, it refers to the memory of the decoded packed row.
+class PackedRow {
+ public:
+  CHECKED_STATUS Decode(const Slice& packed_row);
+
+  uint32_t schema_version() const {
+    return schema_version_;
+  }
+
+  size_t num_columns() const {
+    return columns_.size();
+  }
+
+  ColumnId column_id(size_t idx) const {
+    return columns_[idx].first;
+  }
+
+  // Returns encoded value of the column, or nullptr when the column is not present in the row.
+  const Slice* GetValue(ColumnId column_id) const;
+
+  // Decodes value of the column into out. Returns false when the column is not present in the row.
+  Result<bool> GetValue(ColumnId column_id, PrimitiveValue* out) const;
+
+  std::string ToString() const;
+
+ private:
+  uint32_t schema_version_ = 0;
+  boost::container::small_vector<std::pair<ColumnId, Slice>, 16> columns_;
+};
+
+std::string PackedRowToString(const Slice& packed_row);
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_PACKED_ROW_H
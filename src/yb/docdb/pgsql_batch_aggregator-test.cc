@@ -0,0 +1,152 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/pgsql_batch_aggregator.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+const ColumnId kKeyColumn(10);
+const ColumnId kValueColumn(11);
+const ColumnId kDoubleColumn(12);
+
+void AddTarget(bfpg::TSOpcode opcode, ColumnId column, PgsqlReadRequestPB* request) {
+  auto* tscall = request->add_targets()->mutable_tscall();
+  tscall->set_opcode(static_cast<int32_t>(opcode));
+  tscall->add_operands()->set_column_id(column.rep());
+}
+
+void AddCountStar(PgsqlReadRequestPB* request) {
+  auto* tscall = request->add_targets()->mutable_tscall();
+  tscall->set_opcode(static_cast<int32_t>(bfpg::TSOpcode::kCount));
+  tscall->add_operands()->mutable_value()->set_int64_value(0);
+}
+
+void SetCondition(QLOperator op, ColumnId column, int32_t value, PgsqlConditionPB* condition) {
+  condition->set_op(op);
+  condition->add_operands()->set_column_id(column.rep());
+  condition->add_operands()->mutable_value()->set_int32_value(value);
+}
+
+} // namespace
+
+class PgsqlBatchAggregatorTest : public YBTest {
+ protected:
+  PgsqlBatchAggregatorTest()
+      : schema_({ ColumnSchema("k", DataType::INT32, false),
+                  ColumnSchema("v", DataType::INT64, true),
+                  ColumnSchema("d", DataType::DOUBLE, true) },
+                { kKeyColumn, kValueColumn, kDoubleColumn },
+                1) {
+    request_.set_is_aggregate(true);
+  }
+
+  // Adds rows with k in [0, num_rows), v = k for even k and NULL otherwise, d = k / 2.
+  void AddRows(int num_rows, PgsqlBatchAggregator* aggregator) {
+    QLTableRow row;
+    for (int k = 0; k != num_rows; ++k) {
+      row.Clear();
+      QLValue key;
+      key.set_int32_value(k);
+      row.AllocColumn(kKeyColumn, key);
+      if (k % 2 == 0) {
+        QLValue value;
+        value.set_int64_value(k);
+        row.AllocColumn(kValueColumn, value);
+      }
+      QLValue d;
+      d.set_double_value(k / 2.0);
+      row.AllocColumn(kDoubleColumn, d);
+      aggregator->AddRow(row);
+    }
+  }
+
+  Schema schema_;
+  PgsqlReadRequestPB request_;
+};
+
+TEST_F(PgsqlBatchAggregatorTest, CountAndSum) {
+  AddCountStar(&request_);
+  AddTarget(bfpg::TSOpcode::kCount, kValueColumn, &request_);
+  AddTarget(bfpg::TSOpcode::kSumInt64, kValueColumn, &request_);
+  AddTarget(bfpg::TSOpcode::kSumDouble, kDoubleColumn, &request_);
+  // k >= 100 AND k < 3000
+  auto* condition = request_.mutable_where_expr()->mutable_condition();
+  condition->set_op(QL_OP_AND);
+  SetCondition(QL_OP_GREATER_THAN_EQUAL, kKeyColumn, 100,
+               condition->add_operands()->mutable_condition());
+  SetCondition(QL_OP_LESS_THAN, kKeyColumn, 3000,
+               condition->add_operands()->mutable_condition());
+
+  auto aggregator = PgsqlBatchAggregator::Create(request_, schema_);
+  ASSERT_TRUE(aggregator);
+  AddRows(5000, aggregator.get());
+
+  std::vector<QLValue> result;
+  ASSERT_EQ(2900U, aggregator->Finish(&result));
+  ASSERT_EQ(4U, result.size());
+  ASSERT_EQ(2900, result[0].int64_value());
+  ASSERT_EQ(1450, result[1].int64_value());
+  int64_t int_sum = 0;
+  double double_sum = 0;
+  for (int k = 100; k != 3000; ++k) {
+    if (k % 2 == 0) {
+      int_sum += k;
+    }
+    double_sum += k / 2.0;
+  }
+  ASSERT_EQ(int_sum, result[2].int64_value());
+  ASSERT_EQ(double_sum, result[3].double_value());
+}
+
+TEST_F(PgsqlBatchAggregatorTest, NoValues) {
+  AddTarget(bfpg::TSOpcode::kSumInt64, kValueColumn, &request_);
+  SetCondition(QL_OP_EQUAL, kKeyColumn, 1, request_.mutable_where_expr()->mutable_condition());
+
+  auto aggregator = PgsqlBatchAggregator::Create(request_, schema_);
+  ASSERT_TRUE(aggregator);
+  AddRows(10, aggregator.get());
+
+  // The only matching row has NULL value, so the sum is NULL as in row by row evaluation.
+  std::vector<QLValue> result;
+  ASSERT_EQ(1U, aggregator->Finish(&result));
+  ASSERT_EQ(1U, result.size());
+  ASSERT_TRUE(result[0].IsNull());
+}
+
+TEST_F(PgsqlBatchAggregatorTest, Unsupported) {
+  // Sum opcode does not match column type.
+  AddTarget(bfpg::TSOpcode::kSumInt32, kValueColumn, &request_);
+  ASSERT_FALSE(PgsqlBatchAggregator::Create(request_, schema_));
+
+  // Condition on nullable column.
+  request_.clear_targets();
+  AddCountStar(&request_);
+  SetCondition(QL_OP_EQUAL, kValueColumn, 1, request_.mutable_where_expr()->mutable_condition());
+  ASSERT_FALSE(PgsqlBatchAggregator::Create(request_, schema_));
+
+  // Constant type does not match column type.
+  request_.mutable_where_expr()->mutable_condition()->mutable_operands(1)->mutable_value()->
+      set_int64_value(1);
+  request_.mutable_where_expr()->mutable_condition()->mutable_operands(0)->set_column_id(
+      kKeyColumn.rep());
+  ASSERT_FALSE(PgsqlBatchAggregator::Create(request_, schema_));
+}
+
+} // namespace docdb
+} // namespace yb
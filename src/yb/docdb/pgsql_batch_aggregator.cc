@@ -0,0 +1,394 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/pgsql_batch_aggregator.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+bool IsIntegerType(DataType type) {
+  return type == DataType::INT8 || type == DataType::INT16 || type == DataType::INT32 ||
+         type == DataType::INT64;
+}
+
+bool IsFloatingPointType(DataType type) {
+  return type == DataType::FLOAT || type == DataType::DOUBLE;
+}
+
+// Returns data type of the constant if it could be used in batch predicate.
+boost::optional<DataType> ConstantType(const QLValuePB& value) {
+  switch (value.value_case()) {
+    case QLValuePB::kInt8Value: return DataType::INT8;
+    case QLValuePB::kInt16Value: return DataType::INT16;
+    case QLValuePB::kInt32Value: return DataType::INT32;
+    case QLValuePB::kInt64Value: return DataType::INT64;
+    case QLValuePB::kFloatValue: return DataType::FLOAT;
+    case QLValuePB::kDoubleValue: return DataType::DOUBLE;
+    default: return boost::none;
+  }
+}
+
+int64_t IntValue(const QLValuePB& value) {
+  switch (value.value_case()) {
+    case QLValuePB::kInt8Value: return value.int8_value();
+    case QLValuePB::kInt16Value: return value.int16_value();
+    case QLValuePB::kInt32Value: return value.int32_value();
+    case QLValuePB::kInt64Value: return value.int64_value();
+    default: return 0;
+  }
+}
+
+double DoubleValue(const QLValuePB& value) {
+  switch (value.value_case()) {
+    case QLValuePB::kFloatValue: return value.float_value();
+    case QLValuePB::kDoubleValue: return value.double_value();
+    default: return 0;
+  }
+}
+
+bool IsRelationalOperator(QLOperator op) {
+  switch (op) {
+    case QL_OP_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN_EQUAL:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Narrows selection using comparison of each value with constant.
+// Written without branches in the loop body, so compiler could vectorize it.
+template <class Value, class Compare>
+void Select(const std::vector<Value>& values, Value constant, size_t size, Compare compare,
+            std::vector<uint8_t>* selection) {
+  auto* out = selection->data();
+  const auto* in = values.data();
+  for (size_t i = 0; i != size; ++i) {
+    out[i] &= static_cast<uint8_t>(compare(in[i], constant));
+  }
+}
+
+template <class Value>
+void Select(const std::vector<Value>& values, Value constant, size_t size, QLOperator op,
+            std::vector<uint8_t>* selection) {
+  switch (op) {
+    case QL_OP_EQUAL:
+      Select(values, constant, size, std::equal_to<Value>(), selection);
+      return;
+    case QL_OP_NOT_EQUAL:
+      Select(values, constant, size, std::not_equal_to<Value>(), selection);
+      return;
+    case QL_OP_LESS_THAN:
+      Select(values, constant, size, std::less<Value>(), selection);
+      return;
+    case QL_OP_LESS_THAN_EQUAL:
+      Select(values, constant, size, std::less_equal<Value>(), selection);
+      return;
+    case QL_OP_GREATER_THAN:
+      Select(values, constant, size, std::greater<Value>(), selection);
+      return;
+    case QL_OP_GREATER_THAN_EQUAL:
+      Select(values, constant, size, std::greater_equal<Value>(), selection);
+      return;
+    default:
+      break;
+  }
+  LOG(DFATAL) << "Unexpected operator in batch predicate: " << QLOperator_Name(op);
+}
+
+} // namespace
+
+std::unique_ptr<PgsqlBatchAggregator> PgsqlBatchAggregator::Create(
+    const PgsqlReadRequestPB& request, const Schema& schema) {
+  if (!request.is_aggregate() || request.targets().empty()) {
+    return nullptr;
+  }
+
+  std::unique_ptr<PgsqlBatchAggregator> result(new PgsqlBatchAggregator);
+  if (request.has_where_expr()) {
+    if (request.where_expr().expr_case() != PgsqlExpressionPB::ExprCase::kCondition ||
+        !result->AddPredicate(schema, request.where_expr().condition())) {
+      return nullptr;
+    }
+  }
+
+  for (const auto& target : request.targets()) {
+    if (!result->AddAggregate(schema, target)) {
+      return nullptr;
+    }
+  }
+
+  for (auto& column : result->columns_) {
+    if (column.is_floating_point) {
+      column.double_values.resize(kBlockSize);
+    } else {
+      column.int_values.resize(kBlockSize);
+    }
+    column.not_null.resize(kBlockSize);
+  }
+  result->selection_.resize(kBlockSize);
+
+  return result;
+}
+
+ssize_t PgsqlBatchAggregator::AddColumn(
+    const Schema& schema, ColumnIdRep id, bool require_not_null) {
+  auto column_schema = schema.column_by_id(ColumnId(id));
+  if (!column_schema.ok()) {
+    return -1;
+  }
+  const auto type = column_schema->type()->main();
+  if (!IsIntegerType(type) && !IsFloatingPointType(type)) {
+    return -1;
+  }
+  if (require_not_null && column_schema->is_nullable()) {
+    return -1;
+  }
+
+  for (size_t i = 0; i != columns_.size(); ++i) {
+    if (columns_[i].id == id) {
+      return i;
+    }
+  }
+  columns_.push_back(Column{id, IsFloatingPointType(type)});
+  return columns_.size() - 1;
+}
+
+bool PgsqlBatchAggregator::AddPredicate(const Schema& schema, const PgsqlConditionPB& condition) {
+  const auto& operands = condition.operands();
+  if (condition.op() == QL_OP_AND) {
+    for (const auto& operand : operands) {
+      if (operand.expr_case() != PgsqlExpressionPB::ExprCase::kCondition ||
+          !AddPredicate(schema, operand.condition())) {
+        return false;
+      }
+    }
+    return !operands.empty();
+  }
+
+  if (!IsRelationalOperator(condition.op()) || operands.size() != 2 ||
+      !operands.Get(0).has_column_id() || !operands.Get(1).has_value()) {
+    return false;
+  }
+
+  // Comparison of values of different types fails in row by row evaluation, and comparison with
+  // NULL has its own semantics, so such predicates are left to row by row evaluation.
+  const auto& constant = operands.Get(1).value();
+  auto constant_type = ConstantType(constant);
+  auto column_schema = schema.column_by_id(ColumnId(operands.Get(0).column_id()));
+  if (!constant_type || !column_schema.ok() ||
+      column_schema->type()->main() != *constant_type) {
+    return false;
+  }
+
+  auto column_index = AddColumn(schema, operands.Get(0).column_id(), true /* require_not_null */);
+  if (column_index < 0) {
+    return false;
+  }
+
+  predicates_.push_back(Predicate{static_cast<size_t>(column_index), condition.op(),
+                                  IntValue(constant), DoubleValue(constant)});
+  return true;
+}
+
+bool PgsqlBatchAggregator::AddAggregate(const Schema& schema, const PgsqlExpressionPB& target) {
+  if (!target.has_tscall() || target.tscall().operands().size() != 1) {
+    return false;
+  }
+
+  const auto opcode = static_cast<bfpg::TSOpcode>(target.tscall().opcode());
+  const auto& operand = target.tscall().operands(0);
+  Aggregate aggregate{opcode, -1};
+
+  if (opcode == bfpg::TSOpcode::kCount) {
+    if (operand.has_column_id()) {
+      // COUNT(column) skips NULLs, so column type does not matter, but we gather only numeric
+      // columns.
+      aggregate.column_index = AddColumn(schema, operand.column_id(), false);
+      if (aggregate.column_index < 0) {
+        return false;
+      }
+    } else if (!operand.has_value()) {
+      return false;
+    }
+    aggregates_.push_back(aggregate);
+    return true;
+  }
+
+  DataType expected_type;
+  switch (opcode) {
+    case bfpg::TSOpcode::kSumInt8: expected_type = DataType::INT8; break;
+    case bfpg::TSOpcode::kSumInt16: expected_type = DataType::INT16; break;
+    case bfpg::TSOpcode::kSumInt32: expected_type = DataType::INT32; break;
+    case bfpg::TSOpcode::kSumInt64: expected_type = DataType::INT64; break;
+    case bfpg::TSOpcode::kSumFloat: expected_type = DataType::FLOAT; break;
+    case bfpg::TSOpcode::kSumDouble: expected_type = DataType::DOUBLE; break;
+    default:
+      return false;
+  }
+
+  if (!operand.has_column_id()) {
+    return false;
+  }
+  auto column_schema = schema.column_by_id(ColumnId(operand.column_id()));
+  if (!column_schema.ok() || column_schema->type()->main() != expected_type) {
+    return false;
+  }
+  aggregate.column_index = AddColumn(schema, operand.column_id(), false);
+  if (aggregate.column_index < 0) {
+    return false;
+  }
+  aggregates_.push_back(aggregate);
+  return true;
+}
+
+void PgsqlBatchAggregator::AddRow(const QLTableRow& row) {
+  for (auto& column : columns_) {
+    auto value = row.GetValue(column.id);
+    const bool not_null = value && !IsNull(*value);
+    column.not_null[block_size_] = not_null;
+    if (column.is_floating_point) {
+      column.double_values[block_size_] = not_null ? DoubleValue(*value) : 0;
+    } else {
+      column.int_values[block_size_] = not_null ? IntValue(*value) : 0;
+    }
+  }
+
+  if (++block_size_ == kBlockSize) {
+    EvaluateBlock();
+  }
+}
+
+void PgsqlBatchAggregator::ApplyPredicate(const Predicate& predicate) {
+  const auto& column = columns_[predicate.column_index];
+  if (column.is_floating_point) {
+    Select(column.double_values, predicate.double_value, block_size_, predicate.op, &selection_);
+  } else {
+    Select(column.int_values, predicate.int_value, block_size_, predicate.op, &selection_);
+  }
+}
+
+void PgsqlBatchAggregator::EvaluateBlock() {
+  const size_t size = block_size_;
+  if (size == 0) {
+    return;
+  }
+  block_size_ = 0;
+
+  std::fill(selection_.begin(), selection_.begin() + size, 1);
+  for (const auto& predicate : predicates_) {
+    ApplyPredicate(predicate);
+  }
+
+  const uint8_t* selection = selection_.data();
+  size_t block_matches = 0;
+  for (size_t i = 0; i != size; ++i) {
+    block_matches += selection[i];
+  }
+  match_count_ += block_matches;
+
+  for (auto& aggregate : aggregates_) {
+    if (aggregate.column_index < 0) {
+      aggregate.count += block_matches;
+      continue;
+    }
+
+    const auto& column = columns_[aggregate.column_index];
+    const uint8_t* not_null = column.not_null.data();
+    int64_t count = 0;
+    for (size_t i = 0; i != size; ++i) {
+      count += selection[i] & not_null[i];
+    }
+    aggregate.count += count;
+
+    switch (aggregate.opcode) {
+      case bfpg::TSOpcode::kSumInt8: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumInt16: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumInt32: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumInt64: {
+        const int64_t* values = column.int_values.data();
+        int64_t sum = 0;
+        for (size_t i = 0; i != size; ++i) {
+          sum += values[i] * (selection[i] & not_null[i]);
+        }
+        aggregate.int_sum += sum;
+        break;
+      }
+      // Floating point additions are not associative, so they are done in row order with the
+      // same precision as row by row evaluation, to produce exactly the same result.
+      case bfpg::TSOpcode::kSumFloat: {
+        const double* values = column.double_values.data();
+        for (size_t i = 0; i != size; ++i) {
+          if (selection[i] & not_null[i]) {
+            aggregate.float_sum += static_cast<float>(values[i]);
+          }
+        }
+        break;
+      }
+      case bfpg::TSOpcode::kSumDouble: {
+        const double* values = column.double_values.data();
+        for (size_t i = 0; i != size; ++i) {
+          if (selection[i] & not_null[i]) {
+            aggregate.double_sum += values[i];
+          }
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+size_t PgsqlBatchAggregator::Finish(std::vector<QLValue>* result) {
+  EvaluateBlock();
+
+  result->clear();
+  result->resize(aggregates_.size());
+  for (size_t i = 0; i != aggregates_.size(); ++i) {
+    const auto& aggregate = aggregates_[i];
+    auto& value = (*result)[i];
+    // Row by row evaluation leaves aggregate NULL when there were no values to aggregate.
+    if (aggregate.count == 0) {
+      continue;
+    }
+    switch (aggregate.opcode) {
+      case bfpg::TSOpcode::kCount: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumInt8: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumInt16: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumInt32: FALLTHROUGH_INTENDED;
+      case bfpg::TSOpcode::kSumInt64:
+        value.set_int64_value(
+            aggregate.opcode == bfpg::TSOpcode::kCount ? aggregate.count : aggregate.int_sum);
+        break;
+      case bfpg::TSOpcode::kSumFloat:
+        value.set_float_value(aggregate.float_sum);
+        break;
+      case bfpg::TSOpcode::kSumDouble:
+        value.set_double_value(aggregate.double_sum);
+        break;
+      default:
+        break;
+    }
+  }
+  return match_count_;
+}
+
+} // namespace docdb
+} // namespace yb
@@ -0,0 +1,107 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_PGSQL_BATCH_AGGREGATOR_H
+#define YB_DOCDB_PGSQL_BATCH_AGGREGATOR_H
+
+#include <memory>
+#include <vector>
+
+#include "yb/common/pgsql_protocol.pb.h"
+#include "yb/common/ql_expr.h"
+#include "yb/common/ql_value.h"
+#include "yb/common/schema.h"
+
+#include "yb/util/bfpg/tserver_opcodes.h"
+#include "yb/util/result.h"
+
+namespace yb {
+namespace docdb {
+
+// Evaluates WHERE condition and aggregates of a PGSQL read request over blocks of rows.
+//
+// Values of referenced columns are gathered into typed column vectors, then predicates and
+// aggregates are evaluated by tight loops over those vectors, instead of evaluating expression
+// tree for each row. Only simple requests are supported:
+// - Targets are COUNT(*), COUNT(column) or SUM of integer/floating point column of matching type.
+// - WHERE condition is absent, or is a comparison of not null numeric column with a constant of
+//   the same type, or AND of such comparisons.
+// Create returns nullptr for all other requests, so they are executed row by row.
+class PgsqlBatchAggregator {
+ public:
+  static constexpr size_t kBlockSize = 1024;
+
+  static std::unique_ptr<PgsqlBatchAggregator> Create(
+      const PgsqlReadRequestPB& request, const Schema& schema);
+
+  // Adds row to the current block, evaluates the block when it is full.
+  void AddRow(const QLTableRow& row);
+
+  // Evaluates buffered rows and fills result with aggregate values in order of request targets.
+  // Result values are the same as produced by row by row evaluation.
+  // Returns number of rows that matched WHERE condition.
+  size_t Finish(std::vector<QLValue>* result);
+
+ private:
+  struct Column {
+    ColumnIdRep id;
+    bool is_floating_point;
+    std::vector<int64_t> int_values;
+    std::vector<double> double_values;
+    std::vector<uint8_t> not_null;
+  };
+
+  struct Predicate {
+    size_t column_index;
+    QLOperator op;
+    int64_t int_value;
+    double double_value;
+  };
+
+  struct Aggregate {
+    bfpg::TSOpcode opcode;
+    // Index of aggregated column, or -1 for COUNT(*).
+    ssize_t column_index;
+    int64_t count = 0;
+    int64_t int_sum = 0;
+    float float_sum = 0;
+    double double_sum = 0;
+  };
+
+  PgsqlBatchAggregator() = default;
+
+  // Returns index of column in columns_, adding it when necessary.
+  // Returns -1 if column could not be evaluated in batch.
+  ssize_t AddColumn(const Schema& schema, ColumnIdRep id, bool require_not_null);
+
+  bool AddPredicate(const Schema& schema, const PgsqlConditionPB& condition);
+  bool AddAggregate(const Schema& schema, const PgsqlExpressionPB& target);
+
+  void EvaluateBlock();
+  void ApplyPredicate(const Predicate& predicate);
+
+  std::vector<Column> columns_;
+  std::vector<Predicate> predicates_;
+  std::vector<Aggregate> aggregates_;
+
+  // Number of rows in the current block.
+  size_t block_size_ = 0;
+  // Rows of the current block that match all predicates.
+  std::vector<uint8_t> selection_;
+  size_t match_count_ = 0;
+};
+
+} // namespace docdb
+} // namespace yb
+
+#endif // YB_DOCDB_PGSQL_BATCH_AGGREGATOR_H
@@ -21,8 +21,10 @@
 
 #include "yb/docdb/doc_pgsql_scanspec.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
+#include "yb/docdb/pgsql_batch_aggregator.h"
 #include "yb/docdb/primitive_value_util.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/trace.h"
 
 DECLARE_bool(trace_docdb_calls);
@@ -31,6 +33,11 @@ DECLARE_int64(retryable_rpc_single_call_timeout_ms);
 DEFINE_double(ysql_scan_timeout_multiplier, 0.5,
               "YSQL read scan timeout multipler of retryable_rpc_single_call_timeout_ms.");
 
+DEFINE_bool(ysql_enable_batch_aggregate, true,
+            "Evaluate WHERE condition and aggregates of simple YSQL aggregate scans over blocks "
+            "of rows instead of row by row.");
+TAG_FLAG(ysql_enable_batch_aggregate, advanced);
+
 namespace yb {
 namespace docdb {
 
@@ -419,8 +426,16 @@ Status PgsqlReadOperation::Execute(const common::YQLStorageIf& ql_storage,
     FLAGS_retryable_rpc_single_call_timeout_ms * FLAGS_ysql_scan_timeout_multiplier;
   const MonoTime start_time = MonoTime::Now();
 
+  std::unique_ptr<PgsqlBatchAggregator> batch_aggregator;
+  if (FLAGS_ysql_enable_batch_aggregate) {
+    batch_aggregator = PgsqlBatchAggregator::Create(request_, schema);
+  }
+
   // Fetching data.
   int match_count = 0;
+  // Number of rows added to batch aggregator, used instead of match_count to check scan time,
+  // since matches are known only after a block of rows is evaluated.
+  size_t batched_count = 0;
   QLTableRow::SharedPtr row = std::make_shared<QLTableRow>();
   while (resultset->rsrow_count() < row_count_limit && VERIFY_RESULT(iter->HasNext()) &&
          !scan_time_exceeded) {
@@ -444,6 +459,15 @@ Status PgsqlReadOperation::Execute(const common::YQLStorageIf& ql_storage,
       RETURN_NOT_OK(iter->NextRow(projection, row.get()));
     }
 
+    if (batch_aggregator) {
+      batch_aggregator->AddRow(*row);
+      if (++batched_count % row_count_limit == 0) {
+        const MonoDelta elapsed_time = MonoTime::Now().GetDeltaSince(start_time);
+        scan_time_exceeded = elapsed_time.ToMilliseconds() > scan_time_limit;
+      }
+      continue;
+    }
+
     // Match the row with the where condition before adding to the row block.
     bool is_match = true;
     if (request_.has_where_expr()) {
@@ -467,6 +491,10 @@ Status PgsqlReadOperation::Execute(const common::YQLStorageIf& ql_storage,
     }
   }
 
+  if (batch_aggregator) {
+    match_count = batch_aggregator->Finish(&aggr_result_);
+  }
+
   if (request_.is_aggregate() && match_count > 0) {
     RETURN_NOT_OK(PopulateAggregate(row, resultset));
   }
@@ -159,6 +159,47 @@ TEST_F(SharedLockManagerTest, QuickLockUnlock) {
   }
 }
 
+// Measures throughput of Lock/Unlock pairs for non conflicting keys with different number of
+// threads. Each thread locks its own keys, so all contention happens inside the lock manager.
+// Runs each step for 2s only when slow tests are allowed, otherwise it is a quick sanity check.
+TEST_F(SharedLockManagerTest, LockUnlockThroughput) {
+  const auto kTestTime = AllowSlowTests() ? 2000ms : 50ms;
+  const IntentTypeSet kIntents({IntentType::kWeakRead, IntentType::kWeakWrite});
+
+  for (size_t num_threads = 1; num_threads <= 64; num_threads *= 2) {
+    std::atomic<bool> stop_requested{false};
+    std::atomic<size_t> total_batches{0};
+    std::vector<std::thread> threads;
+    while (threads.size() != num_threads) {
+      size_t thread_idx = threads.size();
+      threads.emplace_back([this, &stop_requested, &total_batches, &kIntents, thread_idx] {
+        std::vector<RefCntPrefix> keys;
+        for (int i = 0; i != 16; ++i) {
+          keys.emplace_back(Format("key_$0_$1", thread_idx, i));
+        }
+        size_t batches = 0;
+        while (!stop_requested.load(std::memory_order_acquire)) {
+          LockBatch lb(&lm_,
+                       {{keys[batches % keys.size()], kIntents},
+                        {keys[(batches + 1) % keys.size()], kIntents}},
+                       CoarseTimePoint::max());
+          ++batches;
+        }
+        total_batches.fetch_add(batches, std::memory_order_acq_rel);
+      });
+    }
+
+    std::this_thread::sleep_for(kTestTime);
+    stop_requested.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    LOG(INFO) << "Threads: " << num_threads << ", lock/unlock batches per second: "
+              << total_batches.load() * 1000 / MonoDelta(kTestTime).ToMilliseconds();
+  }
+}
+
 TEST_F(SharedLockManagerTest, LockConflicts) {
   rpc::ThreadPool tp(rpc::ThreadPoolOptions{"test_pool"s, 10, 1});
 
@@ -13,11 +13,14 @@
 
 #include "yb/docdb/shared_lock_manager.h"
 
+#include <array>
 #include <vector>
 
 #include <boost/range/adaptor/reversed.hpp>
 #include <glog/logging.h>
 
+#include "yb/gutil/port.h"
+
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/enums.h"
 #include "yb/util/logging.h"
@@ -107,8 +110,8 @@ struct LockedBatchEntry {
 
   std::condition_variable cond_var;
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and the same for all LockBatchEntries.
+  // Refcounting for garbage collection. Can only be used while the shard mutex is locked.
+  // Shard mutex resides in lock manager and the same for all LockBatchEntries of this shard.
   size_t ref_count = 0;
 
   // Number of holders for each type
@@ -134,28 +137,44 @@ class SharedLockManager::Impl {
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      LOG_IF(DFATAL, !shard.locks.empty()) << "Locks not empty in dtor: "
+                                           << yb::ToString(shard.locks);
+    }
   }
 
  private:
   typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
+  // Keys are distributed between shards by hash, so concurrent batches with different keys
+  // usually don't contend on the same mutex.
+  // Aligned to cache line to avoid false sharing between mutexes of neighbour shards.
+  struct Shard {
+    // The shard mutex should be taken only for very short duration, with no blocking wait.
+    std::mutex mutex;
+
+    LockEntryMap locks GUARDED_BY(mutex);
+    // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+    std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries GUARDED_BY(mutex);
+    std::vector<LockedBatchEntry*> free_lock_entries GUARDED_BY(mutex);
+  } CACHELINE_ALIGNED;
+
+  static constexpr size_t kNumShards = 32;
+
+  Shard& ShardFor(const RefCntPrefix& key) {
+    return shards_[RefCntPrefixHash()(key) % kNumShards];
+  }
+
+  // Make sure the entries exist in the locks map of their shards and return pointers so we can
+  // access them without holding the shard lock. Returns a vector with pointers in the same order
   // as the keys in the batch.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
-
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  std::array<Shard, kNumShards> shards_;
 };
 
 const std::array<LockState, kIntentTypeSetMapSize> kIntentTypeSetMask = GenerateByMask(
@@ -274,16 +293,17 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
 }
 
 void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
   for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
+    auto& shard = ShardFor(key_and_intent_type.key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto& value = shard.locks[key_and_intent_type.key];
     if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
+      if (!shard.free_lock_entries.empty()) {
+        value = shard.free_lock_entries.back();
+        shard.free_lock_entries.pop_back();
       } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
+        shard.lock_entries.emplace_back(std::make_unique<LockedBatchEntry>());
+        value = shard.lock_entries.back().get();
       }
     }
     value->ref_count++;
@@ -302,11 +322,12 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
 }
 
 void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
   for (const auto& item : key_to_intent_type) {
+    auto& shard = ShardFor(item.key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
     if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
+      shard.locks.erase(item.key);
+      shard.free_lock_entries.push_back(item.locked);
     }
   }
 }
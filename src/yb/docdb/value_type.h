@@ -92,6 +92,8 @@ namespace docdb {
     ((kDoubleDescending, 'L'))  /* ASCII code 76 */ \
     ((kFloatDescending, 'M')) /* ASCII code 77 */ \
     ((kUInt32, 'O'))  /* ASCII code 78 */ \
+    /* Values of all non-key columns of a row, stored in a single entry. See packed_row.h. */ \
+    ((kPackedRow, 'P'))  /* ASCII code 80 */ \
     ((kString, 'S'))  /* ASCII code 83 */ \
     ((kTrue, 'T'))  /* ASCII code 84 */ \
     ((kUInt64, 'U')) /* ASCII code 85 */ \
@@ -0,0 +1,92 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <atomic>
+#include <thread>
+
+#include "yb/docdb/wait_queue.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace docdb {
+
+class WaitQueueTest : public YBTest {
+ protected:
+  WaitQueue queue_{nullptr};
+};
+
+TEST_F(WaitQueueTest, SignalWakesWaiter) {
+  auto waiter = GenerateTransactionId();
+  auto blocker = GenerateTransactionId();
+  std::atomic<bool> done{false};
+
+  std::thread thread([this, &waiter, &blocker, &done] {
+    ASSERT_TRUE(queue_.Wait(waiter, {blocker}, CoarseMonoClock::now() + 60s));
+    done = true;
+  });
+
+  while (queue_.num_waiters() == 0) {
+    std::this_thread::sleep_for(1ms);
+  }
+  ASSERT_FALSE(done.load());
+
+  queue_.SignalFinished(GenerateTransactionId());
+  std::this_thread::sleep_for(50ms);
+  ASSERT_FALSE(done.load());
+
+  queue_.SignalFinished(blocker);
+  thread.join();
+  ASSERT_TRUE(done.load());
+  ASSERT_EQ(0, queue_.num_waiters());
+}
+
+TEST_F(WaitQueueTest, Timeout) {
+  auto start = CoarseMonoClock::now();
+  ASSERT_TRUE(queue_.Wait(
+      GenerateTransactionId(), {GenerateTransactionId()}, start + 100ms));
+  ASSERT_GE(CoarseMonoClock::now() - start, 100ms);
+  ASSERT_EQ(0, queue_.num_waiters());
+}
+
+TEST_F(WaitQueueTest, Deadlock) {
+  auto txn1 = GenerateTransactionId();
+  auto txn2 = GenerateTransactionId();
+  auto txn3 = GenerateTransactionId();
+
+  // txn1 waits for txn2, txn2 waits for txn3.
+  std::thread thread1([this, &txn1, &txn2] {
+    ASSERT_TRUE(queue_.Wait(txn1, {txn2}, CoarseMonoClock::now() + 60s));
+  });
+  std::thread thread2([this, &txn2, &txn3] {
+    ASSERT_TRUE(queue_.Wait(txn2, {txn3}, CoarseMonoClock::now() + 60s));
+  });
+
+  while (queue_.num_waiters() != 2) {
+    std::this_thread::sleep_for(1ms);
+  }
+
+  // txn3 waiting for txn1 would close the cycle.
+  ASSERT_FALSE(queue_.Wait(txn3, {txn1}, CoarseMonoClock::now() + 60s));
+
+  queue_.SignalFinished(txn3);
+  thread2.join();
+  queue_.SignalFinished(txn2);
+  thread1.join();
+}
+
+} // namespace docdb
+} // namespace yb
@@ -0,0 +1,131 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/wait_queue.h"
+
+#include <algorithm>
+
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/tostring.h"
+
+METRIC_DEFINE_histogram(
+    tablet, wait_queue_wait_time, "Conflict wait queue wait time",
+    yb::MetricUnit::kMicroseconds,
+    "Time spent by transactions parked in the conflict wait queue", 60000000LU, 2);
+METRIC_DEFINE_simple_gauge_uint64(
+    tablet, wait_queue_num_waiters,
+    "Number of requests waiting in the conflict wait queue",
+    yb::MetricUnit::kRequests);
+METRIC_DEFINE_simple_counter(
+    tablet, wait_queue_deadlocks,
+    "Total number of waits refused by the conflict wait queue because of a deadlock",
+    yb::MetricUnit::kRequests);
+
+namespace yb {
+namespace docdb {
+
+struct WaitQueue::Waiter {
+  const TransactionId& id;
+  const TransactionIdSet& blockers;
+  std::condition_variable cond;
+  bool signaled = false;
+};
+
+WaitQueue::WaitQueue(const scoped_refptr<MetricEntity>& metric_entity) {
+  if (metric_entity) {
+    wait_time_ = METRIC_wait_queue_wait_time.Instantiate(metric_entity);
+    num_waiters_ = METRIC_wait_queue_num_waiters.Instantiate(metric_entity, 0);
+    deadlocks_ = METRIC_wait_queue_deadlocks.Instantiate(metric_entity);
+  }
+}
+
+WaitQueue::~WaitQueue() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  LOG_IF(DFATAL, !waiters_.empty()) << "Wait queue destroyed with " << waiters_.size()
+                                    << " waiters";
+}
+
+bool WaitQueue::Wait(
+    const TransactionId& waiter, const TransactionIdSet& blockers, CoarseTimePoint deadline) {
+  Waiter entry{waiter, blockers};
+  auto start = CoarseMonoClock::now();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (HasPathTo(waiter, blockers)) {
+      VLOG(2) << "Deadlock detected, waiter: " << waiter << ", blockers: " << yb::ToString(blockers);
+      if (deadlocks_) {
+        deadlocks_->Increment();
+      }
+      return false;
+    }
+
+    waiters_.push_back(&entry);
+    if (num_waiters_) {
+      num_waiters_->set_value(waiters_.size());
+    }
+
+    entry.cond.wait_until(lock, deadline, [&entry] { return entry.signaled; });
+
+    waiters_.erase(std::find(waiters_.begin(), waiters_.end(), &entry));
+    if (num_waiters_) {
+      num_waiters_->set_value(waiters_.size());
+    }
+  }
+
+  if (wait_time_) {
+    wait_time_->Increment(MonoDelta(CoarseMonoClock::now() - start).ToMicroseconds());
+  }
+  return true;
+}
+
+void WaitQueue::SignalFinished(const TransactionId& id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto* waiter : waiters_) {
+    if (!waiter->signaled && waiter->blockers.count(id)) {
+      waiter->signaled = true;
+      waiter->cond.notify_one();
+    }
+  }
+}
+
+size_t WaitQueue::num_waiters() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return waiters_.size();
+}
+
+bool WaitQueue::HasPathTo(const TransactionId& target, const TransactionIdSet& blockers) const {
+  // Wait-for graph is small, since it contains only currently blocked requests of this tablet,
+  // so plain depth first search over the list of waiters is good enough.
+  TransactionIdSet visited;
+  std::vector<TransactionId> stack(blockers.begin(), blockers.end());
+  while (!stack.empty()) {
+    auto current = stack.back();
+    stack.pop_back();
+    if (current == target) {
+      return true;
+    }
+    if (!visited.insert(current).second) {
+      continue;
+    }
+    for (const auto* waiter : waiters_) {
+      if (waiter->id == current) {
+        stack.insert(stack.end(), waiter->blockers.begin(), waiter->blockers.end());
+      }
+    }
+  }
+  return false;
+}
+
+} // namespace docdb
+} // namespace yb
@@ -0,0 +1,87 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_WAIT_QUEUE_H
+#define YB_DOCDB_WAIT_QUEUE_H
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "yb/common/transaction.h"
+
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/monotime.h"
+
+namespace yb {
+
+class Counter;
+template<class T>
+class AtomicGauge;
+class Histogram;
+class MetricEntity;
+
+namespace docdb {
+
+// Per tablet queue of transactions that are blocked by intents of other transactions.
+//
+// Instead of aborting the conflicting transactions or failing the request right away, conflict
+// resolution could park the transaction here until one of the transactions that block it is
+// committed or aborted on this tablet. The queue keeps a local wait-for graph, so a wait that
+// would close a cycle is refused and the caller falls back to priority based resolution.
+class WaitQueue {
+ public:
+  explicit WaitQueue(const scoped_refptr<MetricEntity>& metric_entity);
+  ~WaitQueue();
+
+  WaitQueue(const WaitQueue&) = delete;
+  void operator=(const WaitQueue&) = delete;
+
+  // Blocks waiter until any of blockers is finished or until deadline.
+  // Returns false without waiting if waiting would form a deadlock with transactions that are
+  // already waiting in this queue.
+  MUST_USE_RESULT bool Wait(
+      const TransactionId& waiter, const TransactionIdSet& blockers, CoarseTimePoint deadline);
+
+  // Notifies waiters that transaction with specified id was committed or aborted on this tablet.
+  void SignalFinished(const TransactionId& id);
+
+  template <class Ids>
+  void SignalFinished(const Ids& ids) {
+    for (const auto& id : ids) {
+      SignalFinished(id);
+    }
+  }
+
+  // Number of requests that are currently waiting in this queue.
+  size_t num_waiters() const;
+
+ private:
+  struct Waiter;
+
+  // Returns true if there is a path in wait-for graph from any of blockers to target.
+  bool HasPathTo(const TransactionId& target, const TransactionIdSet& blockers) const;
+
+  mutable std::mutex mutex_;
+  std::vector<Waiter*> waiters_;
+
+  scoped_refptr<Histogram> wait_time_;
+  scoped_refptr<AtomicGauge<uint64_t>> num_waiters_;
+  scoped_refptr<Counter> deadlocks_;
+};
+
+} // namespace docdb
+} // namespace yb
+
+#endif // YB_DOCDB_WAIT_QUEUE_H
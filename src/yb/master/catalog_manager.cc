@@ -232,6 +232,7 @@ DEFINE_string(cluster_uuid, "", "Cluster UUID to be used by this cluster");
 TAG_FLAG(cluster_uuid, hidden);
 
 DECLARE_int32(yb_num_shards_per_tserver);
+DECLARE_bool(ycql_enable_packed_row);
 
 DEFINE_uint64(transaction_table_num_tablets, 0,
     "Number of tablets to use when creating the transaction status table."
@@ -1939,6 +1940,11 @@ Status CatalogManager::CreateTable(const CreateTableRequestPB* orig_req,
   }
   schema.mutable_table_properties()->SetNumTablets(num_tablets);
 
+  if (FLAGS_ycql_enable_packed_row && req.table_type() == TableType::YQL_TABLE_TYPE &&
+      !schema.table_properties().is_transactional()) {
+    schema.mutable_table_properties()->SetUsePackedRow(true);
+  }
+
   // Create partitions.
   PartitionSchema partition_schema;
   vector<Partition> partitions;
@@ -53,18 +53,33 @@ enum SubCacheType {
   MULTI_TOUCH
 };
 
+// Decides whether a new entry is added to the cache when it requires eviction of other entries.
+enum class CacheAdmissionPolicy {
+  // Every inserted entry is added to the cache.
+  kAdmitAll,
+  // TinyLFU: access frequency of keys is tracked by a count-min sketch, that is updated on each
+  // lookup. When insertion of a new entry requires eviction, the entry is added only if its
+  // key is accessed at least as frequently as the key of the LRU entry that would be evicted.
+  // So one-time accesses, like a large scan, do not flush the frequently used entries.
+  // A rejected entry is still returned to the caller through the handle, but is not cached.
+  kFrequencySketch,
+};
+
 class Cache;
 
 // Create a new cache with a fixed size capacity. The cache is sharded
 // to 2^num_shard_bits shards, by hash of the key. The total capacity
 // is divided and evenly assigned to each shard.
 //
-// The parameter num_shard_bits defaults to 4, and strict_capacity_limit
-// defaults to false.
+// The parameter num_shard_bits defaults to 4, strict_capacity_limit
+// defaults to false and admission_policy defaults to kAdmitAll.
 extern shared_ptr<Cache> NewLRUCache(size_t capacity);
 extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits);
 extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                                      bool strict_capacity_limit);
+extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
+                                     bool strict_capacity_limit,
+                                     CacheAdmissionPolicy admission_policy);
 
 using QueryId = int64_t;
 // Query ids to represent values for the default query id.
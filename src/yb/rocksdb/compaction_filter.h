@@ -34,6 +34,7 @@
 namespace rocksdb {
 
 class SliceTransform;
+struct FileMetaData;
 
 // Context information of a compaction run
 struct CompactionFilterContext {
@@ -141,6 +142,13 @@ class CompactionFilter {
   // compaction filter into the version edit metadata. See DocDBCompactionFilter.
   virtual UserFrontierPtr GetLargestUserFrontier() const { return nullptr; }
 
+  // Returns input files of the compaction that could be dropped without reading them, because
+  // all their records would be removed by this filter anyway. Dropped files are still deleted
+  // together with other inputs when the compaction completes.
+  virtual std::vector<FileMetaData*> FilesToDrop(const std::vector<FileMetaData*>& inputs) {
+    return {};
+  }
+
   // Returns a name that identifies this compaction filter.
   // The name will be printed to LOG file on start up for diagnosis.
   virtual const char* Name() const = 0;
@@ -155,6 +163,27 @@ class CompactionFilterFactory {
   virtual std::unique_ptr<CompactionFilter> CreateCompactionFilter(
       const CompactionFilter::Context& context) = 0;
 
+  // Creates filters for all subcompactions of the same compaction. Filters of the same compaction
+  // should make consistent decisions, so factories whose filter settings change over time should
+  // choose them once and share between all returned filters.
+  virtual std::vector<std::unique_ptr<CompactionFilter>> CreateCompactionFilters(
+      const CompactionFilter::Context& context, size_t num_subcompactions) {
+    std::vector<std::unique_ptr<CompactionFilter>> result;
+    result.reserve(num_subcompactions);
+    for (size_t i = 0; i < num_subcompactions; i++) {
+      result.push_back(CreateCompactionFilter(context));
+    }
+    return result;
+  }
+
+  // Returns the key that subcompaction boundary placed at user_key should be moved to. Filters
+  // that keep state across related keys return the beginning of the group of related keys, so
+  // such group is never split between subcompactions. Returned slice should be a prefix of
+  // user_key, or empty when subcompaction boundary could not be placed at user_key.
+  virtual Slice SubcompactionBoundary(const Slice& user_key) const {
+    return user_key;
+  }
+
   // Returns a name that identifies this compaction filter factory.
   virtual const char* Name() const = 0;
 };
@@ -510,17 +510,18 @@ uint64_t Compaction::OutputFilePreallocationSize() {
   return std::min(kMaxPreAllocationSize, preallocation_size + (preallocation_size / 10));
 }
 
-std::unique_ptr<CompactionFilter> Compaction::CreateCompactionFilter() const {
+std::vector<std::unique_ptr<CompactionFilter>> Compaction::CreateCompactionFilters(
+    size_t num_subcompactions) const {
   if (!cfd_->ioptions()->compaction_filter_factory) {
-    return nullptr;
+    return {};
   }
 
   CompactionFilter::Context context;
   context.is_full_compaction = is_full_compaction_;
   context.is_manual_compaction = is_manual_compaction_;
   context.column_family_id = cfd_->GetID();
-  return cfd_->ioptions()->compaction_filter_factory->CreateCompactionFilter(
-      context);
+  return cfd_->ioptions()->compaction_filter_factory->CreateCompactionFilters(
+      context, num_subcompactions);
 }
 
 bool Compaction::IsOutputLevelEmpty() const {
@@ -534,7 +535,9 @@ bool Compaction::ShouldFormSubcompactions() const {
   if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel) {
     return start_level_ == 0 && !IsOutputLevelEmpty();
   } else if (IsCompactionStyleUniversal()) {
-    return number_levels_ > 1 && output_level_ > 0;
+    // With single level all files are in level 0 and cover the whole key range, so boundaries of
+    // subcompactions are sampled from indexes of input files.
+    return number_levels_ == 1 || output_level_ > 0;
   } else {
     return false;
   }
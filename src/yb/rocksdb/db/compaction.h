@@ -270,8 +270,10 @@ class Compaction {
   // used in this case.
   void ResetNextCompactionIndex();
 
-  // Create a CompactionFilter from compaction_filter_factory
-  std::unique_ptr<CompactionFilter> CreateCompactionFilter() const;
+  // Create CompactionFilters for each of num_subcompactions subcompactions from
+  // compaction_filter_factory. Returns empty vector when there is no compaction_filter_factory.
+  std::vector<std::unique_ptr<CompactionFilter>> CreateCompactionFilters(
+      size_t num_subcompactions) const;
 
   // Is the input level corresponding to output_level_ empty?
   bool IsOutputLevelEmpty() const;
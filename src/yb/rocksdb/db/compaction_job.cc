@@ -30,6 +30,7 @@
 #include <inttypes.h>
 #include <algorithm>
 #include <functional>
+#include <iterator>
 #include <vector>
 #include <memory>
 #include <list>
@@ -49,6 +50,7 @@
 #include "yb/rocksdb/db/memtable_list.h"
 #include "yb/rocksdb/db/merge_context.h"
 #include "yb/rocksdb/db/merge_helper.h"
+#include "yb/rocksdb/db/table_cache.h"
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/port/likely.h"
 #include "yb/rocksdb/port/port.h"
@@ -60,6 +62,7 @@
 #include "yb/rocksdb/table/block.h"
 #include "yb/rocksdb/table/block_based_table_factory.h"
 #include "yb/rocksdb/table/merger.h"
+#include "yb/rocksdb/table/table_reader.h"
 #include "yb/rocksdb/table/table_builder.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
@@ -81,6 +84,8 @@ namespace rocksdb {
 struct CompactionJob::SubcompactionState {
   Compaction* compaction;
   std::unique_ptr<CompactionIterator> c_iter;
+  // Filter created by the compaction filter factory for this subcompaction.
+  std::unique_ptr<CompactionFilter> compaction_filter;
 
   // The boundaries of the key-range this compaction is interested in. No two
   // subcompactions may have overlapping key-ranges.
@@ -141,6 +146,7 @@ struct CompactionJob::SubcompactionState {
 
   SubcompactionState& operator=(SubcompactionState&& o) {
     compaction = std::move(o.compaction);
+    compaction_filter = std::move(o.compaction_filter);
     start = std::move(o.start);
     end = std::move(o.end);
     status = std::move(o.status);
@@ -394,6 +400,10 @@ void CompactionJob::GenSubcompactionBoundaries() {
           bounds.emplace_back(flevel->files[i].smallest.key);
           bounds.emplace_back(flevel->files[i].largest.key);
         }
+        if (out_lvl == 0) {
+          // Single level universal compaction, each file could cover the whole key range.
+          SampleSubcompactionBoundaries(*flevel);
+        }
       } else {
         // For all other levels add the smallest/largest key in the level to
         // encompass the range covered by that level
@@ -412,6 +422,8 @@ void CompactionJob::GenSubcompactionBoundaries() {
     }
   }
 
+  bounds.insert(bounds.end(), sampled_keys_.begin(), sampled_keys_.end());
+
   std::sort(bounds.begin(), bounds.end(),
     [cfd_comparator] (const Slice& a, const Slice& b) -> bool {
       return cfd_comparator->Compare(ExtractUserKey(a), ExtractUserKey(b)) < 0;
@@ -443,9 +455,19 @@ void CompactionJob::GenSubcompactionBoundaries() {
 
   // Group the ranges into subcompactions
   const double min_file_fill_percent = 4.0 / 5;
-  uint64_t max_output_files = static_cast<uint64_t>(std::ceil(
-      sum / min_file_fill_percent /
-      cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl)));
+  const uint64_t max_file_size = cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl);
+  uint64_t max_output_files;
+  if (max_file_size == std::numeric_limits<uint64_t>::max()) {
+    // Output file size is not limited for level 0 of universal compaction, so only compactions
+    // that are considered large are split, each subcompaction getting its share of the threshold.
+    const double min_subcompaction_size = std::max<double>(
+        1.0 * db_options_.compaction_size_threshold_bytes / db_options_.max_subcompactions, 1);
+    max_output_files = static_cast<uint64_t>(sum / min_subcompaction_size);
+  } else {
+    max_output_files = static_cast<uint64_t>(std::ceil(
+        sum / min_file_fill_percent / max_file_size));
+  }
+  auto* filter_factory = cfd->ioptions()->compaction_filter_factory;
   uint64_t subcompactions =
       std::min({static_cast<uint64_t>(ranges.size()),
                 static_cast<uint64_t>(db_options_.max_subcompactions),
@@ -466,7 +488,16 @@ void CompactionJob::GenSubcompactionBoundaries() {
         continue;
       }
       if (sum >= mean) {
-        boundaries_.emplace_back(ExtractUserKey(ranges[i].range.limit));
+        auto boundary = ExtractUserKey(ranges[i].range.limit);
+        if (filter_factory) {
+          boundary = filter_factory->SubcompactionBoundary(boundary);
+        }
+        if (boundary.empty() ||
+            (!boundaries_.empty() && cfd_comparator->Compare(boundaries_.back(), boundary) >= 0)) {
+          // Moved boundary does not split anything, so keep adding ranges to this subcompaction.
+          continue;
+        }
+        boundaries_.emplace_back(boundary);
         sizes_.emplace_back(sum);
         subcompactions--;
         sum = 0;
@@ -479,6 +510,37 @@ void CompactionJob::GenSubcompactionBoundaries() {
   }
 }
 
+void CompactionJob::SampleSubcompactionBoundaries(const LevelFilesBrief& flevel) {
+  auto* c = compact_->compaction;
+  auto* cfd = c->column_family_data();
+  uint64_t total_size = 0;
+  for (size_t i = 0; i < flevel.num_files; i++) {
+    total_size += flevel.files[i].fd.GetTotalFileSize();
+  }
+  if (total_size == 0) {
+    return;
+  }
+  // Take a few keys per subcompaction, distributed between files according to their size, so the
+  // ranges could be grouped into subcompactions of similar size.
+  const uint64_t kSamplesPerSubcompaction = 8;
+  const uint64_t total_samples = kSamplesPerSubcompaction * db_options_.max_subcompactions;
+  for (size_t i = 0; i < flevel.num_files; i++) {
+    const auto& fd = flevel.files[i].fd;
+    const auto num_samples = total_samples * fd.GetTotalFileSize() / total_size;
+    if (num_samples == 0) {
+      continue;
+    }
+    TableReader* table_reader = nullptr;
+    std::unique_ptr<InternalIterator> iter(cfd->table_cache()->NewIterator(
+        ReadOptions(), env_options_, cfd->internal_comparator(), fd, &table_reader));
+    if (table_reader == nullptr) {
+      continue;
+    }
+    auto keys = table_reader->SampleKeys(num_samples);
+    std::move(keys.begin(), keys.end(), std::back_inserter(sampled_keys_));
+  }
+}
+
 Result<FileNumbersHolder> CompactionJob::Run() {
   AutoThreadOperationStageUpdater stage_updater(
       ThreadStatus::STAGE_COMPACTION_RUN);
@@ -493,6 +555,8 @@ Result<FileNumbersHolder> CompactionJob::Run() {
   assert(num_threads > 0);
   const uint64_t start_micros = env_->NowMicros();
 
+  PrepareCompactionFilters();
+
   // Launch a thread for each of subcompactions 1...num_threads-1
   std::vector<std::thread> thread_pool;
   thread_pool.reserve(num_threads - 1);
@@ -623,11 +687,55 @@ Status CompactionJob::Install(const MutableCFOptions& mutable_cf_options) {
   return status;
 }
 
+void CompactionJob::PrepareCompactionFilters() {
+  auto* c = compact_->compaction;
+  ColumnFamilyData* cfd = c->column_family_data();
+  auto compaction_filter = cfd->ioptions()->compaction_filter;
+  if (compaction_filter == nullptr) {
+    // Filters of all subcompactions are created at once, so they use the same settings, e.g. the
+    // same history cutoff, and the first one could make decisions for the whole compaction.
+    auto filters = c->CreateCompactionFilters(compact_->sub_compact_states.size());
+    if (filters.empty()) {
+      return;
+    }
+    assert(filters.size() == compact_->sub_compact_states.size());
+    for (size_t i = 0; i < filters.size(); i++) {
+      compact_->sub_compact_states[i].compaction_filter = std::move(filters[i]);
+    }
+    compaction_filter = compact_->sub_compact_states.front().compaction_filter.get();
+  }
+  if (compaction_filter == nullptr) {
+    return;
+  }
+
+  // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
+  // filter.
+  largest_user_frontier_ = compaction_filter->GetLargestUserFrontier();
+
+  std::vector<FileMetaData*> inputs;
+  for (size_t i = 0; i < c->num_input_levels(); i++) {
+    const auto& level_inputs = *c->inputs(i);
+    inputs.insert(inputs.end(), level_inputs.begin(), level_inputs.end());
+  }
+  files_to_drop_ = compaction_filter->FilesToDrop(inputs);
+  if (!files_to_drop_.empty()) {
+    RLOG(InfoLogLevel::INFO_LEVEL, db_options_.info_log,
+        "[%s] [JOB %d] Dropping %" ROCKSDB_PRIszt " compaction input files without reading",
+        cfd->GetName().c_str(), job_id_, files_to_drop_.size());
+  }
+}
+
 void CompactionJob::ProcessKeyValueCompaction(
     FileNumbersHolder* holder, SubcompactionState* sub_compact) {
   assert(sub_compact != nullptr);
+  ColumnFamilyData* cfd = sub_compact->compaction->column_family_data();
+  auto compaction_filter = cfd->ioptions()->compaction_filter;
+  if (compaction_filter == nullptr) {
+    compaction_filter = sub_compact->compaction_filter.get();
+  }
+
   std::unique_ptr<InternalIterator> input(
-      versions_->MakeInputIterator(sub_compact->compaction));
+      versions_->MakeInputIterator(sub_compact->compaction, files_to_drop_));
 
   AutoThreadOperationStageUpdater stage_updater(
       ThreadStatus::STAGE_COMPACTION_PROCESS_KV);
@@ -648,21 +756,6 @@ void CompactionJob::ProcessKeyValueCompaction(
     prev_prepare_write_nanos = IOSTATS(prepare_write_nanos);
   }
 
-  ColumnFamilyData* cfd = sub_compact->compaction->column_family_data();
-  auto compaction_filter = cfd->ioptions()->compaction_filter;
-  std::unique_ptr<CompactionFilter> compaction_filter_from_factory = nullptr;
-  if (compaction_filter == nullptr) {
-    compaction_filter_from_factory =
-        sub_compact->compaction->CreateCompactionFilter();
-    compaction_filter = compaction_filter_from_factory.get();
-  }
-
-  if (compaction_filter) {
-    // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
-    // filter.
-    largest_user_frontier_ = compaction_filter->GetLargestUserFrontier();
-  }
-
   MergeHelper merge(
       env_, cfd->user_comparator(), cfd->ioptions()->merge_operator,
       compaction_filter, db_options_.info_log.get(),
@@ -1043,15 +1136,18 @@ Status CompactionJob::OpenCompactionOutputFile(
   ColumnFamilyData* cfd = sub_compact->compaction->column_family_data();
 
   {
-    auto setup_outfile = [this, sub_compact] (
+    // Only the first subcompaction runs on the thread of the compaction task, others run on
+    // their own threads and could not pause the task.
+    auto* suspender = sub_compact == &compact_->sub_compact_states.front()
+        ? sub_compact->compaction->suspender() : nullptr;
+    auto setup_outfile = [this, suspender] (
         size_t preallocation_block_size, std::unique_ptr<WritableFile>* writable_file,
         std::unique_ptr<WritableFileWriter>* writer) {
       (*writable_file)->SetIOPriority(Env::IO_LOW);
       if (preallocation_block_size > 0) {
         (*writable_file)->SetPreallocationBlockSize(preallocation_block_size);
       }
-      writer->reset(new WritableFileWriter(
-          std::move(*writable_file), env_options_, sub_compact->compaction->suspender()));
+      writer->reset(new WritableFileWriter(std::move(*writable_file), env_options_, suspender));
     };
 
     const bool is_split_sst = cfd->ioptions()->table_factory->IsSplitSstForWriteSupported();
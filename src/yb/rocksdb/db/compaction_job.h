@@ -110,10 +110,15 @@ class CompactionJob {
 
   void AggregateStatistics();
   void GenSubcompactionBoundaries();
+  // Adds keys sampled from indexes of specified level 0 files to sampled_keys_.
+  void SampleSubcompactionBoundaries(const LevelFilesBrief& flevel);
 
   // update the thread status for starting a compaction.
   void ReportStartedCompaction(Compaction* compaction);
   void AllocateCompactionOutputFileNumbers();
+  // Creates compaction filters for all subcompactions and selects input files that could be
+  // dropped without reading.
+  void PrepareCompactionFilters();
   // Call compaction filter. Then iterate through input and compact the
   // kv-pairs
   void ProcessKeyValueCompaction(FileNumbersHolder* holder, SubcompactionState* sub_compact);
@@ -181,12 +186,16 @@ class CompactionJob {
   bool bottommost_level_;
   bool paranoid_file_checks_;
   bool measure_io_stats_;
+  // Stores the keys sampled from indexes of input files, to be used as subcompaction boundaries
+  std::vector<std::string> sampled_keys_;
   // Stores the Slices that designate the boundaries for each subcompaction
   std::vector<Slice> boundaries_;
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
 
   UserFrontierPtr largest_user_frontier_;
+  // Input files that compaction filter decided to drop without reading.
+  std::vector<FileMetaData*> files_to_drop_;
 };
 
 }  // namespace rocksdb
@@ -1152,16 +1152,16 @@ bool UniversalCompactionPicker::NeedsCompaction(
 }
 
 struct UniversalCompactionPicker::SortedRun {
-  SortedRun(int _level, FileMetaData* _file, uint64_t _size,
+  SortedRun(int _level, std::vector<FileMetaData*> _files, uint64_t _size,
             uint64_t _compensated_file_size, bool _being_compacted)
       : level(_level),
-        file(_file),
+        files(std::move(_files)),
         size(_size),
         compensated_file_size(_compensated_file_size),
         being_compacted(_being_compacted) {
     assert(compensated_file_size > 0);
-    // Allowed either one of level and file.
-    assert((level != 0) != (file != nullptr));
+    // Allowed either one of level and files.
+    assert((level != 0) != !files.empty());
   }
 
   void Dump(char* out_buf, size_t out_buf_size,
@@ -1172,9 +1172,10 @@ struct UniversalCompactionPicker::SortedRun {
                     size_t sorted_run_count) const;
 
   int level;
-  // `file` Will be null for level > 0. For level = 0, the sorted run is
-  // for this file.
-  FileMetaData* file;
+  // `files` will be empty for level > 0. For level = 0, the sorted run is
+  // for these files, there are several of them only when they are outputs of
+  // a compaction split into subcompactions.
+  std::vector<FileMetaData*> files;
   // For level > 0, `size` and `compensated_file_size` are sum of sizes all
   // files in the level. `being_compacted` should be the same for all files
   // in a non-zero level. Use the value here.
@@ -1187,14 +1188,19 @@ void UniversalCompactionPicker::SortedRun::Dump(char* out_buf,
                                                 size_t out_buf_size,
                                                 bool print_path) const {
   if (level == 0) {
-    assert(file != nullptr);
+    assert(!files.empty());
+    const FileMetaData* file = files.front();
+    int written;
     if (file->fd.GetPathId() == 0 || !print_path) {
-      snprintf(out_buf, out_buf_size, "file %" PRIu64, file->fd.GetNumber());
+      written = snprintf(out_buf, out_buf_size, "file %" PRIu64, file->fd.GetNumber());
     } else {
-      snprintf(out_buf, out_buf_size, "file %" PRIu64
-                                      "(path "
-                                      "%" PRIu32 ")",
-               file->fd.GetNumber(), file->fd.GetPathId());
+      written = snprintf(out_buf, out_buf_size, "file %" PRIu64
+                                                "(path "
+                                                "%" PRIu32 ")",
+                         file->fd.GetNumber(), file->fd.GetPathId());
+    }
+    if (files.size() > 1 && written >= 0 && static_cast<size_t>(written) < out_buf_size) {
+      snprintf(out_buf + written, out_buf_size - written, "+%" ROCKSDB_PRIszt, files.size() - 1);
     }
   } else {
     snprintf(out_buf, out_buf_size, "level %d", level);
@@ -1204,13 +1210,13 @@ void UniversalCompactionPicker::SortedRun::Dump(char* out_buf,
 void UniversalCompactionPicker::SortedRun::DumpSizeInfo(
     char* out_buf, size_t out_buf_size, size_t sorted_run_count) const {
   if (level == 0) {
-    assert(file != nullptr);
+    assert(!files.empty());
     snprintf(out_buf, out_buf_size,
-             "file %" PRIu64 "[%" ROCKSDB_PRIszt
+             "file %" PRIu64 "+%" ROCKSDB_PRIszt "[%" ROCKSDB_PRIszt
              "] "
              "with size %" PRIu64 " (compensated size %" PRIu64 ")",
-             file->fd.GetNumber(), sorted_run_count, file->fd.GetTotalFileSize(),
-             file->compensated_file_size);
+             files.front()->fd.GetNumber(), files.size() - 1, sorted_run_count, size,
+             compensated_file_size);
   } else {
     snprintf(out_buf, out_buf_size,
              "level %d[%" ROCKSDB_PRIszt
@@ -1225,10 +1231,21 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
                                                    const ImmutableCFOptions& ioptions,
                                                    uint64_t max_file_size) {
   std::vector<std::vector<SortedRun>> ret(1);
-  for (FileMetaData* f : vstorage.LevelFiles(0)) {
-    if (f->fd.GetTotalFileSize() <= max_file_size) {
-      ret.back().emplace_back(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size,
-          f->being_compacted);
+  const auto& level0_files = vstorage.LevelFiles(0);
+  for (size_t i = 0; i < level0_files.size();) {
+    const size_t end = Level0SortedRunEnd(ioptions.comparator, level0_files, i);
+    std::vector<FileMetaData*> files(level0_files.begin() + i, level0_files.begin() + end);
+    i = end;
+    uint64_t size = 0;
+    uint64_t compensated_file_size = 0;
+    bool being_compacted = false;
+    for (auto* f : files) {
+      size += f->fd.GetTotalFileSize();
+      compensated_file_size += f->compensated_file_size;
+      being_compacted = being_compacted || f->being_compacted;
+    }
+    if (size <= max_file_size) {
+      ret.back().emplace_back(0, std::move(files), size, compensated_file_size, being_compacted);
     // If last sequence is empty it means that there are multiple too-large-to-compact files in
     // a row. So we just don't start new sequence in this case.
     } else if (!ret.back().empty()) {
@@ -1262,7 +1279,9 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
       }
     }
     if (total_compensated_size > 0) {
-      ret.back().emplace_back(level, nullptr, total_size, total_compensated_size, being_compacted);
+      ret.back().emplace_back(
+          level, std::vector<FileMetaData*>(), total_size, total_compensated_size,
+          being_compacted);
     }
   }
 
@@ -1455,14 +1474,21 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::DoPickCompaction(
 
   size_t level_index = 0U;
   if (c->start_level() == 0) {
-    for (auto f : *c->inputs(0)) {
-      DCHECK_LE(f->smallest.seqno, f->largest.seqno);
+    const auto& level0_inputs = *c->inputs(0);
+    for (size_t i = 0; i < level0_inputs.size();) {
+      // Files of the same sorted run could overlap in time, so sorted runs are checked instead.
+      const size_t end = Level0SortedRunEnd(icmp_->user_comparator(), level0_inputs, i);
+      std::vector<FileMetaData*> run(level0_inputs.begin() + i, level0_inputs.begin() + end);
+      i = end;
+      SequenceNumber smallest_seqno = 0U;
+      SequenceNumber largest_seqno = 0U;
+      GetSmallestLargestSeqno(run, &smallest_seqno, &largest_seqno);
       if (is_first) {
         is_first = false;
       } else {
-        DCHECK_GT(prev_smallest_seqno, f->largest.seqno);
+        DCHECK_GT(prev_smallest_seqno, largest_seqno);
       }
-      prev_smallest_seqno = f->smallest.seqno;
+      prev_smallest_seqno = smallest_seqno;
     }
     level_index = 1U;
   }
@@ -1692,8 +1718,8 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   for (size_t i = start_index; i < first_index_after; i++) {
     auto& picking_sr = sorted_runs[i];
     if (picking_sr.level == 0) {
-      FileMetaData* picking_file = picking_sr.file;
-      inputs[0].files.push_back(picking_file);
+      inputs[0].files.insert(
+          inputs[0].files.end(), picking_sr.files.begin(), picking_sr.files.end());
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -1818,8 +1844,8 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
   for (size_t loop = start_index; loop < sorted_runs.size(); loop++) {
     auto& picking_sr = sorted_runs[loop];
     if (picking_sr.level == 0) {
-      FileMetaData* f = picking_sr.file;
-      inputs[0].files.push_back(f);
+      inputs[0].files.insert(
+          inputs[0].files.end(), picking_sr.files.begin(), picking_sr.files.end());
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -24,8 +24,11 @@
 #include <gflags/gflags.h>
 #include "yb/rocksdb/db/db_test_util.h"
 #include "yb/rocksdb/port/stack_trace.h"
+#include "yb/util/scope_exit.h"
+#include "yb/util/threadpool.h"
 
 DECLARE_double(cache_single_touch_ratio);
+DECLARE_int32(rocksdb_async_readahead_blocks);
 
 namespace rocksdb {
 
@@ -250,6 +253,63 @@ TEST_F(DBBlockCacheTest, TestWithCompressedBlockCache) {
 }
 #endif
 
+TEST_F(DBBlockCacheTest, AsyncReadahead) {
+  constexpr int kNumKeys = 200;
+  constexpr int kReadaheadBlocks = 8;
+
+  google::FlagSaver flag_saver;
+  std::unique_ptr<yb::ThreadPool> readahead_pool;
+  ASSERT_OK(yb::ThreadPoolBuilder("sst-readahead").set_max_threads(2).Build(&readahead_pool));
+  // Tables wait for their readahead reads when they are closed, so the pool is shut down after.
+  auto se = yb::ScopeExit([this, &readahead_pool] {
+    Close();
+    readahead_pool->Shutdown();
+  });
+
+  auto table_options = GetTableOptions();
+  table_options.block_cache = NewLRUCache(64 * 1024 * 1024);
+  auto options = GetOptions(table_options);
+  Reopen(options);
+  std::string value(kValueSize, 'a');
+  for (int i = 0; i != kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(i), value));
+  }
+  ASSERT_OK(Flush());
+
+  // Start with empty block cache.
+  table_options.block_cache = NewLRUCache(64 * 1024 * 1024);
+  table_options.readahead_thread_pool = readahead_pool.get();
+  options.table_factory.reset(new BlockBasedTableFactory(table_options));
+  Reopen(options);
+
+  FLAGS_rocksdb_async_readahead_blocks = kReadaheadBlocks;
+
+  // Point lookups do not trigger readahead.
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    iter->Seek(Key(kNumKeys / 2));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(0U, TestGetTickerCount(options, ASYNC_READAHEAD_BLOCKS_SCHEDULED));
+  }
+
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    int num_keys = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_EQ(Key(num_keys), iter->key().ToString());
+      ++num_keys;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(kNumKeys, num_keys);
+  }
+
+  // Each block except the first few ones is scheduled once.
+  auto scheduled = TestGetTickerCount(options, ASYNC_READAHEAD_BLOCKS_SCHEDULED);
+  ASSERT_GT(scheduled, static_cast<uint64_t>(kNumKeys / 2));
+  ASSERT_LE(scheduled, static_cast<uint64_t>(kNumKeys));
+  ASSERT_LE(TestGetTickerCount(options, ASYNC_READAHEAD_BLOCKS_READ), scheduled);
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -23,6 +23,7 @@
 
 #include <atomic>
 
+#include "yb/rocksdb/db/db_impl.h"
 #include "yb/rocksdb/db/db_test_util.h"
 #include "yb/rocksdb/port/stack_trace.h"
 #include "yb/rocksdb/experimental.h"
@@ -34,6 +35,7 @@
 #include "yb/util/test_util.h"
 
 DECLARE_bool(flush_rocksdb_on_shutdown);
+DECLARE_int32(compaction_read_amp_reduction_max_extra_priority);
 
 using std::atomic;
 using namespace std::literals;
@@ -2773,6 +2775,25 @@ INSTANTIATE_TEST_CASE_P(
                       CompactionPri::kOldestSmallestSeqFirst,
                       CompactionPri::kMinOverlappingRatio));
 
+TEST(CompactionReadAmpReductionPriorityTest, Priority) {
+  constexpr uint64_t kGB = 1ULL << 30;
+  ASSERT_EQ(0, CompactionReadAmpReductionPriority(1, kGB / 1024));
+  ASSERT_EQ(0, CompactionReadAmpReductionPriority(2, 2 * kGB));
+  // 1 removed sorted run per GB.
+  ASSERT_EQ(0, CompactionReadAmpReductionPriority(2, kGB));
+  ASSERT_EQ(1, CompactionReadAmpReductionPriority(2, kGB / 2));
+  ASSERT_EQ(3, CompactionReadAmpReductionPriority(11, kGB));
+  // Limited by compaction_read_amp_reduction_max_extra_priority.
+  ASSERT_EQ(4, CompactionReadAmpReductionPriority(33, kGB));
+  ASSERT_EQ(4, CompactionReadAmpReductionPriority(2, 0));
+
+  google::FlagSaver flag_saver;
+  FLAGS_compaction_read_amp_reduction_max_extra_priority = 2;
+  ASSERT_EQ(2, CompactionReadAmpReductionPriority(11, kGB));
+  FLAGS_compaction_read_amp_reduction_max_extra_priority = 0;
+  ASSERT_EQ(0, CompactionReadAmpReductionPriority(11, kGB));
+}
+
 #endif // !defined(ROCKSDB_LITE)
 }  // namespace rocksdb
 
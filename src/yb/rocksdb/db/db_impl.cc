@@ -35,6 +35,7 @@
 
 #include <algorithm>
 #include <climits>
+#include <cmath>
 #include <cstdio>
 #include <map>
 #include <set>
@@ -93,6 +94,7 @@
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/merge_operator.h"
+#include "yb/rocksdb/rate_limiter.h"
 #include "yb/rocksdb/sst_file_writer.h"
 #include "yb/rocksdb/statistics.h"
 #include "yb/rocksdb/status.h"
@@ -154,6 +156,11 @@ DEFINE_int32(compaction_priority_step_size, 5,
 DEFINE_int32(small_compaction_extra_priority, 1,
              "Small compaction will get small_compaction_extra_priority extra priority.");
 
+DEFINE_int32(compaction_read_amp_reduction_max_extra_priority, 4,
+             "Compaction gets extra priority equal to the binary logarithm of the number of sorted "
+             "runs it removes per GB of input, but not more than this value. So compactions that "
+             "reduce read amplification at the lowest cost are picked first across all tablets.");
+
 namespace rocksdb {
 
 namespace {
@@ -183,6 +190,21 @@ void ClearCompactionQueue(std::deque<std::unique_ptr<Compaction>>* queue) {
 
 } // namespace
 
+int CompactionReadAmpReductionPriority(size_t num_input_files, uint64_t input_size) {
+  if (FLAGS_compaction_read_amp_reduction_max_extra_priority <= 0 || num_input_files <= 1) {
+    return 0;
+  }
+  constexpr double kGB = 1ULL << 30;
+  const double removed_runs_per_gb =
+      (num_input_files - 1) * kGB / std::max<uint64_t>(input_size, 1);
+  if (removed_runs_per_gb < 1) {
+    return 0;
+  }
+  return std::min(
+      static_cast<int>(std::log2(removed_runs_per_gb)),
+      FLAGS_compaction_read_amp_reduction_max_extra_priority);
+}
+
 const char kDefaultColumnFamilyName[] = "default";
 
 struct DBImpl::WriteContext {
@@ -238,26 +260,55 @@ class DBImpl::ThreadPoolTask : public yb::PriorityThreadPoolTask {
 constexpr int kShuttingDownPriority = 200;
 constexpr int kFlushPriority = 100;
 
-class DBImpl::CompactionTask : public ThreadPoolTask {
+// Compaction task also acts as suspender for its compaction, so it could update own priority
+// before compaction checks whether it should be paused.
+class DBImpl::CompactionTask : public ThreadPoolTask, public yb::PriorityThreadPoolSuspender {
  public:
   CompactionTask(DBImpl* db_impl, DBImpl::ManualCompaction* manual_compaction)
       : ThreadPoolTask(db_impl), manual_compaction_(manual_compaction),
-        compaction_(manual_compaction->compaction.get()), priority_(CalcPriority()) {
+        compaction_(manual_compaction->compaction.get()),
+        num_input_files_(CalcNumInputFiles()),
+        input_size_(compaction_->CalculateTotalInputSize()),
+        priority_(CalcPriority()) {
     db_impl->mutex_.AssertHeld();
   }
 
   CompactionTask(DBImpl* db_impl, std::unique_ptr<Compaction> compaction)
       : ThreadPoolTask(db_impl), manual_compaction_(nullptr),
         compaction_holder_(std::move(compaction)), compaction_(compaction_holder_.get()),
+        num_input_files_(CalcNumInputFiles()),
+        input_size_(compaction_->CalculateTotalInputSize()),
         priority_(CalcPriority()) {
     db_impl->mutex_.AssertHeld();
   }
 
   void DoRun(yb::PriorityThreadPoolSuspender* suspender) override {
-    compaction_->SetSuspender(suspender);
+    suspender_ = suspender;
+    compaction_->SetSuspender(this);
     db_impl_->BackgroundCallCompaction(manual_compaction_, std::move(compaction_holder_), this);
   }
 
+  // Invoked by compaction before requesting tokens from the rate limiter. When the rate limiter is
+  // saturated, for instance by compactions of other tablets in the same data directory, the task
+  // gets the lowest priority, so it is paused in favor of waiting tasks instead of blocking the
+  // thread in the rate limiter.
+  void PauseIfNecessary() override {
+    if (IsRateLimited() != rate_limited_.load(std::memory_order_acquire)) {
+      bool updated;
+      int new_priority;
+      {
+        InstrumentedMutexLock lock(&db_impl_->mutex_);
+        updated = UpdatePriority();
+        new_priority = priority_;
+      }
+      if (updated) {
+        db_impl_->db_options_.priority_thread_pool_for_compactions_and_flushes->ChangeTaskPriority(
+            SerialNo(), new_priority);
+      }
+    }
+    suspender_->PauseIfNecessary();
+  }
+
   void AbortedUnlocked() override {
     db_impl_->mutex_.AssertHeld();
     auto cfd = compaction_->column_family_data();
@@ -276,7 +327,9 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
   }
 
   std::string ToString() const override {
-    return yb::Format("{ compact db: $0 }", db_impl_->GetName());
+    return yb::Format(
+        "{ compact db: $0 manual: $1 input_files: $2 input_size: $3 }",
+        db_impl_->GetName(), manual_compaction_ != nullptr, num_input_files_, input_size_);
   }
 
   bool UpdatePriority() override {
@@ -287,6 +340,9 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
       return false;
     }
 
+    // The task could be paused, so it does not check the rate limiter itself. Check it here, so
+    // the task does not keep the lowest priority after the rate limiter is no longer saturated.
+    rate_limited_.store(IsRateLimited(), std::memory_order_release);
     auto new_priority = CalcPriority();
     if (new_priority != priority_) {
       priority_ = new_priority;
@@ -312,6 +368,12 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
       return kShuttingDownPriority;
     }
 
+    // Writes of this compaction would wait for the rate limiter, so let compactions that are not
+    // limited by it, e.g. of tablets in other data directories, go first.
+    if (rate_limited_.load(std::memory_order_acquire)) {
+      return 0;
+    }
+
     auto* current_version = compaction_->column_family_data()->GetSuperVersion()->current;
     auto num_files = current_version->storage_info()->l0_delay_trigger_count();
 
@@ -326,6 +388,23 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
       result += FLAGS_small_compaction_extra_priority;
     }
 
+    // Compaction replaces its input files with a single sorted run, so point reads have to check
+    // num_input_files_ - 1 fewer files after it.
+    result += CompactionReadAmpReductionPriority(num_input_files_, input_size_);
+
+    return result;
+  }
+
+  bool IsRateLimited() const {
+    auto* rate_limiter = db_impl_->db_options_.rate_limiter.get();
+    return rate_limiter && rate_limiter->IsSaturated();
+  }
+
+  size_t CalcNumInputFiles() const {
+    size_t result = 0;
+    for (size_t i = 0; i != compaction_->num_input_levels(); ++i) {
+      result += compaction_->num_input_files(i);
+    }
     return result;
   }
 
@@ -333,7 +412,13 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
   DBImpl::ManualCompaction* const manual_compaction_;
   std::unique_ptr<Compaction> compaction_holder_;
   Compaction* compaction_;
+  const size_t num_input_files_;
+  const uint64_t input_size_;
+  // Whether the last rate limiter check found it saturated. Updated under the mutex by
+  // UpdatePriority.
+  std::atomic<bool> rate_limited_{false};
   int priority_;
+  yb::PriorityThreadPoolSuspender* suspender_ = nullptr;
 };
 
 class DBImpl::FlushTask : public ThreadPoolTask {
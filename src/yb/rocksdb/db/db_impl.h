@@ -1036,6 +1036,11 @@ extern Options SanitizeOptions(const std::string& db,
                                const Options& src);
 extern DBOptions SanitizeOptions(const std::string& db, const DBOptions& src);
 
+// Returns extra priority of compaction that replaces num_input_files files of input_size total
+// size with a single sorted run. It is the binary logarithm of the number of removed sorted runs per
+// GB of input, limited by compaction_read_amp_reduction_max_extra_priority.
+int CompactionReadAmpReductionPriority(size_t num_input_files, uint64_t input_size);
+
 // Fix user-supplied options to be reasonable
 template <class T, class V>
 static void ClipToRange(T* ptr, V minvalue, V maxvalue) {
@@ -25,6 +25,8 @@
 #include "yb/rocksdb/port/stack_trace.h"
 #if !defined(ROCKSDB_LITE)
 #include "yb/rocksdb/util/sync_point.h"
+#include "yb/util/priority_thread_pool.h"
+#include "yb/util/scope_exit.h"
 
 namespace rocksdb {
 
@@ -1350,6 +1352,9 @@ class DBTestUniversalCompaction : public DBTestBase {
   void GenerateFilesAndCheckCompactionResult(
       const Options& options, const std::vector<size_t>& keys_per_file, int value_size,
       int num_output_files);
+  // Compacts files that cover the whole key range using subcompactions. When thread_pool is
+  // specified, compactions run as its tasks.
+  void CheckSingleLevelSubcompactions(yb::PriorityThreadPool* thread_pool);
 };
 
 void DBTestUniversalCompaction::GenerateFilesAndCheckCompactionResult(
@@ -1474,6 +1479,79 @@ TEST_F(DBTestUniversalCompaction, IncludeFilesSmallerThanThreshold) {
   GenerateFilesAndCheckCompactionResult(options, file_sizes, value_size, 1);
 }
 
+void DBTestUniversalCompaction::CheckSingleLevelSubcompactions(
+    yb::PriorityThreadPool* thread_pool) {
+  const int kNumFiles = 4;
+  const int kKeysPerFile = 2000;
+  Options options;
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.write_buffer_size = 100_MB;
+  options.disable_auto_compactions = true;
+  options.max_subcompactions = 4;
+  options.compaction_size_threshold_bytes = 1;
+  options.priority_thread_pool_for_compactions_and_flushes = thread_pool;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1_KB;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  options = CurrentOptions(options);
+  DestroyAndReopen(options);
+
+  // Each file covers the whole key range, so boundaries of subcompactions could only be found in
+  // the indexes of the files.
+  Random rnd(301);
+  for (int num = 0; num < kNumFiles; num++) {
+    for (int i = num; i < kKeysPerFile * kNumFiles; i += kNumFiles) {
+      ASSERT_OK(Put(Key(i), RandomString(&rnd, 100)));
+    }
+    ASSERT_OK(Put(Key(0), Key(num)));
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(NumTableFilesAtLevel(0), kNumFiles);
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  ASSERT_GT(files.size(), 1U);
+  std::sort(files.begin(), files.end(),
+            [](const LiveFileMetaData& lhs, const LiveFileMetaData& rhs) {
+    return lhs.smallest.key < rhs.smallest.key;
+  });
+  for (size_t i = 1; i < files.size(); i++) {
+    ASSERT_LT(files[i - 1].largest.key, files[i].smallest.key);
+  }
+
+  ASSERT_EQ(Get(Key(0)), Key(kNumFiles - 1));
+  for (int i = 1; i < kKeysPerFile * kNumFiles; i++) {
+    ASSERT_NE(Get(Key(i)), "NOT_FOUND");
+  }
+
+  // Outputs of subcompactions form a single sorted run, so they should not trigger another
+  // compaction.
+  ASSERT_OK(dbfull()->SetOptions({
+      {"level0_file_num_compaction_trigger", "2"},
+      {"disable_auto_compactions", "false"},
+  }));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ(NumTableFilesAtLevel(0), static_cast<int>(files.size()));
+}
+
+TEST_F(DBTestUniversalCompaction, SingleLevelSubcompactions) {
+  CheckSingleLevelSubcompactions(nullptr /* thread_pool */);
+}
+
+// Only the first subcompaction runs on the worker thread of the pool, others should not try to
+// pause the task.
+TEST_F(DBTestUniversalCompaction, SingleLevelSubcompactionsInPriorityThreadPool) {
+  yb::PriorityThreadPool thread_pool(2);
+  auto se = yb::ScopeExit([this, &thread_pool] {
+    Close();
+    thread_pool.Shutdown();
+  });
+  CheckSingleLevelSubcompactions(&thread_pool);
+}
+
 }  // namespace rocksdb
 
 #endif  // !defined(ROCKSDB_LITE)
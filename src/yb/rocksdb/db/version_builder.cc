@@ -137,6 +137,24 @@ class VersionBuilder::Rep {
   void CheckConsistency(VersionStorageInfo* vstorage) {
 #ifndef NDEBUG
     // make sure the files are sorted correctly
+    const auto& level0_files = vstorage->LevelFiles(0);
+    for (size_t i = 0; i < level0_files.size();) {
+      // Files of the same sorted run do not overlap in key range, so only sorted runs should be
+      // ordered by sequence numbers.
+      const size_t end = Level0SortedRunEnd(
+          vstorage->InternalComparator()->user_comparator(), level0_files, i);
+      SequenceNumber run_smallest_seqno = level0_files[i]->smallest.seqno;
+      for (; i < end; ++i) {
+        run_smallest_seqno = std::min(run_smallest_seqno, level0_files[i]->smallest.seqno);
+      }
+      if (end < level0_files.size()) {
+        auto f = level0_files[end];
+        assert(run_smallest_seqno > f->largest.seqno ||
+               // We can have multiple files with seqno = 0 as a result of
+               // using DB::AddFile()
+               (run_smallest_seqno == 0 && f->largest.seqno == 0));
+      }
+    }
     for (int level = 0; level < vstorage->num_levels(); level++) {
       auto& level_files = vstorage->LevelFiles(level);
       for (size_t i = 1; i < level_files.size(); i++) {
@@ -144,10 +162,6 @@ class VersionBuilder::Rep {
         auto f2 = level_files[i];
         if (level == 0) {
           assert(level_zero_cmp_(f1, f2));
-          assert(f1->largest.seqno > f2->largest.seqno ||
-                 // We can have multiple files with seqno = 0 as a result of
-                 // using DB::AddFile()
-                 (f1->largest.seqno == 0 && f2->largest.seqno == 0));
         } else {
           assert(level_nonzero_cmp_(f1, f2));
 
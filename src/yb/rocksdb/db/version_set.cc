@@ -384,6 +384,33 @@ void DoGenerateLevelFilesBrief(LevelFilesBrief* file_level,
   }
 }
 
+size_t Level0SortedRunEnd(const Comparator* user_comparator,
+                          const std::vector<FileMetaData*>& files,
+                          size_t begin) {
+  assert(begin < files.size());
+  SequenceNumber run_smallest_seqno = files[begin]->smallest.seqno;
+  size_t end = begin + 1;
+  for (; end < files.size(); ++end) {
+    const FileMetaData* f = files[end];
+    // Files of different sorted runs do not overlap in sequence numbers.
+    if (f->largest.seqno < run_smallest_seqno) {
+      break;
+    }
+    bool overlaps = false;
+    for (size_t i = begin; i < end && !overlaps; ++i) {
+      overlaps = user_comparator->Compare(
+                     f->largest.key.user_key(), files[i]->smallest.key.user_key()) >= 0 &&
+                 user_comparator->Compare(
+                     files[i]->largest.key.user_key(), f->smallest.key.user_key()) >= 0;
+    }
+    if (overlaps) {
+      break;
+    }
+    run_smallest_seqno = std::min(run_smallest_seqno, f->smallest.seqno);
+  }
+  return end;
+}
+
 static bool AfterFile(const Comparator* ucmp,
                       const Slice* user_key, const FdWithBoundaries* f) {
   // nullptr user_key occurs before all keys and is therefore never after *f
@@ -1245,8 +1272,14 @@ void VersionStorageInfo::ComputeCompactionScore(
       for (auto* f : files_[level]) {
         if (!f->being_compacted) {
           total_size += f->compensated_file_size;
+        }
+      }
+      for (size_t i = 0; i < files_[level].size();) {
+        // All files of the sorted run are compacted together.
+        if (!files_[level][i]->being_compacted) {
           num_sorted_runs++;
         }
+        i = Level0SortedRunEnd(user_comparator_, files_[level], i);
       }
       if (compaction_style_ == kCompactionStyleUniversal) {
         // For universal compaction, we use level0 score to indicate
@@ -1879,13 +1912,14 @@ void VersionStorageInfo::CalculateBaseBytes(const ImmutableCFOptions& ioptions,
   // Special logic to set number of sorted runs.
   // It is to match the previous behavior when all files are in L0.
   int num_l0_count = 0;
-  if (options.max_file_size_for_compaction == std::numeric_limits<uint64_t>::max()) {
-    num_l0_count = static_cast<int>(files_[0].size());
-  } else {
-    for (const auto& file : files_[0]) {
-      if (file->fd.GetTotalFileSize() <= options.max_file_size_for_compaction) {
-        ++num_l0_count;
-      }
+  for (size_t i = 0; i < files_[0].size();) {
+    const size_t end = Level0SortedRunEnd(user_comparator_, files_[0], i);
+    uint64_t run_size = 0;
+    for (; i < end; ++i) {
+      run_size += files_[0][i]->fd.GetTotalFileSize();
+    }
+    if (run_size <= options.max_file_size_for_compaction) {
+      ++num_l0_count;
     }
   }
   if (compaction_style_ == kCompactionStyleUniversal) {
@@ -3524,7 +3558,8 @@ void VersionSet::AddLiveFiles(std::vector<FileDescriptor>* live_list) {
   }
 }
 
-InternalIterator* VersionSet::MakeInputIterator(Compaction* c) {
+InternalIterator* VersionSet::MakeInputIterator(
+    Compaction* c, const std::vector<FileMetaData*>& files_to_skip) {
   auto cfd = c->column_family_data();
   ReadOptions read_options;
   read_options.verify_checksums =
@@ -3546,7 +3581,12 @@ InternalIterator* VersionSet::MakeInputIterator(Compaction* c) {
     if (c->input_levels(which)->num_files != 0) {
       if (c->level(which) == 0) {
         const LevelFilesBrief* flevel = c->input_levels(which);
+        const auto& files = *c->inputs(which);
         for (size_t i = 0; i < flevel->num_files; i++) {
+          if (std::find(files_to_skip.begin(), files_to_skip.end(), files[i]) !=
+                  files_to_skip.end()) {
+            continue;
+          }
           list[num++] = cfd->table_cache()->NewIterator(
               read_options, env_options_compactions_,
               cfd->internal_comparator(), flevel->files[i].fd, nullptr,
@@ -106,6 +106,14 @@ extern void DoGenerateLevelFilesBrief(LevelFilesBrief* file_level,
                                       const std::vector<FileMetaData*>& files,
                                       Arena* arena);
 
+// Level 0 files are sorted from newest to oldest. Output files of a compaction split into
+// subcompactions do not overlap in key range, but could overlap in sequence numbers, so together
+// they form a single sorted run.
+// Returns the index after the last file of the level 0 sorted run that starts at files[begin].
+extern size_t Level0SortedRunEnd(const Comparator* user_comparator,
+                                 const std::vector<FileMetaData*>& files,
+                                 size_t begin);
+
 class VersionStorageInfo {
  public:
   VersionStorageInfo(const InternalKeyComparatorPtr& internal_comparator,
@@ -712,9 +720,11 @@ class VersionSet {
     return min_log_num;
   }
 
-  // Create an iterator that reads over the compaction inputs for "*c".
+  // Create an iterator that reads over the compaction inputs for "*c", except level-0 files
+  // listed in files_to_skip.
   // The caller should delete the iterator when no longer needed.
-  InternalIterator* MakeInputIterator(Compaction* c);
+  InternalIterator* MakeInputIterator(
+      Compaction* c, const std::vector<FileMetaData*>& files_to_skip = {});
 
   // Add all files listed in any live version to *live.
   void AddLiveFiles(std::vector<FileDescriptor>* live_list);
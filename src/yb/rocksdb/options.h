@@ -46,6 +46,7 @@ namespace yb {
 
 class MemTracker;
 class PriorityThreadPool;
+class ThreadPool;
 
 }
 
@@ -50,6 +50,10 @@ class RateLimiter {
   // Total # of requests that go though rate limiter
   virtual int64_t GetTotalRequests(
       const Env::IOPriority pri = Env::IO_TOTAL) const = 0;
+
+  // Whether there are requests waiting for tokens, so new request would be
+  // blocked as well.
+  virtual bool IsSaturated() const = 0;
 };
 
 // Create a RateLimiter object, which can be shared among RocksDB instances to
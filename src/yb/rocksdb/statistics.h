@@ -207,6 +207,14 @@ enum Tickers : uint32_t {
   BLOCK_CACHE_MULTI_TOUCH_BYTES_READ,
   BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE,
 
+  // Number of data blocks scheduled for asynchronous readahead of forward scans.
+  ASYNC_READAHEAD_BLOCKS_SCHEDULED,
+  // Number of data blocks read from files by asynchronous readahead, i.e. that were not cached.
+  ASYNC_READAHEAD_BLOCKS_READ,
+
+  // Number of entries that were not added to block cache by the frequency admission policy.
+  BLOCK_CACHE_ADMISSION_REJECTS,
+
   // End of ticker enum.
   TICKER_ENUM_MAX,
 };
@@ -311,7 +319,10 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
     {BLOCK_CACHE_MULTI_TOUCH_HIT, "rocksdb_block_cache_multi_touch_hit"},
     {BLOCK_CACHE_MULTI_TOUCH_ADD, "rocksdb_block_cache_multi_touch_add"},
     {BLOCK_CACHE_MULTI_TOUCH_BYTES_READ, "rocksdb_block_cache_multi_touch_bytes_read"},
-    {BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE, "rocksdb_block_cache_multi_touch_bytes_write"}
+    {BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE, "rocksdb_block_cache_multi_touch_bytes_write"},
+    {ASYNC_READAHEAD_BLOCKS_SCHEDULED, "rocksdb_async_readahead_blocks_scheduled"},
+    {ASYNC_READAHEAD_BLOCKS_READ, "rocksdb_async_readahead_blocks_read"},
+    {BLOCK_CACHE_ADMISSION_REJECTS, "rocksdb_block_cache_admission_rejects"}
 };
 
 /**
@@ -122,6 +122,11 @@ struct BlockBasedTableOptions {
   // If NULL, rocksdb will not use a compressed block cache.
   std::shared_ptr<Cache> block_cache_compressed = nullptr;
 
+  // If non-NULL, data blocks are read into the block cache ahead of forward scans using this
+  // thread pool, see rocksdb_async_readahead_blocks. Not owned, should be shut down only after
+  // all tables that use it are closed.
+  yb::ThreadPool* readahead_thread_pool = nullptr;
+
   // Approximate size of user data packed per block, in bytes. Note that the
   // block size specified here corresponds to uncompressed data.  The
   // actual size of the unit read from disk may be smaller if
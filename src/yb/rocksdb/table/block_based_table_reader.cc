@@ -23,6 +23,7 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <condition_variable>
 #include <string>
 #include <utility>
 #include <cinttypes>
@@ -64,7 +65,16 @@
 #include "yb/gutil/macros.h"
 #include "yb/util/logging.h"
 #include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/threadpool.h"
+
+DEFINE_int32(rocksdb_async_readahead_blocks, 0,
+             "Number of data blocks that are read into the block cache ahead of a forward scan, "
+             "after the scan has sequentially read a few blocks of the SST file. "
+             "0 disables asynchronous readahead.");
+TAG_FLAG(rocksdb_async_readahead_blocks, advanced);
+TAG_FLAG(rocksdb_async_readahead_blocks, runtime);
 
 namespace rocksdb {
 
@@ -77,6 +87,10 @@ typedef FilterPolicy::FilterType FilterType;
 
 namespace {
 
+// Number of blocks that forward scan should enter sequentially before readahead is started, so
+// point lookups and short scans do not trigger it.
+constexpr size_t kMinSequentialBlocksForReadahead = 2;
+
 // Delete the resource that is held by the iterator.
 template <class ResourceType>
 void DeleteHeldResource(void* arg, void* ignored) {
@@ -237,6 +251,12 @@ struct BlockBasedTable::Rep {
   unique_ptr<SliceTransform> internal_prefix_transform;
   DataIndexLoadMode data_index_load_mode;
   yb::MemTrackerPtr mem_tracker;
+
+  // Number of scheduled readahead reads of data blocks, table is destroyed after all of them
+  // are finished.
+  std::mutex readahead_mutex;
+  std::condition_variable readahead_cond;
+  size_t pending_readaheads = 0;
 };
 
 // BlockEntryIteratorState doesn't actually store any iterator state and is only used as an adapter
@@ -251,7 +271,9 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
         table_(table),
         read_options_(read_options),
         skip_filters_(skip_filters),
-        block_type_(block_type) {}
+        block_type_(block_type) {
+    comparator = table->rep_->comparator.get();
+  }
 
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
     return table_->NewDataBlockIterator(read_options_, index_value, block_type_);
@@ -264,6 +286,42 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
     return table_->PrefixMayMatch(internal_key);
   }
 
+  // Keeps up to rocksdb_async_readahead_blocks data blocks after the current one scheduled for
+  // reading into the block cache, while the scan moves forward block by block. A separate index
+  // iterator tracks the last block that was scheduled.
+  void ForwardBlockEntered(const Slice& first_level_key, size_t sequential_blocks) override {
+    const size_t readahead_blocks = std::max(FLAGS_rocksdb_async_readahead_blocks, 0);
+    if (block_type_ != BlockType::kData || readahead_blocks == 0 || !read_options_.fill_cache ||
+        read_options_.read_tier == kBlockCacheTier ||
+        table_->rep_->table_options.readahead_thread_pool == nullptr) {
+      return;
+    }
+    if (sequential_blocks < kMinSequentialBlocksForReadahead) {
+      readahead_iter_.reset();
+      return;
+    }
+    if (!readahead_iter_) {
+      readahead_iter_.reset(table_->NewIndexIterator(read_options_));
+      readahead_iter_->Seek(first_level_key);
+      if (readahead_iter_->Valid()) {
+        readahead_iter_->Next();
+      }
+      blocks_ahead_ = 0;
+    } else if (blocks_ahead_ > 0) {
+      --blocks_ahead_;
+    }
+    // Schedule blocks in batches, so readahead reads are not interleaved with scan reads one by
+    // one.
+    if (blocks_ahead_ > readahead_blocks / 2) {
+      return;
+    }
+    while (blocks_ahead_ < readahead_blocks && readahead_iter_->Valid()) {
+      table_->ScheduleDataBlockReadahead(read_options_, readahead_iter_->value());
+      readahead_iter_->Next();
+      ++blocks_ahead_;
+    }
+  }
+
  private:
   // Don't own table_. BlockEntryIteratorState should only be stored in iterators or in
   // corresponding BlockBasedTable. TableReader (superclass of BlockBasedTable) is only destroyed
@@ -272,6 +330,11 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   const ReadOptions read_options_;
   const bool skip_filters_;
   const BlockType block_type_;
+
+  // Index iterator positioned after the last block scheduled for readahead.
+  std::unique_ptr<InternalIterator> readahead_iter_;
+  // Number of blocks scheduled for readahead after the current block of the scan.
+  size_t blocks_ahead_ = 0;
 };
 
 
@@ -290,6 +353,10 @@ class BlockBasedTable::IndexIteratorHolder {
 };
 
 BlockBasedTable::~BlockBasedTable() {
+  {
+    std::unique_lock<std::mutex> lock(rep_->readahead_mutex);
+    rep_->readahead_cond.wait(lock, [this] { return rep_->pending_readaheads == 0; });
+  }
   delete rep_;
 }
 
@@ -1201,6 +1268,81 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   return iter;
 }
 
+void BlockBasedTable::ScheduleDataBlockReadahead(
+    const ReadOptions& read_options, const Slice& index_value) {
+  BlockHandle handle;
+  Slice input = index_value;
+  if (!handle.DecodeFrom(&input).ok()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(rep_->readahead_mutex);
+    ++rep_->pending_readaheads;
+  }
+  auto status = rep_->table_options.readahead_thread_pool->SubmitFunc(
+      [this, read_options, handle] {
+        ReadDataBlockToCache(read_options, handle);
+        std::lock_guard<std::mutex> lock(rep_->readahead_mutex);
+        if (--rep_->pending_readaheads == 0) {
+          rep_->readahead_cond.notify_all();
+        }
+      });
+  if (!status.ok()) {
+    std::lock_guard<std::mutex> lock(rep_->readahead_mutex);
+    --rep_->pending_readaheads;
+    return;
+  }
+  RecordTick(rep_->ioptions.statistics, ASYNC_READAHEAD_BLOCKS_SCHEDULED);
+}
+
+void BlockBasedTable::ReadDataBlockToCache(
+    const ReadOptions& read_options, const BlockHandle& handle) {
+  Cache* block_cache = rep_->table_options.block_cache.get();
+  Cache* block_cache_compressed = rep_->table_options.block_cache_compressed.get();
+  if (block_cache == nullptr && block_cache_compressed == nullptr) {
+    return;
+  }
+
+  FileReaderWithCachePrefix* reader = GetBlockReader(BlockType::kData);
+  Statistics* statistics = rep_->ioptions.statistics;
+  char cache_key[block_based_table::kCacheKeyBufferSize];
+  char compressed_cache_key[block_based_table::kCacheKeyBufferSize];
+  Slice key, ckey;
+  if (block_cache != nullptr) {
+    key = GetCacheKey(reader->cache_key_prefix, handle, cache_key);
+  }
+  if (block_cache_compressed != nullptr) {
+    ckey = GetCacheKey(reader->compressed_cache_key_prefix, handle, compressed_cache_key);
+  }
+
+  CachableEntry<Block> block;
+  Status s = GetDataBlockFromCache(
+      key, ckey, block_cache, block_cache_compressed, statistics, read_options, &block,
+      rep_->table_options.format_version, BlockType::kData, rep_->mem_tracker);
+  if (s.ok() && block.value == nullptr) {
+    std::unique_ptr<Block> raw_block;
+    s = block_based_table::ReadBlockFromFile(
+        reader->reader.get(), rep_->footer, read_options, handle, &raw_block, rep_->ioptions.env,
+        rep_->mem_tracker, block_cache_compressed == nullptr);
+    if (s.ok()) {
+      RecordTick(statistics, ASYNC_READAHEAD_BLOCKS_READ);
+      s = PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed, read_options,
+                              statistics, &block, raw_block.release(),
+                              rep_->table_options.format_version, rep_->mem_tracker);
+    }
+  }
+  if (!s.ok()) {
+    VLOG(1) << "Readahead of block " << handle.ToString() << " failed: " << s.ToString();
+  }
+
+  // Block is not used by readahead itself, it just stays in the cache for the scan.
+  if (block.cache_handle != nullptr) {
+    block.Release(block_cache);
+  } else {
+    delete block.value;
+  }
+}
+
 // This will be broken if the user specifies an unusual implementation
 // of Options.comparator, or if the user specifies an unusual
 // definition of prefixes in BlockBasedTableOptions.filter_policy.
@@ -1613,6 +1755,25 @@ uint64_t BlockBasedTable::ApproximateOffsetOf(const Slice& key) {
   return result;
 }
 
+std::vector<std::string> BlockBasedTable::SampleKeys(size_t max_keys) {
+  std::vector<std::string> result;
+  if (max_keys == 0) {
+    return result;
+  }
+  unique_ptr<InternalIterator> index_iter(NewIndexIterator(ReadOptions::kDefault));
+  const uint64_t num_data_blocks =
+      rep_->table_properties ? rep_->table_properties->num_data_blocks : 0;
+  const uint64_t step = std::max<uint64_t>(num_data_blocks / (max_keys + 1), 1);
+  uint64_t block_index = 0;
+  for (index_iter->SeekToFirst(); index_iter->Valid() && result.size() < max_keys;
+       index_iter->Next()) {
+    if (++block_index % step == 0) {
+      result.push_back(index_iter->key().ToBuffer());
+    }
+  }
+  return result;
+}
+
 bool BlockBasedTable::TEST_filter_block_preloaded() const {
   return rep_->filter != nullptr;
 }
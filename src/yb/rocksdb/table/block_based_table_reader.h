@@ -163,6 +163,9 @@ class BlockBasedTable : public TableReader {
   // be close to the file length.
   uint64_t ApproximateOffsetOf(const Slice& key) override;
 
+  // Returns keys from the data index, so each part contains about the same number of data blocks.
+  std::vector<std::string> SampleKeys(size_t max_keys) override;
+
   // Returns true if the block for the specified key is in cache.
   // REQUIRES: key is in this table && block cache enabled
   bool TEST_KeyInCache(const ReadOptions& options, const Slice& key);
@@ -183,6 +186,10 @@ class BlockBasedTable : public TableReader {
       const ReadOptions& ro, const Slice& index_value, BlockType block_type,
       BlockIter* input_iter = nullptr);
 
+  // Asynchronously reads data block with the specified encoded handle into the block cache, if
+  // it is not there yet. Used for readahead of sequential forward scans.
+  void ScheduleDataBlockReadahead(const ReadOptions& read_options, const Slice& index_value);
+
   const ImmutableCFOptions& ioptions();
 
   ~BlockBasedTable();
@@ -199,6 +206,8 @@ class BlockBasedTable : public TableReader {
   struct Rep;
   Rep* rep_;
 
+  void ReadDataBlockToCache(const ReadOptions& read_options, const BlockHandle& handle);
+
   class BlockEntryIteratorState;
   class IndexIteratorHolder;
 
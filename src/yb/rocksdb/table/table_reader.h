@@ -25,6 +25,8 @@
 #define ROCKSDB_TABLE_TABLE_READER_H
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "yb/util/slice.h"
 
@@ -72,6 +74,13 @@ class TableReader {
   // be close to the file length.
   virtual uint64_t ApproximateOffsetOf(const Slice& key) = 0;
 
+  // Returns up to max_keys internal keys that split the table into parts with approximately the
+  // same size. Used to split compaction into subcompactions. Default implementation returns no
+  // keys.
+  virtual std::vector<std::string> SampleKeys(size_t max_keys) {
+    return std::vector<std::string>();
+  }
+
   // Set up the table for Compaction. Might change some parameters with
   // posix_fadvise
   virtual void SetupForCompaction() = 0;
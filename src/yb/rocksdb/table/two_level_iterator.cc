@@ -23,6 +23,7 @@
 
 #include "yb/rocksdb/table/two_level_iterator.h"
 
+#include "yb/rocksdb/comparator.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table/block.h"
@@ -89,6 +90,7 @@ class TwoLevelIterator : public InternalIterator {
   void SaveError(const Status& s) {
     if (status_.ok() && !s.ok()) status_ = s;
   }
+  bool SeekInCurrentDataBlock(const Slice& target);
   void SkipEmptyDataBlocksForward();
   void SkipEmptyDataBlocksBackward();
   void SetSecondLevelIterator(InternalIterator* iter);
@@ -102,6 +104,8 @@ class TwoLevelIterator : public InternalIterator {
   // If second_level_iter is non-nullptr, then "data_block_handle_" holds the
   // "index_value" passed to block_function_ to create the second_level_iter.
   std::string data_block_handle_;
+  // Number of blocks entered by forward iteration since the last seek.
+  size_t sequential_blocks_ = 0;
 };
 
 TwoLevelIterator::TwoLevelIterator(TwoLevelIteratorState* state,
@@ -117,6 +121,10 @@ void TwoLevelIterator::Seek(const Slice& target) {
     SetSecondLevelIterator(nullptr);
     return;
   }
+  if (SeekInCurrentDataBlock(target)) {
+    return;
+  }
+  sequential_blocks_ = 0;
   first_level_iter_.Seek(target);
 
   InitDataBlock();
@@ -126,7 +134,28 @@ void TwoLevelIterator::Seek(const Slice& target) {
   SkipEmptyDataBlocksForward();
 }
 
+// Point lookups of sorted keys through the same iterator often target the data block where the
+// iterator is already positioned. If target is not before the current key and not after the
+// first level key of the current block, the first level seek would return the same block, so
+// it is skipped, and only the current block is searched.
+// This shortcut is the only batching of point lookups done at this level: there is no multi-key
+// lookup API, so callers get it only by seeking the same iterator in sorted key order. Bloom
+// filter checks and index seeks for keys in different blocks are not shared.
+bool TwoLevelIterator::SeekInCurrentDataBlock(const Slice& target) {
+  const Comparator* comparator = state_->comparator;
+  if (comparator == nullptr || !second_level_iter_.Valid() || !first_level_iter_.Valid() ||
+      comparator->Compare(target, second_level_iter_.key()) < 0 ||
+      comparator->Compare(target, first_level_iter_.key()) > 0) {
+    return false;
+  }
+  second_level_iter_.Seek(target);
+  // Target could be greater than all keys of the block, then the iterator moves to the next one.
+  SkipEmptyDataBlocksForward();
+  return true;
+}
+
 void TwoLevelIterator::SeekToFirst() {
+  sequential_blocks_ = 0;
   first_level_iter_.SeekToFirst();
   InitDataBlock();
   if (second_level_iter_.iter() != nullptr) {
@@ -136,6 +165,7 @@ void TwoLevelIterator::SeekToFirst() {
 }
 
 void TwoLevelIterator::SeekToLast() {
+  sequential_blocks_ = 0;
   first_level_iter_.SeekToLast();
   InitDataBlock();
   if (second_level_iter_.iter() != nullptr) {
@@ -152,6 +182,7 @@ void TwoLevelIterator::Next() {
 
 void TwoLevelIterator::Prev() {
   assert(Valid());
+  sequential_blocks_ = 0;
   second_level_iter_.Prev();
   SkipEmptyDataBlocksBackward();
 }
@@ -169,6 +200,7 @@ void TwoLevelIterator::SkipEmptyDataBlocksForward() {
     first_level_iter_.Next();
     InitDataBlock();
     if (second_level_iter_.iter() != nullptr) {
+      state_->ForwardBlockEntered(first_level_iter_.key(), ++sequential_blocks_);
       second_level_iter_.SeekToFirst();
     }
   }
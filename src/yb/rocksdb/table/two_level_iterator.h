@@ -29,6 +29,7 @@
 namespace rocksdb {
 
 struct ReadOptions;
+class Comparator;
 class InternalKeyComparator;
 class Arena;
 
@@ -40,8 +41,18 @@ struct TwoLevelIteratorState {
   virtual InternalIterator* NewSecondaryIterator(const Slice& handle) = 0;
   virtual bool PrefixMayMatch(const Slice& internal_key) = 0;
 
+  // Called when forward iteration moves to the next second level block. sequential_blocks is the
+  // number of blocks entered this way since the last seek, first_level_key is the first level key
+  // of the entered block.
+  virtual void ForwardBlockEntered(const Slice& first_level_key, size_t sequential_blocks) {}
+
   // If call PrefixMayMatch()
   bool check_prefix_may_match;
+
+  // Comparator of first and second level keys. When set, first level keys are expected to be
+  // upper bounds of keys in corresponding second level blocks, and seek to a key in the current
+  // block does not seek the first level iterator.
+  const Comparator* comparator = nullptr;
 };
 
 
@@ -26,6 +26,9 @@
 #include <stdlib.h>
 #include <gflags/gflags.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "yb/util/metrics.h"
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/statistics.h"
@@ -381,6 +384,84 @@ class LRUHandleDeleter {
   autovector<LRUHandle*> handles_;
 };
 
+// Count-min sketch of key access frequencies used by CacheAdmissionPolicy::kFrequencySketch.
+// Each key is mapped to one saturating 4 bit counter in each of kDepth rows, estimate is the
+// minimum of those counters. After the number of recorded accesses reaches kSampleFactor times
+// the row width, all counters are halved, so estimates reflect recent accesses.
+class FrequencySketch {
+ public:
+  // Sizes sketch to track about expected_entries keys, dropping all collected counters.
+  void Resize(size_t expected_entries) {
+    size_t width = kMinWidth;
+    while (width < expected_entries && width < kMaxWidth) {
+      width <<= 1;
+    }
+    if (width == width_) {
+      return;
+    }
+    width_ = width;
+    counters_.assign(kDepth * width_, 0);
+    additions_ = 0;
+  }
+
+  void Increment(uint32_t hash) {
+    if (counters_.empty()) {
+      return;
+    }
+    for (size_t row = 0; row != kDepth; ++row) {
+      auto& counter = counters_[Index(hash, row)];
+      if (counter < kMaxCount) {
+        ++counter;
+      }
+    }
+    if (++additions_ >= kSampleFactor * width_) {
+      Age();
+    }
+  }
+
+  uint32_t Estimate(uint32_t hash) const {
+    if (counters_.empty()) {
+      return 0;
+    }
+    uint32_t result = kMaxCount;
+    for (size_t row = 0; row != kDepth; ++row) {
+      result = std::min<uint32_t>(result, counters_[Index(hash, row)]);
+    }
+    return result;
+  }
+
+ private:
+  static constexpr size_t kDepth = 4;
+  static constexpr uint8_t kMaxCount = 15;
+  static constexpr size_t kSampleFactor = 10;
+  static constexpr size_t kMinWidth = 64;
+  static constexpr size_t kMaxWidth = 1 << 22;
+
+  // Uses double hashing of the remixed key hash to pick counter in the row. The key hash could
+  // not be used as is, because its high bits are the same for all keys of the shard.
+  size_t Index(uint32_t hash, size_t row) const {
+    const uint64_t mixed = hash * 0x9E3779B97F4A7C15ULL;
+    const uint32_t h1 = static_cast<uint32_t>(mixed >> 32);
+    const uint32_t h2 = static_cast<uint32_t>(mixed) | 1;
+    return row * width_ + ((h1 + row * h2) & (width_ - 1));
+  }
+
+  void Age() {
+    for (auto& counter : counters_) {
+      counter >>= 1;
+    }
+    additions_ /= 2;
+  }
+
+  std::vector<uint8_t> counters_;
+  size_t width_ = 0;
+  size_t additions_ = 0;
+};
+
+// Block cache is mostly filled with data blocks, so it is used as estimated size of the cache
+// entry to size the frequency sketch.
+constexpr size_t kFrequencySketchBytesPerEntry = 4096;
+
 // A single shard of sharded cache.
 class LRUCache {
  public:
@@ -400,6 +481,8 @@ class LRUCache {
   // Set the flag to reject insertion if cache if full.
   void SetStrictCapacityLimit(bool strict_capacity_limit);
 
+  void SetAdmissionPolicy(CacheAdmissionPolicy admission_policy);
+
   // Like Cache methods, but with an extra "hash" parameter.
   Status Insert(const Slice& key, uint32_t hash, const QueryId query_id,
                 void* value, size_t charge, void (*deleter)(const Slice& key, void* value),
@@ -449,9 +532,18 @@ class LRUCache {
   // Decrements the usage on the appropriate subcache.
   void DecrementUsage(const SubCacheType subcache_type, const size_t charge);
 
+  // Returns whether entry with specified key should be added to sub_cache according to
+  // admission policy. Not thread safe, should be executed while holding the mutex_.
+  bool Admit(const Slice& key, uint32_t hash, size_t charge, LRUSubCache* sub_cache);
+
+  // Sizes frequency sketch for the current capacity. Requires mutex_ to be held.
+  void ResizeFrequencySketch();
+
   // Whether to reject insertion if cache reaches its full capacity.
   bool strict_capacity_limit_;
 
+  CacheAdmissionPolicy admission_policy_ = CacheAdmissionPolicy::kAdmitAll;
+
   // mutex_ protects the following state.
   // We don't count mutex_ as the cache's internal state so semantically we
   // don't mind mutex_ invoking the non-const actions.
@@ -459,6 +551,9 @@ class LRUCache {
 
   HandleTable table_;
 
+  // Access frequencies of keys, used only by CacheAdmissionPolicy::kFrequencySketch.
+  FrequencySketch frequency_sketch_;
+
   shared_ptr<yb::CacheMetrics> metrics_;
 };
 
@@ -486,6 +581,25 @@ void LRUCache::DecrementUsage(const SubCacheType subcache_type, const size_t cha
   GetSubCache(subcache_type)->DecrementUsage(charge);
 }
 
+bool LRUCache::Admit(const Slice& key, uint32_t hash, size_t charge, LRUSubCache* sub_cache) {
+  if (admission_policy_ != CacheAdmissionPolicy::kFrequencySketch ||
+      sub_cache->Usage() + charge <= sub_cache->Capacity() || sub_cache->IsLRUEmpty() ||
+      table_.Lookup(key, hash) != nullptr) {
+    return true;
+  }
+  // Ties are admitted, so when all keys are accessed once the cache behaves like a plain LRU.
+  const LRUHandle* victim = sub_cache->LRU_Head().next;
+  return frequency_sketch_.Estimate(hash) >= frequency_sketch_.Estimate(victim->hash);
+}
+
+void LRUCache::ResizeFrequencySketch() {
+  if (admission_policy_ != CacheAdmissionPolicy::kFrequencySketch) {
+    return;
+  }
+  const size_t capacity = single_touch_sub_cache_.Capacity() + multi_touch_sub_cache_.Capacity();
+  frequency_sketch_.Resize(capacity / kFrequencySketchBytesPerEntry);
+}
+
 // Call deleter and free
 
 void LRUCache::ApplyToAllCacheEntries(void (*callback)(void*, size_t),
@@ -537,6 +651,7 @@ void LRUCache::SetCapacity(size_t capacity) {
     multi_touch_sub_cache_.SetCapacity(capacity - single_touch_sub_cache_.Capacity());
     EvictFromLRU(0, &last_reference_list, SINGLE_TOUCH);
     EvictFromLRU(0, &last_reference_list, MULTI_TOUCH);
+    ResizeFrequencySketch();
   }
 }
 
@@ -545,9 +660,18 @@ void LRUCache::SetStrictCapacityLimit(bool strict_capacity_limit) {
   strict_capacity_limit_ = strict_capacity_limit;
 }
 
+void LRUCache::SetAdmissionPolicy(CacheAdmissionPolicy admission_policy) {
+  MutexLock l(&mutex_);
+  admission_policy_ = admission_policy;
+  ResizeFrequencySketch();
+}
+
 Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
                                 Statistics* statistics)  {
   MutexLock l(&mutex_);
+  if (admission_policy_ == CacheAdmissionPolicy::kFrequencySketch) {
+    frequency_sketch_.Increment(hash);
+  }
   LRUHandle* e = table_.Lookup(key, hash);
   if (e != nullptr) {
     assert(e->in_cache);
@@ -703,10 +827,24 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
     } else {
       subcache_type = table_.GetSubCacheTypeCandidate(e);
     }
-    EvictFromLRU(charge, &last_reference_list, subcache_type);
     LRUSubCache* sub_cache = GetSubCache(subcache_type);
-    // If the cache no longer has any more space in the given pool.
-    if (strict_capacity_limit_ &&
+    const bool admitted = Admit(key, hash, charge, sub_cache);
+    if (admitted) {
+      EvictFromLRU(charge, &last_reference_list, subcache_type);
+    }
+    if (!admitted) {
+      // The entry is not added to the cache, but is still usable through the handle. It is
+      // freed when the caller releases it, like an entry that was erased while referenced.
+      if (handle == nullptr) {
+        last_reference_list.Add(e);
+      } else {
+        e->in_cache = false;
+        e->refs = 1;
+        sub_cache->IncrementUsage(charge);
+        *handle = reinterpret_cast<Cache::Handle*>(e);
+      }
+      s = Status::OK();
+    } else if (strict_capacity_limit_ &&
         sub_cache->Usage() - sub_cache->LRU_Usage() + charge > sub_cache->Capacity()) {
       if (handle == nullptr) {
         last_reference_list.Add(e);
@@ -740,7 +878,9 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
       s = Status::OK();
     }
     if (statistics != nullptr) {
-      if (s.ok()) {
+      if (!admitted) {
+        RecordTick(statistics, BLOCK_CACHE_ADMISSION_REJECTS);
+      } else if (s.ok()) {
         RecordTick(statistics, BLOCK_CACHE_ADD);
         RecordTick(statistics, BLOCK_CACHE_BYTES_WRITE, charge);
         if (subcache_type == SubCacheType::SINGLE_TOUCH) {
@@ -819,7 +959,7 @@ class ShardedLRUCache : public Cache {
 
  public:
   ShardedLRUCache(size_t capacity, int num_shard_bits,
-                  bool strict_capacity_limit)
+                  bool strict_capacity_limit, CacheAdmissionPolicy admission_policy)
       : last_id_(0),
         num_shard_bits_(num_shard_bits),
         capacity_(capacity),
@@ -831,6 +971,7 @@ class ShardedLRUCache : public Cache {
     for (int s = 0; s < num_shards; s++) {
       shards_[s].SetCapacity(per_shard);
       shards_[s].SetStrictCapacityLimit(strict_capacity_limit);
+      shards_[s].SetAdmissionPolicy(admission_policy);
     }
   }
 
@@ -976,11 +1117,18 @@ shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits) {
 
 shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                               bool strict_capacity_limit) {
+  return NewLRUCache(capacity, num_shard_bits, strict_capacity_limit,
+                     CacheAdmissionPolicy::kAdmitAll);
+}
+
+shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
+                              bool strict_capacity_limit,
+                              CacheAdmissionPolicy admission_policy) {
   if (num_shard_bits >= 20) {
     return nullptr;  // the cache cannot be sharded into too many fine pieces
   }
   return std::make_shared<ShardedLRUCache>(capacity, num_shard_bits,
-                                           strict_capacity_limit);
+                                           strict_capacity_limit, admission_policy);
 }
 
 }  // namespace rocksdb
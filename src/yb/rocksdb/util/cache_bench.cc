@@ -34,6 +34,8 @@ int main() {
 #include <stdio.h>
 #include <gflags/gflags.h>
 
+#include <vector>
+
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/env.h"
@@ -61,6 +63,17 @@ DEFINE_int32(lookup_percent, 50,
 DEFINE_int32(erase_percent, 10,
              "Ratio of erase to total workload (expressed as a percentage)");
 
+DEFINE_bool(mixed_workload, false,
+            "Replay the same trace of point lookups and scans against caches with each admission "
+            "policy and report hit rates. In this mode cache_size is the number of entries.");
+DEFINE_int32(point_key_bits, 14,
+             "Point lookups pick keys in [0, 2^point_key_bits) with exponential bias towards "
+             "smaller keys.");
+DEFINE_int32(scan_percent, 1,
+             "Percentage of operations of mixed workload that are scans.");
+DEFINE_int32(scan_length, 1000,
+             "Number of distinct keys, that were not accessed before, read by each scan.");
+
 namespace rocksdb {
 
 class CacheBench;
@@ -157,7 +170,7 @@ class CacheBench {
       // Cast uint64* to be char*, data would be copied to cache
       Slice key(reinterpret_cast<char*>(&rand_key), 8);
       // do insert
-      cache_->Insert(key, new char[10], 1, &deleter);
+      cache_->Insert(key, kDefaultQueryId, new char[10], 1, &deleter);
     }
   }
 
@@ -235,11 +248,11 @@ class CacheBench {
       int32_t prob_op = thread->rnd.Uniform(100);
       if (prob_op >= 0 && prob_op < FLAGS_insert_percent) {
         // do insert
-        cache_->Insert(key, new char[10], 1, &deleter);
+        cache_->Insert(key, kDefaultQueryId, new char[10], 1, &deleter);
       } else if (prob_op -= FLAGS_insert_percent &&
                  prob_op < FLAGS_lookup_percent) {
         // do lookup
-        auto handle = cache_->Lookup(key);
+        auto handle = cache_->Lookup(key, kDefaultQueryId);
         if (handle) {
           cache_->Release(handle);
         }
@@ -264,6 +277,86 @@ class CacheBench {
     printf("----------------------------\n");
   }
 };
+
+// Replays trace of point lookups of a skewed key set mixed with scans of keys that were not
+// accessed before. Each point lookup is a separate query, while all keys of a scan are read by
+// the same query, like blocks of a large CQL scan. Missing keys are inserted after lookup.
+class MixedWorkloadBench {
+ public:
+  MixedWorkloadBench() {
+    Random64 rnd(301);
+    uint64_t next_scan_key = 1ULL << 63;
+    QueryId next_query_id = 1;
+    for (uint64_t i = 0; i < FLAGS_ops_per_thread; i++) {
+      if (rnd.Uniform(100) < static_cast<uint64_t>(FLAGS_scan_percent)) {
+        for (int j = 0; j < FLAGS_scan_length; j++) {
+          trace_.push_back({next_scan_key++, next_query_id, true});
+        }
+      } else {
+        trace_.push_back({rnd.Skewed(FLAGS_point_key_bits), next_query_id, false});
+      }
+      ++next_query_id;
+    }
+  }
+
+  void Run() {
+    PrintEnv();
+    Replay("LRU", CacheAdmissionPolicy::kAdmitAll);
+    Replay("TinyLFU", CacheAdmissionPolicy::kFrequencySketch);
+  }
+
+ private:
+  struct Access {
+    uint64_t key;
+    QueryId query_id;
+    bool scan;
+  };
+
+  void Replay(const char* name, CacheAdmissionPolicy admission_policy) {
+    auto cache = NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits, false, admission_policy);
+    uint64_t point_lookups = 0, point_hits = 0, scan_lookups = 0, scan_hits = 0;
+    uint64_t start_time = Env::Default()->NowMicros();
+    for (const auto& access : trace_) {
+      Slice key(reinterpret_cast<const char*>(&access.key), sizeof(access.key));
+      auto handle = cache->Lookup(key, access.query_id);
+      const bool hit = handle != nullptr;
+      if (hit) {
+        cache->Release(handle);
+      } else {
+        cache->Insert(key, access.query_id, new char[10], 1, &deleter);
+      }
+      if (access.scan) {
+        ++scan_lookups;
+        scan_hits += hit;
+      } else {
+        ++point_lookups;
+        point_hits += hit;
+      }
+    }
+    double elapsed = static_cast<double>(Env::Default()->NowMicros() - start_time) * 1e-6;
+    fprintf(stdout, "%-8s: point hit rate %.2f%%, scan hit rate %.2f%%, "
+                    "total hit rate %.2f%%, replayed in %.3f s\n",
+            name, Percent(point_hits, point_lookups), Percent(scan_hits, scan_lookups),
+            Percent(point_hits + scan_hits, point_lookups + scan_lookups), elapsed);
+  }
+
+  void PrintEnv() const {
+    printf("Cache entries       : %" PRIu64 "\n", FLAGS_cache_size);
+    printf("Num shard bits      : %d\n", FLAGS_num_shard_bits);
+    printf("Operations          : %" PRIu64 "\n", FLAGS_ops_per_thread);
+    printf("Point key bits      : %d\n", FLAGS_point_key_bits);
+    printf("Scan percentage     : %d%%\n", FLAGS_scan_percent);
+    printf("Scan length         : %d\n", FLAGS_scan_length);
+    printf("----------------------------\n");
+  }
+
+  static double Percent(uint64_t part, uint64_t total) {
+    return total ? 100.0 * part / total : 0.0;
+  }
+
+  std::vector<Access> trace_;
+};
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -274,6 +367,12 @@ int main(int argc, char** argv) {
     exit(1);
   }
 
+  if (FLAGS_mixed_workload) {
+    rocksdb::MixedWorkloadBench bench;
+    bench.Run();
+    return 0;
+  }
+
   rocksdb::CacheBench bench;
   if (FLAGS_populate_cache) {
     bench.PopulateCache();
@@ -653,6 +653,63 @@ TEST_F(CacheTest, OverCapacity) {
   }
 }
 
+TEST_F(CacheTest, FrequencyAdmission) {
+  FLAGS_cache_single_touch_ratio = 1;
+  const int kCapacity = 10;
+  const int kHotLookups = 10;
+  const int kScanSize = 50;
+  auto lru_cache = NewLRUCache(kCapacity, 0, false, CacheAdmissionPolicy::kAdmitAll);
+  auto tiny_lfu_cache = NewLRUCache(kCapacity, 0, false, CacheAdmissionPolicy::kFrequencySketch);
+
+  for (const auto& cache : {lru_cache, tiny_lfu_cache}) {
+    // Fill the cache with frequently accessed entries.
+    for (int i = 0; i < kCapacity; i++) {
+      ASSERT_OK(Insert(cache, i, i + 1));
+    }
+    for (int j = 0; j < kHotLookups; j++) {
+      for (int i = 0; i < kCapacity; i++) {
+        ASSERT_EQ(i + 1, Lookup(cache, i));
+      }
+    }
+
+    // Scan through keys that are accessed once.
+    for (int i = 1000; i < 1000 + kScanSize; i++) {
+      ASSERT_EQ(-1, Lookup(cache, i));
+      ASSERT_OK(Insert(cache, i, i + 1));
+    }
+  }
+
+  // Plain LRU lost all frequently accessed entries, while TinyLFU kept all of them.
+  for (int i = 0; i < kCapacity; i++) {
+    ASSERT_EQ(-1, Lookup(lru_cache, i));
+    ASSERT_EQ(i + 1, Lookup(tiny_lfu_cache, i));
+  }
+  ASSERT_EQ(kCapacity, tiny_lfu_cache->GetUsage());
+
+  // Rejected entry is still returned through the handle and freed on release.
+  deleted_keys_.clear();
+  Cache::Handle* handle = nullptr;
+  ASSERT_OK(tiny_lfu_cache->Insert(
+      EncodeKey(2000), kTestQueryId, EncodeValue(2001), 1, &CacheTest::Deleter, &handle));
+  ASSERT_NE(nullptr, handle);
+  ASSERT_EQ(2001, DecodeValue(tiny_lfu_cache->Value(handle)));
+  ASSERT_EQ(kCapacity + 1, tiny_lfu_cache->GetUsage());
+  tiny_lfu_cache->Release(handle);
+  ASSERT_EQ(kCapacity, tiny_lfu_cache->GetUsage());
+  ASSERT_EQ(std::vector<int>{2000}, deleted_keys_);
+  ASSERT_EQ(-1, Lookup(tiny_lfu_cache, 2000));
+
+  // Key that became frequently accessed is admitted.
+  for (int j = 0; j < 2 * kHotLookups; j++) {
+    ASSERT_EQ(-1, Lookup(tiny_lfu_cache, 3000));
+  }
+  ASSERT_OK(Insert(tiny_lfu_cache, 3000, 3001));
+  ASSERT_EQ(3001, Lookup(tiny_lfu_cache, 3000));
+
+  // Returning the flag back.
+  FLAGS_cache_single_touch_ratio = 0.2;
+}
+
 namespace {
 std::vector<std::pair<int, int>> callback_state;
 void callback(void* entry, size_t charge) {
@@ -71,6 +71,11 @@ class GenericRateLimiter : public RateLimiter {
     return total_requests_[pri];
   }
 
+  virtual bool IsSaturated() const override {
+    MutexLock g(&request_mutex_);
+    return !queue_[Env::IO_LOW].empty() || !queue_[Env::IO_HIGH].empty();
+  }
+
  private:
   void Refill();
   int64_t CalculateRefillBytesPerPeriod(int64_t rate_bytes_per_sec) {
@@ -26,7 +26,11 @@
 #endif
 
 #include <inttypes.h>
+
+#include <atomic>
 #include <limits>
+#include <thread>
+
 #include "yb/rocksdb/util/testharness.h"
 #include "yb/rocksdb/util/rate_limiter.h"
 #include "yb/rocksdb/util/random.h"
@@ -40,6 +44,30 @@ TEST_F(RateLimiterTest, StartStop) {
   std::unique_ptr<RateLimiter> limiter(new GenericRateLimiter(100, 100, 10));
 }
 
+TEST_F(RateLimiterTest, Saturated) {
+  // 1000 bytes per second, refilled every 100ms.
+  std::unique_ptr<RateLimiter> limiter(new GenericRateLimiter(1000, 100 * 1000, 10));
+  ASSERT_FALSE(limiter->IsSaturated());
+
+  std::atomic<bool> stop(false);
+  std::thread writer([&limiter, &stop] {
+    while (!stop.load(std::memory_order_acquire)) {
+      limiter->Request(limiter->GetSingleBurstBytes(), Env::IO_LOW);
+    }
+  });
+
+  // Writer requests whole refill on each call, so it waits for tokens most of the time.
+  bool saturated = false;
+  for (int i = 0; i != 100 && !saturated; ++i) {
+    Env::Default()->SleepForMicroseconds(10 * 1000);
+    saturated = limiter->IsSaturated();
+  }
+  stop.store(true, std::memory_order_release);
+  writer.join();
+  ASSERT_TRUE(saturated);
+  ASSERT_FALSE(limiter->IsSaturated());
+}
+
 #ifndef OS_MACOSX
 TEST_F(RateLimiterTest, Rate) {
   auto* env = Env::Default();
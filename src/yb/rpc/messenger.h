@@ -52,6 +52,7 @@
 #include "yb/rpc/proxy.h"
 #include "yb/rpc/reactor.h"
 #include "yb/rpc/response_callback.h"
+#include "yb/rpc/rpc_compression.h"
 #include "yb/rpc/scheduler.h"
 
 #include "yb/util/concurrent_value.h"
@@ -284,6 +285,10 @@ class Messenger : public ProxyContext {
     return *rpc_metrics_;
   }
 
+  const RpcCompression& rpc_compression() const override {
+    return rpc_compression_;
+  }
+
   const std::shared_ptr<MemTracker>& parent_mem_tracker() override;
 
   int num_connections_to_server() const override {
@@ -373,6 +378,8 @@ class Messenger : public ProxyContext {
 
   std::unique_ptr<RpcMetrics> rpc_metrics_;
 
+  const RpcCompression rpc_compression_;
+
   // Use this IP address as base address for outbound connections from messenger.
   IpAddress test_outbound_ip_base_;
   std::atomic<bool> has_outbound_ip_base_{false};
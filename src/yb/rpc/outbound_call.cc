@@ -45,6 +45,7 @@
 #include "yb/rpc/connection.h"
 #include "yb/rpc/constants.h"
 #include "yb/rpc/outbound_call.h"
+#include "yb/rpc/rpc_compression.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/rpc/rpc_introspection.pb.h"
 #include "yb/rpc/rpc_metrics.h"
@@ -267,6 +268,19 @@ Status OutboundCall::SetRequestParam(
   if (!status.ok()) {
     return status;
   }
+
+  RpcCompressionType compression = RPC_COMPRESSION_NONE;
+  if (compression_ && peer_accepts_compression_->load(std::memory_order_acquire)) {
+    compression = compression_->For(remote_method_->service_name(), message_size);
+  }
+  if (compression != RPC_COMPRESSION_NONE &&
+      VERIFY_RESULT(SetCompressedRequestParam(message, compression))) {
+    if (mem_tracker) {
+      buffer_consumption_ = ScopedTrackedConsumption(mem_tracker, buffer_.size());
+    }
+    return Status::OK();
+  }
+
   size_t header_size = 0;
 
   RequestHeader header;
@@ -288,6 +302,29 @@ Status OutboundCall::SetRequestParam(
                           header_size);
 }
 
+Result<bool> OutboundCall::SetCompressedRequestParam(
+    const Message& message, RpcCompressionType compression) {
+  faststring raw;
+  raw.resize(message.GetCachedSize());
+  message.SerializeWithCachedSizesToArray(raw.data());
+
+  faststring compressed;
+  if (!CompressRpcMessage(compression, raw, &compressed)) {
+    return false;
+  }
+
+  RequestHeader header;
+  InitHeader(&header);
+  header.set_compression(compression);
+  header.set_uncompressed_size(raw.size());
+  auto status = SerializeRpcFrame(header, compressed, &buffer_);
+  remote_method_pool_->Release(header.release_remote_method());
+  RETURN_NOT_OK(status);
+
+  RecordRpcCompression(rpc_metrics_, raw.size(), compressed.size());
+  return true;
+}
+
 Status OutboundCall::status() const {
   std::lock_guard<simple_spinlock> l(lock_);
   return status_;
@@ -414,6 +451,13 @@ void OutboundCall::SetResponse(CallResponse&& resp) {
   call_response_ = std::move(resp);
   Slice r(call_response_.serialized_response());
 
+  if (compression_) {
+    // The server answers every request with accepts_compressed_response, so the absence of the flag
+    // means that the server does not support compression, e.g. it was downgraded.
+    peer_accepts_compression_->store(
+        call_response_.accepts_compressed_requests(), std::memory_order_release);
+  }
+
   if (call_response_.is_success()) {
     // TODO: here we're deserializing the call response within the reactor thread,
     // which isn't great, since it would block processing of other RPCs in parallel.
@@ -565,6 +609,9 @@ void OutboundCall::InitHeader(RequestHeader* header) {
     }
   }
   header->set_allocated_remote_method(remote_method_pool_->Take());
+  if (compression_) {
+    header->set_accepts_compressed_response(true);
+  }
 }
 
 ///
@@ -612,6 +659,12 @@ Status CallResponse::ParseFrom(CallData* call_data) {
   Slice source(response_data_.data(), response_data_.size());
   RETURN_NOT_OK(serialization::ParseYBMessage(source, &header_, &entire_message));
 
+  if (header_.compression() != RPC_COMPRESSION_NONE) {
+    RETURN_NOT_OK(DecompressRpcMessage(
+        header_.compression(), entire_message, header_.uncompressed_size(), &decompressed_data_));
+    entire_message = decompressed_data_.as_slice();
+  }
+
   // Use information from header to extract the payload slices.
   const size_t sidecars = header_.sidecar_offsets_size();
 
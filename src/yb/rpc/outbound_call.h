@@ -32,7 +32,9 @@
 #ifndef YB_RPC_OUTBOUND_CALL_H_
 #define YB_RPC_OUTBOUND_CALL_H_
 
+#include <atomic>
 #include <deque>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -153,6 +155,12 @@ class CallResponse {
     return header_.call_id();
   }
 
+  // Return true if the server announced that it accepts compressed requests.
+  bool accepts_compressed_requests() const {
+    DCHECK(parsed_);
+    return header_.accepts_compressed_requests();
+  }
+
   // Return the serialized response data. This is just the response "body" --
   // either a serialized ErrorStatusPB, or the serialized user response protobuf.
   const Slice &serialized_response() const {
@@ -163,7 +171,7 @@ class CallResponse {
   Result<Slice> GetSidecar(int idx) const;
 
   size_t DynamicMemoryUsage() const {
-    return DynamicMemoryUsageOf(header_, response_data_) +
+    return DynamicMemoryUsageOf(header_, response_data_, decompressed_data_) +
            GetFlatDynamicMemoryUsageOf(sidecar_bounds_);
   }
 
@@ -186,6 +194,10 @@ class CallResponse {
   // and sidecar_slices_ refer into its data.
   CallData response_data_;
 
+  // Uncompressed response and sidecars when the response was compressed.
+  // serialized_response_ and sidecar_bounds_ refer into it in this case.
+  RefCntBuffer decompressed_data_;
+
   DISALLOW_COPY_AND_ASSIGN(CallResponse);
 };
 
@@ -243,6 +255,15 @@ class OutboundCall : public RpcCall {
     callback_thread_pool_ = callback_thread_pool;
   }
 
+  // Sets compression settings of this side and whether the remote server is known to accept
+  // compressed requests. The latter is updated from the response. Should be called before
+  // SetRequestParam().
+  void SetCompression(const RpcCompression* compression,
+                      std::shared_ptr<std::atomic<bool>> peer_accepts_compression) {
+    compression_ = compression;
+    peer_accepts_compression_ = std::move(peer_accepts_compression);
+  }
+
   // Callback after the call has been put on the outbound connection queue.
   void SetQueued();
 
@@ -355,6 +376,11 @@ class OutboundCall : public RpcCall {
 
   void InitHeader(RequestHeader* header);
 
+  // Serializes request with compressed message. Returns false if message should be sent
+  // uncompressed because compression does not reduce its size.
+  Result<bool> SetCompressedRequestParam(
+      const google::protobuf::Message& message, RpcCompressionType compression);
+
   // Lock for state_ status_, error_pb_ fields, since they
   // may be mutated by the reactor thread while the client thread
   // reads them.
@@ -395,6 +421,12 @@ class OutboundCall : public RpcCall {
 
   RpcMetrics* rpc_metrics_;
 
+  // Compression settings of this side, nullptr when compression is not used for this call.
+  const RpcCompression* compression_ = nullptr;
+
+  // Whether the remote server accepts compressed requests, shared by calls of the same proxy.
+  std::shared_ptr<std::atomic<bool>> peer_accepts_compression_;
+
   DISALLOW_COPY_AND_ASSIGN(OutboundCall);
 };
 
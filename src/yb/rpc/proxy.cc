@@ -47,6 +47,7 @@
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/remote_method.h"
 #include "yb/rpc/response_callback.h"
+#include "yb/rpc/rpc_compression.h"
 #include "yb/rpc/rpc_header.pb.h"
 
 #include "yb/util/backoff_waiter.h"
@@ -162,6 +163,9 @@ void Proxy::DoAsyncRequest(const RemoteMethod* method,
                                          force_run_callback_on_reactor,
                                          controller->invoke_callback_mode()));
   auto call = controller->call_.get();
+  if (!call_local_service_ && context_->rpc_compression().enabled()) {
+    call->SetCompression(&context_->rpc_compression(), peer_accepts_compression_);
+  }
   Status s = call->SetRequestParam(req, mem_tracker_);
   if (PREDICT_FALSE(!s.ok())) {
     // Failed to serialize request: likely the request is missing a required
@@ -85,6 +85,8 @@ class ProxyContext {
 
   virtual RpcMetrics& rpc_metrics() = 0;
 
+  virtual const RpcCompression& rpc_compression() const = 0;
+
   virtual const std::shared_ptr<MemTracker>& parent_mem_tracker() = 0;
 
   // Number of connections to create per destination address.
@@ -199,6 +201,10 @@ class Proxy {
   int num_connections_to_server_;
 
   MemTrackerPtr mem_tracker_;
+
+  // Whether the remote server announced that it accepts compressed requests.
+  std::shared_ptr<std::atomic<bool>> peer_accepts_compression_ =
+      std::make_shared<std::atomic<bool>>(false);
 };
 
 class ProxyCache {
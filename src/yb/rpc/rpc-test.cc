@@ -64,6 +64,8 @@
 
 METRIC_DECLARE_histogram(handler_latency_yb_rpc_test_CalculatorService_Sleep);
 METRIC_DECLARE_histogram(rpc_incoming_queue_time);
+METRIC_DECLARE_counter(rpc_compression_raw_bytes);
+METRIC_DECLARE_counter(rpc_compression_compressed_bytes);
 
 DEFINE_int32(rpc_test_connection_keepalive_num_iterations, 1,
   "Number of iterations in TestRpc.TestConnectionKeepalive");
@@ -74,6 +76,8 @@ DECLARE_bool(enable_rpc_keepalive);
 DECLARE_int64(memory_limit_hard_bytes);
 DECLARE_bool(TEST_pause_calculator_echo_request);
 DECLARE_bool(binary_call_parser_reject_on_mem_tracker_hard_limit);
+DECLARE_string(rpc_compression_type);
+DECLARE_string(rpc_compressed_services);
 
 using namespace std::chrono_literals;
 using std::string;
@@ -427,6 +431,51 @@ TEST_F(TestRpc, TestRpcSidecar) {
   DoTestSidecar(&p, sizes);
 }
 
+// Test that large messages of services listed in rpc_compressed_services are compressed.
+// The first request is sent uncompressed, because the client does not know yet whether the server
+// accepts compressed requests.
+TEST_F(TestRpc, Compression) {
+  FLAGS_rpc_compression_type = "lz4";
+  FLAGS_rpc_compressed_services = rpc_test::CalculatorServiceIf::static_service_name();
+
+  HostPort server_addr;
+  StartTestServer(&server_addr);
+
+  auto client_messenger = CreateAutoShutdownMessengerHolder("Client");
+  Proxy p(client_messenger.get(), server_addr);
+
+  const auto& metric_map = server_messenger()->metric_entity()->UnsafeMetricsMapForTests();
+  auto raw_bytes_counter = down_cast<Counter*>(
+      FindOrDie(metric_map, &METRIC_rpc_compression_raw_bytes).get());
+  auto compressed_bytes_counter = down_cast<Counter*>(
+      FindOrDie(metric_map, &METRIC_rpc_compression_compressed_bytes).get());
+
+  rpc_test::EchoRequestPB req;
+  req.set_data(std::string(1_MB, 'X'));
+  for (int i = 1; i <= 2; ++i) {
+    rpc_test::EchoResponsePB resp;
+    RpcController controller;
+    controller.set_timeout(30s);
+    ASSERT_OK(p.SyncRequest(CalculatorServiceMethods::EchoMethod(), req, &resp, &controller));
+    ASSERT_EQ(req.data(), resp.data());
+
+    // Client and server messengers share metric entity, so counters include both directions.
+    auto raw_bytes = raw_bytes_counter->value();
+    auto compressed_bytes = compressed_bytes_counter->value();
+    LOG(INFO) << "Call " << i << ", raw bytes: " << raw_bytes
+              << ", compressed bytes: " << compressed_bytes;
+    if (i == 1) {
+      // Only the response is compressed.
+      ASSERT_GE(raw_bytes, static_cast<int64_t>(1_MB));
+      ASSERT_LT(raw_bytes, static_cast<int64_t>(2_MB));
+    } else {
+      // Both the request and the response are compressed.
+      ASSERT_GE(raw_bytes, static_cast<int64_t>(3_MB));
+    }
+    ASSERT_LT(compressed_bytes * 10, raw_bytes);
+  }
+}
+
 // Test that timeouts are properly handled.
 TEST_F(TestRpc, TestCallTimeout) {
   HostPort server_addr;
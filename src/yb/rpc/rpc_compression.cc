@@ -0,0 +1,178 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rpc/rpc_compression.h"
+
+#include <lz4.h>
+#include <snappy.h>
+
+#include <google/protobuf/io/coded_stream.h>
+
+#include "yb/gutil/strings/split.h"
+
+#include "yb/rpc/rpc_metrics.h"
+#include "yb/rpc/serialization.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/size_literals.h"
+
+using namespace yb::size_literals;
+
+DECLARE_int32(rpc_max_message_size);
+
+DEFINE_string(rpc_compression_type, "none",
+              "Compression of large RPC messages of services listed in rpc_compressed_services: "
+              "none, snappy or lz4. Compressed messages are sent only to peers that announced "
+              "support of compression, so it could be enabled during a rolling upgrade.");
+TAG_FLAG(rpc_compression_type, advanced);
+
+DEFINE_string(rpc_compressed_services,
+              "yb.consensus.ConsensusService,yb.tserver.RemoteBootstrapService",
+              "Comma separated list of RPC services whose messages are compressed.");
+TAG_FLAG(rpc_compressed_services, advanced);
+
+DEFINE_int32(rpc_compression_min_bytes, 4_KB,
+             "Messages smaller than this size are never compressed.");
+TAG_FLAG(rpc_compression_min_bytes, advanced);
+
+namespace {
+
+bool ParseRpcCompressionType(const std::string& value, yb::rpc::RpcCompressionType* type) {
+  if (value == "none") {
+    *type = yb::rpc::RPC_COMPRESSION_NONE;
+  } else if (value == "snappy") {
+    *type = yb::rpc::RPC_COMPRESSION_SNAPPY;
+  } else if (value == "lz4") {
+    *type = yb::rpc::RPC_COMPRESSION_LZ4;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool ValidateRpcCompressionType(const char* flagname, const std::string& value) {
+  yb::rpc::RpcCompressionType type;
+  if (ParseRpcCompressionType(value, &type)) {
+    return true;
+  }
+  LOG(ERROR) << flagname << " should be one of none, snappy or lz4, value " << value
+             << " is invalid";
+  return false;
+}
+
+bool dummy = google::RegisterFlagValidator(
+    &FLAGS_rpc_compression_type, &ValidateRpcCompressionType);
+
+} // namespace
+
+namespace yb {
+namespace rpc {
+
+RpcCompression::RpcCompression()
+    : min_bytes_(FLAGS_rpc_compression_min_bytes) {
+  ParseRpcCompressionType(FLAGS_rpc_compression_type, &type_);
+  if (type_ != RPC_COMPRESSION_NONE) {
+    std::vector<std::string> services = strings::Split(
+        FLAGS_rpc_compressed_services, ",", strings::SkipEmpty());
+    services_.insert(services.begin(), services.end());
+  }
+}
+
+RpcCompressionType RpcCompression::For(const std::string& service_name, size_t size) const {
+  if (type_ == RPC_COMPRESSION_NONE || size < min_bytes_ || !services_.count(service_name)) {
+    return RPC_COMPRESSION_NONE;
+  }
+  return type_;
+}
+
+bool CompressRpcMessage(RpcCompressionType type, const Slice& input, faststring* output) {
+  switch (type) {
+    case RPC_COMPRESSION_SNAPPY: {
+      output->resize(snappy::MaxCompressedLength(input.size()));
+      size_t compressed_size = 0;
+      snappy::RawCompress(
+          input.cdata(), input.size(), reinterpret_cast<char*>(output->data()), &compressed_size);
+      output->resize(compressed_size);
+      break;
+    }
+    case RPC_COMPRESSION_LZ4: {
+      output->resize(LZ4_compressBound(input.size()));
+      const int compressed_size = LZ4_compress_default(
+          input.cdata(), reinterpret_cast<char*>(output->data()), input.size(), output->size());
+      if (compressed_size <= 0) {
+        return false;
+      }
+      output->resize(compressed_size);
+      break;
+    }
+    case RPC_COMPRESSION_NONE:
+      return false;
+  }
+  return output->size() < input.size();
+}
+
+Status DecompressRpcMessage(
+    RpcCompressionType type, const Slice& input, size_t uncompressed_size, RefCntBuffer* output) {
+  if (uncompressed_size > static_cast<size_t>(FLAGS_rpc_max_message_size)) {
+    return STATUS_FORMAT(Corruption, "Too big uncompressed RPC message: $0", uncompressed_size);
+  }
+  *output = RefCntBuffer(uncompressed_size);
+  switch (type) {
+    case RPC_COMPRESSION_SNAPPY: {
+      size_t size = 0;
+      if (!snappy::GetUncompressedLength(input.cdata(), input.size(), &size) ||
+          size != uncompressed_size ||
+          !snappy::RawUncompress(input.cdata(), input.size(), output->data())) {
+        return STATUS(Corruption, "Failed to uncompress RPC message");
+      }
+      return Status::OK();
+    }
+    case RPC_COMPRESSION_LZ4: {
+      const int size = LZ4_decompress_safe(
+          input.cdata(), output->data(), input.size(), uncompressed_size);
+      if (size < 0 || static_cast<size_t>(size) != uncompressed_size) {
+        return STATUS(Corruption, "Failed to uncompress RPC message");
+      }
+      return Status::OK();
+    }
+    case RPC_COMPRESSION_NONE:
+      break;
+  }
+  return STATUS_FORMAT(
+      Corruption, "Unexpected RPC compression type: $0", RpcCompressionType_Name(type));
+}
+
+Status SerializeRpcFrame(
+    const google::protobuf::MessageLite& header, const Slice& message, RefCntBuffer* output) {
+  using google::protobuf::io::CodedOutputStream;
+
+  const size_t message_size_with_delim =
+      CodedOutputStream::VarintSize32(message.size()) + message.size();
+  size_t header_size = 0;
+  RETURN_NOT_OK(serialization::SerializeHeader(
+      header, message_size_with_delim, output, message_size_with_delim, &header_size));
+  uint8_t* dst = output->udata() + header_size;
+  dst = CodedOutputStream::WriteVarint32ToArray(message.size(), dst);
+  memcpy(dst, message.data(), message.size());
+  return Status::OK();
+}
+
+void RecordRpcCompression(RpcMetrics* metrics, size_t raw_size, size_t compressed_size) {
+  if (metrics && metrics->compression_raw_bytes) {
+    metrics->compression_raw_bytes->IncrementBy(raw_size);
+    metrics->compression_compressed_bytes->IncrementBy(compressed_size);
+  }
+}
+
+} // namespace rpc
+} // namespace yb
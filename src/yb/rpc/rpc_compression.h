@@ -0,0 +1,75 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_RPC_RPC_COMPRESSION_H
+#define YB_RPC_RPC_COMPRESSION_H
+
+#include <string>
+#include <unordered_set>
+
+#include "yb/rpc/rpc_header.pb.h"
+
+#include "yb/util/faststring.h"
+#include "yb/util/ref_cnt_buffer.h"
+#include "yb/util/slice.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace rpc {
+
+struct RpcMetrics;
+
+// Compression of the main message of YB RPC frames.
+//
+// A client with enabled compression marks its requests with accepts_compressed_response, and the
+// server compresses responses only to such requests. The server answers them with
+// accepts_compressed_requests, and the client compresses requests to this server only after it
+// received such a response. So peers that are not aware of compression never receive compressed
+// frames. Each side compresses frames that it sends using its own rpc_compression_type, when the
+// service is listed in rpc_compressed_services and the message is large enough.
+
+// Compression settings parsed from flags once per messenger.
+class RpcCompression {
+ public:
+  RpcCompression();
+
+  // Returns compression that should be used for a message of specified service and size.
+  RpcCompressionType For(const std::string& service_name, size_t size) const;
+
+  // Whether compression is enabled on this side.
+  bool enabled() const { return type_ != RPC_COMPRESSION_NONE; }
+
+ private:
+  RpcCompressionType type_ = RPC_COMPRESSION_NONE;
+  std::unordered_set<std::string> services_;
+  size_t min_bytes_;
+};
+
+// Compresses input to output. Returns false if compressed data is not smaller than input, so it
+// should be sent uncompressed.
+bool CompressRpcMessage(RpcCompressionType type, const Slice& input, faststring* output);
+
+CHECKED_STATUS DecompressRpcMessage(
+    RpcCompressionType type, const Slice& input, size_t uncompressed_size, RefCntBuffer* output);
+
+// Serializes frame with header and main message that is not a protobuf, like compressed data.
+CHECKED_STATUS SerializeRpcFrame(
+    const google::protobuf::MessageLite& header, const Slice& message, RefCntBuffer* output);
+
+// Updates metrics with sizes of compressed message.
+void RecordRpcCompression(RpcMetrics* metrics, size_t raw_size, size_t compressed_size);
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_RPC_COMPRESSION_H
@@ -53,6 +53,7 @@ class Proxy;
 class ProxyCache;
 class Reactor;
 class ReactorTask;
+class RpcCompression;
 class RpcConnectionPB;
 class RpcContext;
 class RpcController;
@@ -43,6 +43,16 @@ METRIC_DEFINE_counter(server, rpc_outbound_calls_created,
                       yb::MetricUnit::kRequests,
                       "Number of created RPC outbound calls.");
 
+METRIC_DEFINE_counter(server, rpc_compression_raw_bytes,
+                      "Size of compressed RPC messages before compression.",
+                      yb::MetricUnit::kBytes,
+                      "Size of compressed RPC messages before compression.");
+
+METRIC_DEFINE_counter(server, rpc_compression_compressed_bytes,
+                      "Size of compressed RPC messages after compression.",
+                      yb::MetricUnit::kBytes,
+                      "Size of compressed RPC messages after compression.");
+
 namespace yb {
 namespace rpc {
 
@@ -54,6 +64,9 @@ RpcMetrics::RpcMetrics(const scoped_refptr<MetricEntity>& metric_entity) {
     inbound_calls_created = METRIC_rpc_inbound_calls_created.Instantiate(metric_entity);
     outbound_calls_alive = METRIC_rpc_outbound_calls_alive.Instantiate(metric_entity, 0);
     outbound_calls_created = METRIC_rpc_outbound_calls_created.Instantiate(metric_entity);
+    compression_raw_bytes = METRIC_rpc_compression_raw_bytes.Instantiate(metric_entity);
+    compression_compressed_bytes =
+        METRIC_rpc_compression_compressed_bytes.Instantiate(metric_entity);
   }
 }
 
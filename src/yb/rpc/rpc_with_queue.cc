@@ -64,15 +64,35 @@ void ConnectionContextWithQueue::Enqueue(std::shared_ptr<QueueableInboundCall> c
   if (size == replies_being_sent_ + 1) {
     first_without_reply_.store(call.get(), std::memory_order_release);
   }
-  if (size <= max_concurrent_calls_) {
+  StartCalls(reactor);
+}
+
+void ConnectionContextWithQueue::StartCalls(Reactor* reactor) {
+  while (started_calls_ < calls_queue_.size() && started_calls_ < max_concurrent_calls_) {
+    const auto& call = calls_queue_[started_calls_];
+    if (ConflictsWithRunningCalls(*call)) {
+      // Will be started when reply for conflicting call is ready.
+      break;
+    }
+    ++started_calls_;
     reactor->messenger()->QueueInboundCall(call);
   }
 }
 
+bool ConnectionContextWithQueue::ConflictsWithRunningCalls(const QueueableInboundCall& call) {
+  for (size_t i = replies_being_sent_; i != started_calls_; ++i) {
+    const auto& running = *calls_queue_[i];
+    if (!running.has_reply() && call.ConflictsWith(running)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void ConnectionContextWithQueue::Shutdown(const Status& status) {
   // Could erase calls, that we did not start to process yet.
-  if (calls_queue_.size() > max_concurrent_calls_) {
-    calls_queue_.erase(calls_queue_.begin() + max_concurrent_calls_, calls_queue_.end());
+  if (calls_queue_.size() > started_calls_) {
+    calls_queue_.erase(calls_queue_.begin() + started_calls_, calls_queue_.end());
   }
 
   for (auto& call : calls_queue_) {
@@ -95,10 +115,8 @@ void ConnectionContextWithQueue::CallProcessed(InboundCall* call) {
 
   calls_queue_.pop_front();
   --replies_being_sent_;
-  if (calls_queue_.size() >= max_concurrent_calls_) {
-    auto call_ptr = calls_queue_[max_concurrent_calls_ - 1];
-    reactor->messenger()->QueueInboundCall(call_ptr);
-  }
+  --started_calls_;
+  StartCalls(reactor);
   if (Idle() && idle_listener_) {
     idle_listener_();
   }
@@ -147,6 +165,9 @@ void ConnectionContextWithQueue::FlushOutboundQueue(Connection* conn) {
         calls_queue_.begin() + end);
     conn->QueueOutboundDataBatch(batch);
   }
+
+  // Calls that were blocked by conflicts with calls that just got reply could be started now.
+  StartCalls(conn->reactor());
 }
 
 void ConnectionContextWithQueue::AssignConnection(const ConnectionPtr& conn) {
@@ -49,6 +49,13 @@ class QueueableInboundCall : public InboundCall {
     return aborted_.load(std::memory_order_acquire);
   }
 
+  // Whether processing of this call should not start until the earlier call of the same
+  // connection, that is still being processed, has its reply. Calls of the same connection are
+  // processed concurrently only when they don't conflict.
+  virtual bool ConflictsWith(const QueueableInboundCall& earlier) const {
+    return false;
+  }
+
   // Context with queue has limit on bytes used by queued commands.
   // `weight_in_bytes` function is used to determine how many bytes consumes this call.
   size_t weight_in_bytes() const { return weight_in_bytes_; }
@@ -91,20 +98,25 @@ class ConnectionContextWithQueue : public ConnectionContextBase {
   void ListenIdle(IdleListener listener) override { idle_listener_ = std::move(listener); }
 
   void CallProcessed(InboundCall* call);
+  // Starts processing of received calls, while limit of concurrent calls allows it and the next
+  // call does not conflict with calls that are being processed.
+  void StartCalls(Reactor* reactor);
+  bool ConflictsWithRunningCalls(const QueueableInboundCall& call);
   void FlushOutboundQueue(Connection* conn);
   void FlushOutboundQueueAborted(const Status& status);
 
   const size_t max_concurrent_calls_;
   const size_t max_queued_bytes_;
   size_t replies_being_sent_ = 0;
+  size_t started_calls_ = 0;
   size_t queued_bytes_ = 0;
 
   // Calls that are being processed by this connection/context.
   // At the top or queue there are replies_being_sent_ calls, for which we are sending reply.
   // After that there are calls that are being processed.
   // first_without_reply_ points to the first of them.
-  // There are not more than max_concurrent_calls_ entries in first two groups.
-  // After end of queue there are calls that we received but processing did not start for them.
+  // There are started_calls_ entries in first two groups, not more than max_concurrent_calls_.
+  // After them there are calls that we received but processing did not start for them.
   std::deque<std::shared_ptr<QueueableInboundCall>> calls_queue_;
   std::shared_ptr<ReactorTask> flush_outbound_queue_task_;
 
@@ -22,6 +22,7 @@
 #include "yb/rpc/connection.h"
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/reactor.h"
+#include "yb/rpc/rpc_compression.h"
 #include "yb/rpc/rpc_introspection.pb.h"
 #include "yb/rpc/serialization.h"
 
@@ -254,6 +255,14 @@ Status YBInboundCall::ParseFrom(const MemTrackerPtr& mem_tracker, CallData* call
   consumption_ = ScopedTrackedConsumption(mem_tracker, call_data->size());
   request_data_ = std::move(*call_data);
 
+  if (header_.compression() != RPC_COMPRESSION_NONE) {
+    RETURN_NOT_OK(DecompressRpcMessage(
+        header_.compression(), serialized_request_, header_.uncompressed_size(),
+        &decompressed_request_));
+    serialized_request_ = decompressed_request_.as_slice();
+    consumption_.Add(decompressed_request_.size());
+  }
+
   // Adopt the service/method info from the header as soon as it's available.
   if (PREDICT_FALSE(!header_.has_remote_method())) {
     return STATUS(Corruption, "Non-connection context request header must specify remote_method");
@@ -314,6 +323,18 @@ Status YBInboundCall::SerializeResponseBuffer(const google::protobuf::MessageLit
 
   int additional_size = absolute_sidecar_offset - protobuf_msg_size;
 
+  if (header_.accepts_compressed_response() && !IsLocalCall()) {
+    // Server always could decompress requests, so announce it to the client that is aware of
+    // compression.
+    resp_hdr.set_accepts_compressed_requests(true);
+    auto compression = connection()->reactor()->messenger()->rpc_compression().For(
+        remote_method_.service_name(), absolute_sidecar_offset);
+    if (compression != RPC_COMPRESSION_NONE &&
+        VERIFY_RESULT(SerializeCompressedResponseBuffer(response, compression, &resp_hdr))) {
+      return Status::OK();
+    }
+  }
+
   size_t message_size = 0;
   auto status = SerializeMessage(response,
                                  /* param_buf */ nullptr,
@@ -340,6 +361,32 @@ Status YBInboundCall::SerializeResponseBuffer(const google::protobuf::MessageLit
                           header_size);
 }
 
+Result<bool> YBInboundCall::SerializeCompressedResponseBuffer(
+    const google::protobuf::MessageLite& response, RpcCompressionType compression,
+    ResponseHeader* resp_hdr) {
+  // Response and sidecars are compressed together, sidecar offsets stay the same.
+  faststring raw;
+  raw.resize(response.GetCachedSize());
+  response.SerializeWithCachedSizesToArray(raw.data());
+  for (const auto& car : sidecars_) {
+    raw.append(car.data(), car.size());
+  }
+
+  faststring compressed;
+  if (!CompressRpcMessage(compression, raw, &compressed)) {
+    return false;
+  }
+
+  resp_hdr->set_compression(compression);
+  resp_hdr->set_uncompressed_size(raw.size());
+  RETURN_NOT_OK(SerializeRpcFrame(*resp_hdr, compressed, &response_buf_));
+  RecordRpcCompression(&connection()->rpc_metrics(), raw.size(), compressed.size());
+
+  // Sidecars are sent as part of compressed response.
+  sidecars_.clear();
+  return true;
+}
+
 string YBInboundCall::ToString() const {
   return strings::Substitute("Call $0 $1 => $2 (request call id $3)",
       remote_method_.ToString(),
@@ -68,6 +68,7 @@ class YBInboundConnectionContext : public YBConnectionContext {
       : YBConnectionContext(receive_buffer_size, buffer_tracker, call_tracker) {}
 
   static std::string Name() { return "Inbound RPC"; }
+
  private:
   // Takes ownership of call_data content.
   CHECKED_STATUS HandleCall(const ConnectionPtr& connection, CallData* call_data) override;
@@ -184,7 +185,7 @@ class YBInboundCall : public InboundCall {
 
   size_t DynamicMemoryUsage() const override {
     return InboundCall::DynamicMemoryUsage() +
-           DynamicMemoryUsageOf(header_, response_buf_, remote_method_);
+           DynamicMemoryUsageOf(header_, response_buf_, remote_method_, decompressed_request_);
   }
 
  protected:
@@ -202,6 +203,12 @@ class YBInboundCall : public InboundCall {
   CHECKED_STATUS SerializeResponseBuffer(const google::protobuf::MessageLite& response,
                                          bool is_success);
 
+  // Serializes response together with sidecars as a single compressed message. Returns false if
+  // response should be sent uncompressed because compression does not reduce its size.
+  Result<bool> SerializeCompressedResponseBuffer(const google::protobuf::MessageLite& response,
+                                                 RpcCompressionType compression,
+                                                 ResponseHeader* resp_hdr);
+
   // The header of the incoming call. Set by ParseFrom()
   RequestHeader header_;
 
@@ -213,6 +220,9 @@ class YBInboundCall : public InboundCall {
   RemoteMethod remote_method_;
 
   ScopedTrackedConsumption consumption_;
+
+  // Uncompressed request when it was received compressed, serialized_request_ refers into it.
+  RefCntBuffer decompressed_request_;
 };
 
 class YBOutboundConnectionContext : public YBConnectionContext {
@@ -100,15 +100,17 @@ Status AbstractTablet::HandlePgsqlReadRequest(CoarseTimePoint deadline,
   RETURN_NOT_OK(CreatePagingStateForRead(
       pgsql_read_request, resultset.rsrow_count(), &result->response));
 
-  // TODO(neil) The clients' request should indicate what encoding method should be used. When
-  // multi-shard is used to process more complicated queries, proxy-server might prefer a different
-  // encoding. For now, we'll call PgsqlSerialize() without checking encoding method.
   result->response.set_status(PgsqlResponsePB::PGSQL_STATUS_OK);
 
-  // Serializing data for PgGate API.
+  // Serializing data for PgGate API using the encoding requested by the client.
   CHECK(!pgsql_read_request.has_rsrow_desc()) << "Row description is not needed";
   TRACE("Start Serialize");
-  RETURN_NOT_OK(pggate::PgDocData::WriteTuples(resultset, &result->rows_data));
+  if (pgsql_read_request.rows_data_format() == PGSQL_ROWS_DATA_COLUMNAR) {
+    RETURN_NOT_OK(pggate::PgDocData::WriteColumnarTuples(resultset, &result->rows_data));
+    result->response.set_rows_data_format(PGSQL_ROWS_DATA_COLUMNAR);
+  } else {
+    RETURN_NOT_OK(pggate::PgDocData::WriteTuples(resultset, &result->rows_data));
+  }
   TRACE("Done Serialize");
 
   return Status::OK();
@@ -30,6 +30,8 @@
 // under the License.
 //
 
+#include <deque>
+#include <thread>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -319,5 +321,56 @@ TEST_F(MvccTest, WaitForSafeTime) {
   ASSERT_FALSE(manager_.SafeTime(ht3, CoarseMonoClock::now() + 100ms, HybridTime::kMax));
 }
 
+// Measures throughput of SafeTime readers running concurrently with a writer that adds and
+// replicates operations. AddPending checks that new operations get hybrid time after all returned
+// safe times, so this test also verifies lock-free SafeTime.
+TEST_F(MvccTest, SafeTimeContention) {
+  constexpr int kNumReaders = 8;
+  const auto kTestTime = 2s;
+
+  std::atomic<bool> stop(false);
+  std::atomic<uint64_t> reads(0);
+  std::vector<std::thread> readers;
+  for (int i = 0; i != kNumReaders; ++i) {
+    readers.emplace_back([this, &stop, &reads] {
+      HybridTime last_safe_time = HybridTime::kMin;
+      uint64_t local_reads = 0;
+      while (!stop.load(std::memory_order_acquire)) {
+        auto safe_time = manager_.SafeTime(HybridTime::kMax);
+        ASSERT_GE(safe_time, last_safe_time);
+        last_safe_time = safe_time;
+        ++local_reads;
+      }
+      reads += local_reads;
+    });
+  }
+
+  uint64_t writes = 0;
+  std::deque<HybridTime> pending;
+  auto deadline = CoarseMonoClock::now() + kTestTime;
+  while (CoarseMonoClock::now() < deadline) {
+    HybridTime ht;
+    manager_.AddPending(&ht);
+    pending.push_back(ht);
+    if (pending.size() > 10) {
+      manager_.Replicated(pending.front());
+      pending.pop_front();
+    }
+    ++writes;
+  }
+  stop = true;
+  for (auto& thread : readers) {
+    thread.join();
+  }
+  for (auto ht : pending) {
+    manager_.Replicated(ht);
+  }
+
+  const auto seconds = ToSeconds(kTestTime);
+  LOG(INFO) << "Writes/sec: " << writes / seconds << ", reads/sec: " << reads.load() / seconds;
+  ASSERT_GT(writes, 0U);
+  ASSERT_GT(reads.load(), 0U);
+}
+
 } // namespace tablet
 } // namespace yb
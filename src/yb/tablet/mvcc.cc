@@ -35,10 +35,20 @@
 #include <sstream>
 
 #include "yb/util/logging.h"
+#include "yb/util/scope_exit.h"
 
 namespace yb {
 namespace tablet {
 
+namespace {
+
+void UpdateAtomicMax(std::atomic<HybridTime>* max, HybridTime value) {
+  auto current = max->load(std::memory_order_acquire);
+  while (value > current && !max->compare_exchange_weak(current, value)) {}
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // SafeTimeWithSource
 // ------------------------------------------------------------------------------------------------
@@ -63,7 +73,7 @@ void MvccManager::Replicated(HybridTime ht) {
     CHECK(!queue_.empty()) << LogPrefix();
     CHECK_EQ(queue_.front(), ht) << LogPrefix();
     PopFront(&lock);
-    last_replicated_ = ht;
+    last_replicated_.store(ht, std::memory_order_release);
   }
   cond_.notify_all();
 }
@@ -95,11 +105,23 @@ void MvccManager::PopFront(std::lock_guard<std::mutex>* lock) {
     queue_.pop_front();
     aborted_.pop();
   }
+  PublishQueueFront();
+}
+
+void MvccManager::PublishQueueFront() {
+  queue_front_.store(queue_.empty() ? HybridTime::kMax : queue_.front(),
+                     std::memory_order_release);
 }
 
 void MvccManager::AddPending(HybridTime* ht) {
   const bool is_follower_side = ht->is_valid();
   std::lock_guard<std::mutex> lock(mutex_);
+  // Lock-free SafeTime readers that observe odd sequence number or its change retry under mutex_,
+  // so they don't return clock time that is after the time of the operation being added.
+  add_pending_seq_.fetch_add(1);
+  auto se = ScopeExit([this] {
+    add_pending_seq_.fetch_add(1);
+  });
   if (is_follower_side) {
     // This must be a follower-side transaction with already known hybrid time.
     VLOG_WITH_PREFIX(1) << "AddPending(" << *ht << ")";
@@ -127,15 +149,21 @@ void MvccManager::AddPending(HybridTime* ht) {
       iter++;
     }
     queue_.erase(start_iter, iter);
+    PublishQueueFront();
   }
   HybridTime last_ht_in_queue = queue_.empty() ? HybridTime::kMin : queue_.back();
 
+  const SafeTimeWithSource max_safe_time_returned_with_lease{
+      max_safe_time_returned_with_lease_.load(std::memory_order_acquire)};
+  const SafeTimeWithSource max_safe_time_returned_without_lease{
+      max_safe_time_returned_without_lease_.load(std::memory_order_acquire)};
+  const HybridTime last_replicated = last_replicated_.load(std::memory_order_acquire);
   HybridTime sanity_check_lower_bound =
       std::max({
-          max_safe_time_returned_with_lease_.safe_time,
-          max_safe_time_returned_without_lease_.safe_time,
+          max_safe_time_returned_with_lease.safe_time,
+          max_safe_time_returned_without_lease.safe_time,
           max_safe_time_returned_for_follower_.safe_time,
-          last_replicated_,
+          last_replicated,
           last_ht_in_queue});
 
   if (*ht <= sanity_check_lower_bound) {
@@ -150,11 +178,11 @@ void MvccManager::AddPending(HybridTime* ht) {
           << "\n  "
 
       ss << "New operation's hybrid time too low: " << *ht
-         << LOG_INFO_FOR_HT_LOWER_BOUND(max_safe_time_returned_with_lease_)
-         << LOG_INFO_FOR_HT_LOWER_BOUND(max_safe_time_returned_without_lease_)
+         << LOG_INFO_FOR_HT_LOWER_BOUND(max_safe_time_returned_with_lease)
+         << LOG_INFO_FOR_HT_LOWER_BOUND(max_safe_time_returned_without_lease)
          << LOG_INFO_FOR_HT_LOWER_BOUND(max_safe_time_returned_for_follower_)
          << LOG_INFO_FOR_HT_LOWER_BOUND(
-                (SafeTimeWithSource{last_replicated_, SafeTimeSource::kUnknown}))
+                (SafeTimeWithSource{last_replicated, SafeTimeSource::kUnknown}))
          << LOG_INFO_FOR_HT_LOWER_BOUND(
                 (SafeTimeWithSource{last_ht_in_queue, SafeTimeSource::kUnknown}))
          << "\n  " << EXPR_VALUE_FOR_LOG(is_follower_side)
@@ -191,6 +219,9 @@ void MvccManager::AddPending(HybridTime* ht) {
     }
   }
   queue_.push_back(*ht);
+  if (queue_.size() == 1) {
+    PublishQueueFront();
+  }
 }
 
 void MvccManager::SetLastReplicated(HybridTime ht) {
@@ -198,7 +229,7 @@ void MvccManager::SetLastReplicated(HybridTime ht) {
 
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    last_replicated_ = ht;
+    last_replicated_.store(ht, std::memory_order_release);
   }
   cond_.notify_all();
 }
@@ -267,11 +298,12 @@ HybridTime MvccManager::SafeTimeForFollower(
   auto predicate = [this, &result, min_allowed] {
     // last_replicated_ is updated earlier than propagated_safe_time_, so because of concurrency it
     // could be greater than propagated_safe_time_.
-    if (propagated_safe_time_ > last_replicated_) {
+    const auto last_replicated = last_replicated_.load(std::memory_order_acquire);
+    if (propagated_safe_time_ > last_replicated) {
       result.safe_time = propagated_safe_time_;
       result.source = SafeTimeSource::kPropagated;
     } else {
-      result.safe_time = last_replicated_;
+      result.safe_time = last_replicated;
       result.source = SafeTimeSource::kLastReplicated;
     }
     return result.safe_time >= min_allowed;
@@ -294,83 +326,103 @@ HybridTime MvccManager::SafeTimeForFollower(
 HybridTime MvccManager::SafeTime(HybridTime min_allowed,
                                  CoarseTimePoint deadline,
                                  HybridTime ht_lease) const {
-  std::unique_lock<std::mutex> lock(mutex_);
-  return DoGetSafeTime(min_allowed, deadline, ht_lease, &lock);
+  return DoGetSafeTime(min_allowed, deadline, ht_lease, nullptr /* lock */);
+}
+
+SafeTimeWithSource MvccManager::ComputeSafeTime(bool has_lease) const {
+  SafeTimeWithSource result;
+  const auto queue_front = queue_front_.load(std::memory_order_acquire);
+  if (queue_front == HybridTime::kMax) {
+    result = { clock_->Now(), SafeTimeSource::kNow };
+    VLOG_WITH_PREFIX(2) << "DoGetSafeTime, Now: " << result.safe_time;
+  } else {
+    result = { queue_front.Decremented(), SafeTimeSource::kNextInQueue };
+    VLOG_WITH_PREFIX(2) << "DoGetSafeTime, Queue front (decremented): " << result.safe_time;
+  }
+
+  const auto max_ht_lease_seen = max_ht_lease_seen_.load(std::memory_order_acquire);
+  if (has_lease && result.safe_time > max_ht_lease_seen) {
+    result = { max_ht_lease_seen, SafeTimeSource::kHybridTimeLease };
+  }
+
+  // This function could be invoked at a follower, so it has a very old ht_lease. In this case it
+  // is safe to read at least at last_replicated_.
+  result.safe_time = std::max(result.safe_time, last_replicated_.load(std::memory_order_acquire));
+  return result;
 }
 
 HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
                                       const CoarseTimePoint deadline,
                                       const HybridTime ht_lease,
                                       std::unique_lock<std::mutex>* lock) const {
-  DCHECK_ONLY_NOTNULL(lock);
   CHECK(ht_lease.is_valid()) << LogPrefix();
   CHECK_LE(min_allowed, ht_lease) << LogPrefix();
 
   const bool has_lease = ht_lease.GetPhysicalValueMicros() < kMaxHybridTimePhysicalMicros;
   if (has_lease) {
-    max_ht_lease_seen_ = std::max(ht_lease, max_ht_lease_seen_);
+    UpdateAtomicMax(&max_ht_lease_seen_, ht_lease);
   }
 
-  HybridTime result;
-  SafeTimeSource source = SafeTimeSource::kUnknown;
-  auto predicate = [this, &result, &source, min_allowed, has_lease] {
-    if (queue_.empty()) {
-      result = clock_->Now();
-      source = SafeTimeSource::kNow;
-      VLOG_WITH_PREFIX(2) << "DoGetSafeTime, Now: " << result;
-    } else {
-      result = queue_.front().Decremented();
-      source = SafeTimeSource::kNextInQueue;
-      VLOG_WITH_PREFIX(2) << "DoGetSafeTime, Queue front (decremented): " << result;
-    }
+  auto& max_safe_time_returned = has_lease ? max_safe_time_returned_with_lease_
+                                           : max_safe_time_returned_without_lease_;
+  // Result should not be less than safe time returned by any call that has finished before
+  // this one started.
+  const auto enforced_min_time = max_safe_time_returned.load(std::memory_order_acquire);
 
-    if (has_lease && result > max_ht_lease_seen_) {
-      result = max_ht_lease_seen_;
-      source = SafeTimeSource::kHybridTimeLease;
+  SafeTimeWithSource result;
+  bool done = false;
+  if (!lock) {
+    // Sequence number and clock are accessed with sequentially consistent operations, so unchanged
+    // even sequence number guarantees that operation added after this check gets hybrid time
+    // after the clock time read here.
+    const auto seq = add_pending_seq_.load();
+    if ((seq & 1) == 0) {
+      result = ComputeSafeTime(has_lease);
+      done = result.safe_time >= min_allowed && add_pending_seq_.load() == seq;
     }
+  }
 
-    // This function could be invoked at a follower, so it has a very old ht_lease. In this case it
-    // is safe to read at least at last_replicated_.
-    result = std::max(result, last_replicated_);
-
-    return result >= min_allowed;
-  };
+  if (!done) {
+    std::unique_lock<std::mutex> local_lock;
+    if (!lock) {
+      local_lock = std::unique_lock<std::mutex>(mutex_);
+      lock = &local_lock;
+    }
+    auto predicate = [this, &result, min_allowed, has_lease] {
+      result = ComputeSafeTime(has_lease);
+      return result.safe_time >= min_allowed;
+    };
 
-  // In the case of an empty queue, the safe hybrid time to read at is only limited by hybrid time
-  // ht_lease, which is by definition higher than min_allowed, so we would not get blocked.
-  if (deadline == CoarseTimePoint::max()) {
-    cond_.wait(*lock, predicate);
-  } else if (!cond_.wait_until(*lock, deadline, predicate)) {
-    return HybridTime::kInvalid;
+    // In the case of an empty queue, the safe hybrid time to read at is only limited by hybrid
+    // time ht_lease, which is by definition higher than min_allowed, so we would not get blocked.
+    if (deadline == CoarseTimePoint::max()) {
+      cond_.wait(*lock, predicate);
+    } else if (!cond_.wait_until(*lock, deadline, predicate)) {
+      return HybridTime::kInvalid;
+    }
   }
   VLOG_WITH_PREFIX(1) << "DoGetSafeTime(" << min_allowed << ", "
-                      << ht_lease << "), result = " << result;
+                      << ht_lease << "), result = " << result.ToString();
 
-  auto enforced_min_time = has_lease ? max_safe_time_returned_with_lease_.safe_time
-                                     : max_safe_time_returned_without_lease_.safe_time;
-  CHECK_GE(result, enforced_min_time) << LogPrefix()
+  CHECK_GE(result.safe_time, enforced_min_time) << LogPrefix()
       << ": " << EXPR_VALUE_FOR_LOG(has_lease)
-      << ", " << EXPR_VALUE_FOR_LOG(enforced_min_time.ToUint64() - result.ToUint64())
+      << ", " << EXPR_VALUE_FOR_LOG(result.source)
+      << ", " << EXPR_VALUE_FOR_LOG(enforced_min_time.ToUint64() - result.safe_time.ToUint64())
       << ", " << EXPR_VALUE_FOR_LOG(ht_lease)
-      << ", " << EXPR_VALUE_FOR_LOG(max_ht_lease_seen_)
-      << ", " << EXPR_VALUE_FOR_LOG(last_replicated_)
+      << ", " << EXPR_VALUE_FOR_LOG(max_ht_lease_seen_.load())
+      << ", " << EXPR_VALUE_FOR_LOG(last_replicated_.load())
       << ", " << EXPR_VALUE_FOR_LOG(clock_->Now())
       << ", " << EXPR_VALUE_FOR_LOG(ToString(deadline))
-      << ", " << EXPR_VALUE_FOR_LOG(queue_.size())
-      << ", " << EXPR_VALUE_FOR_LOG(queue_);
+      << ", " << EXPR_VALUE_FOR_LOG(queue_front_.load());
 
-  if (has_lease) {
-    max_safe_time_returned_with_lease_ = { result, source };
-  } else {
-    max_safe_time_returned_without_lease_ = { result, source };
-  }
-  return result;
+  UpdateAtomicMax(&max_safe_time_returned, result.safe_time);
+  return result.safe_time;
 }
 
 HybridTime MvccManager::LastReplicatedHybridTime() const {
-  std::lock_guard<std::mutex> lock(mutex_);
-  VLOG_WITH_PREFIX(1) << __func__ << "(), result = " << last_replicated_;
-  return last_replicated_;
+  const auto result = last_replicated_.load(std::memory_order_acquire);
+  VLOG_WITH_PREFIX(1) << __func__ << "(), result = " << result;
+  return result;
 }
 
 }  // namespace tablet
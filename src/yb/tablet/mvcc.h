@@ -32,6 +32,7 @@
 #ifndef YB_TABLET_MVCC_H_
 #define YB_TABLET_MVCC_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <deque>
@@ -64,6 +65,11 @@ struct SafeTimeWithSource {
 // methods.
 // Operations could be replicated only in the same order as they were added.
 // Time of newly added operation should be after time of all previously added operations.
+//
+// Operations are added and removed under mutex, while SafeTime reads the head of the queue, last
+// replicated time and clock without it. Such reads are validated using sequence number that is
+// odd while AddPending picks time for a new operation, so reader that raced with AddPending, or
+// has to wait for safe time, falls back to the calculation under mutex.
 class MvccManager {
  public:
   // `prefix` is used for logging.
@@ -131,14 +137,22 @@ class MvccManager {
   HybridTime LastReplicatedHybridTime() const;
 
  private:
+  // Calculates safe time. When `lock` is null tries to do it without locking mutex_ first.
   HybridTime DoGetSafeTime(HybridTime min_allowed,
                            CoarseTimePoint deadline,
                            HybridTime ht_lease,
                            std::unique_lock<std::mutex>* lock) const;
 
+  // Returns safe time for the current state of the queue, could be invoked without mutex_.
+  SafeTimeWithSource ComputeSafeTime(bool has_lease) const;
+
   const std::string& LogPrefix() const { return prefix_; }
   void PopFront(std::lock_guard<std::mutex>* lock);
 
+  // Makes the first element of queue_ visible to lock-free readers. Should be invoked under
+  // mutex_ after each change of the queue head.
+  void PublishQueueFront();
+
   std::string prefix_;
   server::ClockPtr clock_;
   mutable std::mutex mutex_;
@@ -147,11 +161,18 @@ class MvccManager {
   // An ordered queue of times of tracked operations.
   std::deque<HybridTime> queue_;
 
+  // Time of the first operation in queue_, kMax when queue_ is empty.
+  std::atomic<HybridTime> queue_front_{HybridTime::kMax};
+
+  // Incremented by AddPending before it picks time for a new operation and after the operation is
+  // added to queue_.
+  std::atomic<uint64_t> add_pending_seq_{0};
+
   // Priority queue (min-heap, hence std::greater<> as the "less" comparator) of aborted operations.
   // Required because we could abort operations from the middle of the queue.
   std::priority_queue<HybridTime, std::vector<HybridTime>, std::greater<>> aborted_;
 
-  HybridTime last_replicated_ = HybridTime::kMin;
+  std::atomic<HybridTime> last_replicated_{HybridTime::kMin};
 
   // If we are a follower, this is the latest safe time sent by the leader to us. If we are the
   // leader, this is a safe time that gets updated every time the majority-replicated watermarks
@@ -163,10 +184,10 @@ class MvccManager {
   // Because different calls that have current hybrid time leader lease as an argument can come to
   // us out of order, we might see an older value of hybrid time leader lease expiration after a
   // newer value. We mitigate this by always using the highest value we've seen.
-  mutable HybridTime max_ht_lease_seen_ = HybridTime::kMin;
+  mutable std::atomic<HybridTime> max_ht_lease_seen_{HybridTime::kMin};
 
-  mutable SafeTimeWithSource max_safe_time_returned_with_lease_;
-  mutable SafeTimeWithSource max_safe_time_returned_without_lease_;
+  mutable std::atomic<HybridTime> max_safe_time_returned_with_lease_{HybridTime::kMin};
+  mutable std::atomic<HybridTime> max_safe_time_returned_without_lease_{HybridTime::kMin};
   mutable SafeTimeWithSource max_safe_time_returned_for_follower_ { HybridTime::kMin };
 };
 
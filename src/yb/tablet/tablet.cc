@@ -397,6 +397,7 @@ Tablet::Tablet(
         metadata->schema().table_properties().is_transactional()))) {
     transaction_participant_ = std::make_unique<TransactionParticipant>(
         transaction_participant_context, this, metric_entity_);
+    wait_queue_ = std::make_unique<docdb::WaitQueue>(metric_entity_);
     // Create transaction manager for secondary index update.
     if (!metadata_->index_map().empty()) {
       transaction_manager_.emplace(client_future_.get(),
@@ -546,7 +547,7 @@ Status Tablet::OpenKeyValueTablet() {
   rocksdb::Options rocksdb_options;
   docdb::InitRocksDBOptions(
       &rocksdb_options, LogPrefix(docdb::StorageDbType::kRegular), rocksdb_statistics_,
-      tablet_options_);
+      tablet_options_, metadata()->data_root_dir());
   rocksdb_options.mem_tracker = MemTracker::FindOrCreateTracker(kRegularDB, mem_tracker_);
   rocksdb_options.block_based_table_mem_tracker = MemTracker::FindOrCreateTracker(
       Format("$0-$1", kRegularDB, tablet_id()), block_based_table_mem_tracker_);
@@ -587,8 +588,13 @@ Status Tablet::OpenKeyValueTablet() {
 
   if (transaction_participant_) {
     LOG_WITH_PREFIX(INFO) << "Opening intents DB at: " << db_dir + kIntentsDBSuffix;
+    // Intents DB reuses options of the regular DB, so it shares the rate limiter of the data
+    // directory with it.
     docdb::SetLogPrefix(&rocksdb_options, LogPrefix(docdb::StorageDbType::kIntents));
 
+    // Range filters are built from DocDB keys, so they are useful only for the regular DB.
+    rocksdb_options.table_properties_collector_factories.clear();
+
     rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
       return std::bind(&Tablet::IntentsDbFlushFilter, this, _1);
     });
@@ -818,7 +824,8 @@ void Tablet::StartOperation(WriteOperationState* operation_state) {
   }
 }
 
-Status Tablet::ApplyRowOperations(WriteOperationState* operation_state) {
+Status Tablet::ApplyRowOperations(
+    WriteOperationState* operation_state, rocksdb::WriteBatch* prepared_batch) {
   const KeyValueWriteBatchPB& put_batch =
       operation_state->consensus_round() && operation_state->consensus_round()->replicate_msg()
           // Online case.
@@ -839,6 +846,11 @@ Status Tablet::ApplyRowOperations(WriteOperationState* operation_state) {
   // Even if we have an external hybrid time, use the local commit hybrid time in the consensus
   // frontier.
   set_hybrid_time(operation_state->hybrid_time(), &frontiers);
+  if (prepared_batch) {
+    DCHECK(!put_batch.has_transaction());
+    WriteToRocksDB(&frontiers, prepared_batch, StorageDbType::kRegular);
+    return Status::OK();
+  }
   return ApplyKeyValueRowOperations(put_batch, &frontiers, hybrid_time);
 }
 
@@ -1545,6 +1557,9 @@ Status Tablet::ApplyIntents(const TransactionApplyData& data) {
   docdb::ConsensusFrontiers frontiers;
   InitFrontiers(data, &frontiers);
   WriteToRocksDB(&frontiers, &regular_write_batch, StorageDbType::kRegular);
+  if (wait_queue_) {
+    wait_queue_->SignalFinished(data.transaction_id);
+  }
   return Status::OK();
 }
 
@@ -1563,6 +1578,9 @@ CHECKED_STATUS Tablet::RemoveIntentsImpl(const RemoveIntentsData& data, const Id
   docdb::ConsensusFrontiers frontiers;
   InitFrontiers(data, &frontiers);
   WriteToRocksDB(&frontiers, &intents_write_batch, StorageDbType::kIntents);
+  if (wait_queue_) {
+    wait_queue_->SignalFinished(ids);
+  }
   return Status::OK();
 }
 
@@ -1775,7 +1793,9 @@ Status Tablet::Truncate(TruncateOperationState *state) {
   const string db_dir = regular_db_->GetName();
 
   rocksdb::Options rocksdb_options;
-  docdb::InitRocksDBOptions(&rocksdb_options, LogPrefix(), rocksdb_statistics_, tablet_options_);
+  docdb::InitRocksDBOptions(
+      &rocksdb_options, LogPrefix(), rocksdb_statistics_, tablet_options_,
+      metadata()->data_root_dir());
 
   Status intents_status;
   if (intents_db_) {
@@ -1996,6 +2016,17 @@ Status Tablet::StartDocWriteOperation(WriteOperation* operation) {
   }
 
   const auto partial_range_key_intents = UsePartialRangeKeyIntents(metadata_.get());
+  if (wait_queue_ && txns_enabled_ && transactional_table &&
+      isolation_level != IsolationLevel::NON_TRANSACTIONAL) {
+    // Waiting happens before taking in-memory locks, so transactions that we are waiting for could
+    // proceed with their writes to the same keys.
+    auto read_time = operation->read_time();
+    docdb::WaitForConflictingTransactions(
+        operation->doc_ops(), *write_batch, clock_.get(),
+        read_time ? read_time.read : HybridTime::kMax, doc_db(), partial_range_key_intents,
+        transaction_participant_.get(), wait_queue_.get(), operation->deadline());
+  }
+
   auto prepare_result = VERIFY_RESULT(docdb::PrepareDocWriteOperation(
       operation->doc_ops(), write_batch->read_pairs(), metrics_->write_lock_latency,
       isolation_level, operation->state()->kind(), row_mark_type, transactional_table,
@@ -2410,7 +2441,9 @@ Status Tablet::RestoreCheckpoint(const std::string& dir, const docdb::ConsensusF
   key_bounds_ = docdb::KeyBounds::kNoBounds;
 
   rocksdb::Options rocksdb_options;
-  docdb::InitRocksDBOptions(&rocksdb_options, LogPrefix(), rocksdb_statistics_, tablet_options_);
+  docdb::InitRocksDBOptions(
+      &rocksdb_options, LogPrefix(), rocksdb_statistics_, tablet_options_,
+      metadata()->data_root_dir());
 
   Status s = rocksdb::DestroyDB(db_dir, rocksdb_options);
   if (PREDICT_FALSE(!s.ok())) {
@@ -58,6 +58,7 @@
 #include "yb/docdb/doc_operation.h"
 #include "yb/docdb/ql_rocksdb_storage.h"
 #include "yb/docdb/shared_lock_manager.h"
+#include "yb/docdb/wait_queue.h"
 
 #include "yb/gutil/atomicops.h"
 #include "yb/gutil/gscoped_ptr.h"
@@ -253,7 +254,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   void StartOperation(WriteOperationState* operation_state);
 
   // Apply all of the row operations associated with this transaction.
-  CHECKED_STATUS ApplyRowOperations(WriteOperationState* operation_state);
+  // prepared_batch, if specified, is the RocksDB write batch already prepared from the
+  // non-transactional write batch of the operation, so it is written as is.
+  CHECKED_STATUS ApplyRowOperations(
+      WriteOperationState* operation_state, rocksdb::WriteBatch* prepared_batch = nullptr);
 
   // Apply a set of RocksDB row operations.
   // If rocksdb_write_batch is specified it could contain preencoded RocksDB operations.
@@ -712,6 +716,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::unique_ptr<TransactionParticipant> transaction_participant_;
 
+  // Queue of transactional writes blocked by pending transactions, created together with
+  // transaction participant.
+  std::unique_ptr<docdb::WaitQueue> wait_queue_;
+
   std::shared_future<client::YBClient*> client_future_;
 
   // Created only when secondary indexes are present.
@@ -30,6 +30,7 @@
 // under the License.
 //
 
+#include <algorithm>
 #include <vector>
 
 #include "yb/consensus/consensus_meta.h"
@@ -134,6 +135,7 @@ class BootstrapTest : public LogTestBase {
         .local_tablet_filter = client::LocalTabletFilter(),
         .transaction_coordinator_context = nullptr,
         .append_pool = append_pool_.get(),
+        .log_replay_pool = log_replay_pool_.get(),
         .retryable_requests = nullptr,
         .txns_enabled = TransactionsEnabled::kTrue,
         .is_sys_catalog = IsSysCatalogTablet::kFalse
@@ -174,6 +176,8 @@ class BootstrapTest : public LogTestBase {
       VLOG(1) << result;
     }
   }
+
+  std::unique_ptr<ThreadPool> log_replay_pool_;
 };
 
 // Tests a normal bootstrap scenario.
@@ -342,6 +346,44 @@ TEST_F(BootstrapTest, TestConsensusOnlyOperationOutOfOrderHybridTime) {
   ASSERT_EQ(1, results.size());
 }
 
+// Tests bootstrap that reads segments and prepares write batches ahead of replay.
+TEST_F(BootstrapTest, TestPipelinedReplay) {
+  ASSERT_OK(ThreadPoolBuilder("log-replay").set_max_threads(2).Build(&log_replay_pool_));
+  BuildLog();
+
+  constexpr int kNumSegments = 5;
+  constexpr int kOpsPerSegment = 10;
+  // Each operation commits the previous one, so the last one is not committed.
+  auto committed_opid = MakeOpId(0, 0);
+  for (int segment = 0; segment != kNumSegments; ++segment) {
+    for (int i = 0; i != kOpsPerSegment; ++i) {
+      const int row = segment * kOpsPerSegment + i;
+      const auto opid = MakeOpId(1, current_index_++);
+      AppendReplicateBatch(opid, committed_opid, {TupleForAppend(row, 0, "this is a test insert")});
+      committed_opid = opid;
+    }
+    ASSERT_OK(RollLog());
+  }
+
+  // Overwrite the last operation with a new term, so its prepared write batch should not be used.
+  const auto overwriting_opid = MakeOpId(2, current_index_ - 1);
+  AppendReplicateBatch(overwriting_opid, overwriting_opid,
+                       {TupleForAppend(0, 1, "this is a test mutate")});
+
+  ConsensusBootstrapInfo boot_info;
+  shared_ptr<TabletClass> tablet;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+  ASSERT_EQ(0, boot_info.orphaned_replicates.size());
+  ASSERT_OPID_EQ(overwriting_opid, boot_info.last_committed_id);
+
+  vector<string> results;
+  IterateTabletRows(tablet.get(), &results);
+  ASSERT_EQ(kNumSegments * kOpsPerSegment - 1, results.size());
+  ASSERT_EQ(1, std::count(
+      results.begin(), results.end(),
+      "{ int32_value: 0 int32_value: 1 string_value: \"this is a test mutate\" }"));
+}
+
 // Test that we don't overflow opids. Regression test for KUDU-1933.
 TEST_F(BootstrapTest, TestBootstrapHighOpIdIndex) {
   // Start appending with a log index 3 under the int32 max value.
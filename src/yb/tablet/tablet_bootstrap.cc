@@ -31,6 +31,10 @@
 //
 #include "yb/tablet/tablet_bootstrap.h"
 
+#include <deque>
+#include <future>
+#include <limits>
+
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/log_reader.h"
@@ -53,6 +57,8 @@
 #include "yb/util/env_util.h"
 #include "yb/consensus/log_index.h"
 #include "yb/docdb/consensus_frontier.h"
+#include "yb/docdb/docdb.h"
+#include "yb/rocksdb/write_batch.h"
 #include "yb/tserver/backup.pb.h"
 
 DEFINE_bool(skip_remove_old_recovery_dir, false,
@@ -82,6 +88,25 @@ DEFINE_bool(skip_flushed_entries, true,
 
 DECLARE_int32(retryable_request_timeout_secs);
 
+DEFINE_int32(log_replay_readahead_segments, 2,
+             "Number of WAL segments that are read, decoded and prepared for replay ahead of the "
+             "replayed segment during tablet bootstrap, when the log replay pool is enabled.");
+TAG_FLAG(log_replay_readahead_segments, advanced);
+
+METRIC_DEFINE_counter(tablet, log_replay_read_time, "Log Replay Read Time",
+                      yb::MetricUnit::kMicroseconds,
+                      "Time spent on reading and decoding WAL segments during tablet bootstrap.");
+METRIC_DEFINE_counter(tablet, log_replay_prepare_time, "Log Replay Prepare Time",
+                      yb::MetricUnit::kMicroseconds,
+                      "Time spent by the log replay pool on preparing RocksDB write batches of "
+                      "replayed operations during tablet bootstrap.");
+METRIC_DEFINE_counter(tablet, log_replay_read_wait_time, "Log Replay Read Wait Time",
+                      yb::MetricUnit::kMicroseconds,
+                      "Time that tablet bootstrap waited for WAL segments to be read.");
+METRIC_DEFINE_counter(tablet, log_replay_apply_time, "Log Replay Apply Time",
+                      yb::MetricUnit::kMicroseconds,
+                      "Time spent on applying replayed operations during tablet bootstrap.");
+
 namespace yb {
 namespace tablet {
 
@@ -128,6 +153,14 @@ static string DebugInfo(const string& tablet_id,
                     segment_path, debug_str);
 }
 
+namespace {
+
+int64_t MicrosecondsSince(MonoTime start) {
+  return (MonoTime::Now() - start).ToMicroseconds();
+}
+
+} // namespace
+
 // ============================================================================
 //  Class ReplayState.
 // ============================================================================
@@ -299,6 +332,81 @@ bool ReplayState::CanApply(LogEntryPB* entry) {
   return consensus::OpIdCompare(entry->replicate().id(), committed_op_id) <= 0;
 }
 
+// ============================================================================
+//  Class TabletBootstrap::SegmentReader.
+// ============================================================================
+
+// Entries of the log segment with write batches prepared for them.
+struct TabletBootstrap::ReplaySegment {
+  log::ReadEntriesResult read_result;
+  // Prepared write batches with op index.
+  std::vector<std::pair<int64_t, PreparedWriteBatch>> prepared_batches;
+};
+
+// Reads log segments in replay order. When the log replay pool is specified, up to
+// log_replay_readahead_segments segments following the replayed one are read by the pool, that
+// also prepares RocksDB write batches for their non-transactional write operations. Such a batch
+// depends only on the operation itself, while operations are still applied one by one in Raft
+// order, so frontiers of flushed data stay consistent with the set of applied operations.
+class TabletBootstrap::SegmentReader {
+ public:
+  SegmentReader(TabletBootstrap* bootstrap,
+                log::SegmentSequence::const_iterator begin,
+                log::SegmentSequence::const_iterator end,
+                int64_t min_index_to_prepare)
+      : bootstrap_(bootstrap), next_(begin), end_(end),
+        min_index_to_prepare_(bootstrap->data_.log_replay_pool
+            ? min_index_to_prepare : std::numeric_limits<int64_t>::max()) {
+  }
+
+  ~SegmentReader() {
+    // Tasks refer to the bootstrap, so wait for them even when replay has failed.
+    for (auto& future : read_ahead_) {
+      future.wait();
+    }
+  }
+
+  // Returns the next segment of the range, should not be called after the last one.
+  ReplaySegment Next() {
+    ReadAhead();
+    if (read_ahead_.empty()) {
+      return bootstrap_->ReadSegment(*next_++, min_index_to_prepare_);
+    }
+    auto start = MonoTime::Now();
+    auto result = read_ahead_.front().get();
+    read_ahead_.pop_front();
+    bootstrap_->replay_phase_times_.read_wait_us += MicrosecondsSince(start);
+    ReadAhead();
+    return result;
+  }
+
+ private:
+  void ReadAhead() {
+    auto* pool = bootstrap_->data_.log_replay_pool;
+    if (!pool) {
+      return;
+    }
+    const size_t max_read_ahead = std::max(FLAGS_log_replay_readahead_segments, 1);
+    while (next_ != end_ && read_ahead_.size() < max_read_ahead) {
+      auto task = std::make_shared<std::packaged_task<ReplaySegment()>>(std::bind(
+          &TabletBootstrap::ReadSegment, bootstrap_, *next_, min_index_to_prepare_));
+      read_ahead_.push_back(task->get_future());
+      ++next_;
+      auto status = pool->SubmitFunc([task] { (*task)(); });
+      if (!status.ok()) {
+        YB_LOG_EVERY_N_SECS(WARNING, 10) << "Failed to submit log segment read: " << status;
+        (*task)();
+      }
+    }
+  }
+
+  TabletBootstrap* const bootstrap_;
+  log::SegmentSequence::const_iterator next_;
+  const log::SegmentSequence::const_iterator end_;
+  const int64_t min_index_to_prepare_;
+  std::deque<std::future<ReplaySegment>> read_ahead_;
+};
+
 // ============================================================================
 //  Class TabletBootstrap.
 // ============================================================================
@@ -563,6 +671,7 @@ Status TabletBootstrap::OpenNewLog() {
   auto log_options = LogOptions();
   log_options.retention_secs = tablet_->metadata()->wal_retention_secs();
   log_options.env = GetEnv();
+  log_options.sync_scheduler = data_.log_sync_scheduler;
   RETURN_NOT_OK(Log::Open(log_options,
                           tablet_->tablet_id(),
                           tablet_->metadata()->wal_dir(),
@@ -783,7 +892,9 @@ Status TabletBootstrap::HandleEntryPair(
   }
 
   if (replicate->id().index() > flushed_index) {
+    auto start = MonoTime::Now();
     const auto status = HandleOperation(op_type, replicate);
+    replay_phase_times_.apply_us += MicrosecondsSince(start);
     if (!status.ok()) {
       return status.CloneAndAppend(Format(
           "Failed to play $0 request. ReplicateMsg: { $1 }",
@@ -819,6 +930,58 @@ void TabletBootstrap::DumpReplayStateToLog(const ReplayState& state) {
   }
 }
 
+TabletBootstrap::ReplaySegment TabletBootstrap::ReadSegment(
+    const scoped_refptr<ReadableLogSegment>& segment, int64_t min_index_to_prepare) {
+  ReplaySegment result;
+  auto start = MonoTime::Now();
+  result.read_result = segment->ReadEntries();
+  replay_phase_times_.read_us += MicrosecondsSince(start);
+  if (min_index_to_prepare == std::numeric_limits<int64_t>::max()) {
+    return result;
+  }
+
+  start = MonoTime::Now();
+  for (const auto& entry : result.read_result.entries) {
+    if (entry->type() != log::REPLICATE) {
+      continue;
+    }
+    const auto& replicate = entry->replicate();
+    if (replicate.op_type() != consensus::WRITE_OP ||
+        replicate.id().index() <= min_index_to_prepare) {
+      continue;
+    }
+    const auto& write = replicate.write_request();
+    const auto& put_batch = write.write_batch();
+    if (put_batch.has_transaction() || !put_batch.read_pairs().empty()) {
+      continue;
+    }
+    // Should match the hybrid time picked by Tablet::ApplyRowOperations.
+    HybridTime hybrid_time(write.has_external_hybrid_time() ? write.external_hybrid_time()
+                                                            : replicate.hybrid_time());
+    auto batch = std::make_unique<rocksdb::WriteBatch>();
+    docdb::PrepareNonTransactionWriteBatch(put_batch, hybrid_time, batch.get());
+    result.prepared_batches.emplace_back(
+        replicate.id().index(), PreparedWriteBatch{replicate.id().term(), std::move(batch)});
+  }
+  replay_phase_times_.prepare_us += MicrosecondsSince(start);
+  return result;
+}
+
+std::unique_ptr<rocksdb::WriteBatch> TabletBootstrap::TakePreparedWriteBatch(
+    const consensus::OpId& op_id) {
+  std::unique_ptr<rocksdb::WriteBatch> result;
+  // Operations are replayed in index order, so batches with lower indexes would not be used.
+  auto end = prepared_write_batches_.upper_bound(op_id.index());
+  if (end != prepared_write_batches_.begin()) {
+    auto& last = *std::prev(end);
+    if (last.first == op_id.index() && last.second.term == op_id.term()) {
+      result = std::move(last.second.batch);
+    }
+  }
+  prepared_write_batches_.erase(prepared_write_batches_.begin(), end);
+  return result;
+}
+
 Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
   auto flushed_op_id = VERIFY_RESULT(tablet_->MaxPersistentOpId());
   if (FLAGS_force_recover_flushed_frontier) {
@@ -905,10 +1068,15 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
   int segment_count = 0;
   yb::OpId last_committed_op_id;
   RestartSafeCoarseTimePoint last_entry_time;
+  SegmentReader segment_reader(this, iter, segments.end(), state.regular_stored_op_id.index());
   for (; iter != segments.end(); ++iter) {
     const scoped_refptr<ReadableLogSegment>& segment = *iter;
 
-    auto read_result = segment->ReadEntries();
+    auto replay_segment = segment_reader.Next();
+    for (auto& index_and_batch : replay_segment.prepared_batches) {
+      prepared_write_batches_[index_and_batch.first] = std::move(index_and_batch.second);
+    }
+    auto& read_result = replay_segment.read_result;
     last_committed_op_id = std::max(last_committed_op_id, read_result.committed_op_id);
     for (int entry_idx = 0; entry_idx < read_result.entries.size(); ++entry_idx) {
       Status s = HandleEntry(
@@ -944,10 +1112,11 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
     // TODO: could be more granular here and log during the segments as well, plus give info about
     // number of MB processed, but this is better than nothing.
     listener_->StatusMessage(Substitute("Bootstrap replayed $0/$1 log segments. "
-                                        "Stats: $2. Pending: $3 replicates",
+                                        "Stats: $2. Pending: $3 replicates. Phase times: $4",
                                         segment_count + 1, segments.size(),
                                         stats_.ToString(),
-                                        state.pending_replicates.size()));
+                                        state.pending_replicates.size(),
+                                        replay_phase_times_.ToString()));
     segment_count++;
   }
 
@@ -977,6 +1146,20 @@ Status TabletBootstrap::PlaySegments(ConsensusBootstrapInfo* consensus_info) {
     }
   }
 
+  prepared_write_batches_.clear();
+  LOG_WITH_PREFIX(INFO) << "Log replay phase times: " << replay_phase_times_.ToString();
+  const auto& metric_entity = tablet_->GetMetricEntity();
+  if (metric_entity) {
+    METRIC_log_replay_read_time.Instantiate(metric_entity)->IncrementBy(
+        replay_phase_times_.read_us);
+    METRIC_log_replay_prepare_time.Instantiate(metric_entity)->IncrementBy(
+        replay_phase_times_.prepare_us);
+    METRIC_log_replay_read_wait_time.Instantiate(metric_entity)->IncrementBy(
+        replay_phase_times_.read_wait_us);
+    METRIC_log_replay_apply_time.Instantiate(metric_entity)->IncrementBy(
+        replay_phase_times_.apply_us);
+  }
+
   LOG_WITH_PREFIX(INFO) << "Dumping replay state to log at the end of " << __FUNCTION__;
   DumpReplayStateToLog(state);
 
@@ -1026,7 +1209,9 @@ void TabletBootstrap::PlayWriteRequest(ReplicateMsg* replicate_msg) {
   // Use committed OpId for mem store anchoring.
   operation_state.mutable_op_id()->CopyFrom(replicate_msg->id());
 
-  WARN_NOT_OK(tablet_->ApplyRowOperations(&operation_state), "ApplyRowOperations failed: ");
+  auto prepared_batch = TakePreparedWriteBatch(replicate_msg->id());
+  WARN_NOT_OK(tablet_->ApplyRowOperations(&operation_state, prepared_batch.get()),
+              "ApplyRowOperations failed: ");
 
   tablet_->mvcc_manager()->Replicated(hybrid_time);
 }
@@ -1169,5 +1354,10 @@ string TabletBootstrap::Stats::ToString() const {
                     mutations_seen, mutations_ignored);
 }
 
+string TabletBootstrap::ReplayPhaseTimes::ToString() const {
+  return Format("{ read_us: $0 prepare_us: $1 read_wait_us: $2 apply_us: $3 }",
+                read_us.load(), prepare_us.load(), read_wait_us.load(), apply_us.load());
+}
+
 } // namespace tablet
 } // namespace yb
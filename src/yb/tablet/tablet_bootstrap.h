@@ -32,12 +32,21 @@
 #ifndef YB_TABLET_TABLET_BOOTSTRAP_H
 #define YB_TABLET_TABLET_BOOTSTRAP_H
 
+#include <atomic>
+#include <map>
+
 #include "yb/tablet/tablet_bootstrap_if.h"
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/log_reader.h"
 #include "yb/util/threadpool.h"
 
+namespace rocksdb {
+
+class WriteBatch;
+
+} // namespace rocksdb
+
 namespace yb {
 namespace tablet {
 
@@ -128,6 +137,19 @@ class TabletBootstrap {
 
   void DumpReplayStateToLog(const ReplayState& state);
 
+  struct ReplaySegment;
+  class SegmentReader;
+
+  // Reads entries of the segment. Also prepares RocksDB write batches for non-transactional write
+  // operations with index greater than min_index_to_prepare. Could be invoked by the log replay
+  // pool concurrently with replay.
+  ReplaySegment ReadSegment(
+      const scoped_refptr<log::ReadableLogSegment>& segment, int64_t min_index_to_prepare);
+
+  // Returns RocksDB write batch prepared by the log replay pool for the write operation with
+  // specified id, or nullptr if there is no such batch.
+  std::unique_ptr<rocksdb::WriteBatch> TakePreparedWriteBatch(const consensus::OpId& op_id);
+
   // Handlers for each type of message seen in the log during replay.
   CHECKED_STATUS HandleEntry(
       yb::log::LogEntryMetadata entry_metadata, ReplayState* state,
@@ -194,6 +216,29 @@ class TabletBootstrap {
     int mutations_seen, mutations_ignored;
   } stats_;
 
+  // Time spent in each phase of log replay.
+  struct ReplayPhaseTimes {
+    // Reading segments, checking CRC and decoding entries.
+    std::atomic<int64_t> read_us{0};
+    // Preparing RocksDB write batches by the log replay pool.
+    std::atomic<int64_t> prepare_us{0};
+    // Waiting for segments that were not read ahead yet.
+    std::atomic<int64_t> read_wait_us{0};
+    // Applying operations to the tablet.
+    std::atomic<int64_t> apply_us{0};
+
+    std::string ToString() const;
+  } replay_phase_times_;
+
+  // RocksDB write batch prepared for the non-transactional write operation ahead of its replay.
+  struct PreparedWriteBatch {
+    int64_t term;
+    std::unique_ptr<rocksdb::WriteBatch> batch;
+  };
+
+  // Prepared write batches of operations that were not replayed yet, keyed by op index.
+  std::map<int64_t, PreparedWriteBatch> prepared_write_batches_;
+
   HybridTime rocksdb_last_entry_hybrid_time_ = HybridTime::kMin;
 
   bool skip_wal_rewrite_;
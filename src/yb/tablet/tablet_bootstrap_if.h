@@ -61,6 +61,7 @@ class PartitionSchema;
 namespace log {
 class Log;
 class LogAnchorRegistry;
+class LogSyncScheduler;
 }
 
 namespace consensus {
@@ -127,6 +128,8 @@ struct BootstrapTabletData {
   client::LocalTabletFilter local_tablet_filter;
   TransactionCoordinatorContext* transaction_coordinator_context = nullptr;
   ThreadPool* append_pool = nullptr;
+  log::LogSyncScheduler* log_sync_scheduler = nullptr;
+  ThreadPool* log_replay_pool = nullptr;
   consensus::RetryableRequests* retryable_requests = nullptr;
   TransactionsEnabled txns_enabled = TransactionsEnabled::kTrue;
   IsSysCatalogTablet is_sys_catalog = IsSysCatalogTablet::kFalse;
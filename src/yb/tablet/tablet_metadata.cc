@@ -525,6 +525,7 @@ Status RaftGroupMetadata::LoadFromSuperBlock(const RaftGroupReplicaSuperBlockPB&
     Partition::FromPB(superblock.partition(), &partition_);
     primary_table_id_ = superblock.primary_table_id();
     colocated_ = superblock.colocated();
+    startup_hints_ = superblock.startup_hints();
 
     RETURN_NOT_OK(kv_store_.LoadFromPB(superblock.kv_store(), primary_table_id_));
 
@@ -618,10 +619,23 @@ void RaftGroupMetadata::ToSuperBlockUnlocked(RaftGroupReplicaSuperBlockPB* super
 
   pb.set_primary_table_id(primary_table_id_);
   pb.set_colocated(colocated_);
+  if (startup_hints_.ByteSize() != 0) {
+    *pb.mutable_startup_hints() = startup_hints_;
+  }
 
   superblock->Swap(&pb);
 }
 
+TabletStartupHintsPB RaftGroupMetadata::startup_hints() const {
+  std::lock_guard<MutexType> lock(data_mutex_);
+  return startup_hints_;
+}
+
+void RaftGroupMetadata::set_startup_hints(const TabletStartupHintsPB& hints) {
+  std::lock_guard<MutexType> lock(data_mutex_);
+  startup_hints_ = hints;
+}
+
 void RaftGroupMetadata::SetSchema(const Schema& schema,
                                   const IndexMap& index_map,
                                   const std::vector<DeletedColumn>& deleted_cols,
@@ -388,6 +388,11 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
 
   bool colocated() const { return colocated_; }
 
+  // Hints stored on tablet server shutdown, see TabletStartupHintsPB. Caller should flush
+  // metadata to persist updated hints.
+  TabletStartupHintsPB startup_hints() const;
+  void set_startup_hints(const TabletStartupHintsPB& hints);
+
  private:
   typedef simple_spinlock MutexType;
 
@@ -492,6 +497,8 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
   // True if the raft group is for a colocated tablet.
   bool colocated_;
 
+  TabletStartupHintsPB startup_hints_;
+
   DISALLOW_COPY_AND_ASSIGN(RaftGroupMetadata);
 };
 
@@ -28,6 +28,7 @@ class Env;
 
 namespace yb {
 class Env;
+class ThreadPool;
 namespace tablet {
 
 YB_STRONGLY_TYPED_BOOL(IsDropTable);
@@ -36,6 +37,8 @@ struct TabletOptions {
   std::shared_ptr<rocksdb::Cache> block_cache;
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor;
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
+  // Thread pool for asynchronous readahead of SST data blocks, null to disable it.
+  yb::ThreadPool* readahead_thread_pool = nullptr;
   yb::Env* env = Env::Default();
   rocksdb::Env* rocksdb_env = rocksdb::Env::Default();
 };
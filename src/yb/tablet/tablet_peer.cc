@@ -340,6 +340,10 @@ Status TabletPeer::Start(const ConsensusBootstrapInfo& bootstrap_info) {
     metric_registry_->tablets_shutdown_erase(tablet_id());
 
     RETURN_NOT_OK(consensus_->Start(bootstrap_info));
+    start_time_ = CoarseMonoClock::Now();
+    if (tablet_->metrics()) {
+      rows_inserted_at_start_ = tablet_->metrics()->rows_inserted->value();
+    }
     RETURN_NOT_OK(UpdateState(RaftGroupStatePB::BOOTSTRAPPING, RaftGroupStatePB::RUNNING,
                               "Incorrect state to start TabletPeer, "));
   }
@@ -359,6 +363,60 @@ const consensus::RaftConfigPB TabletPeer::RaftConfig() const {
   return consensus_->CommittedConfig();
 }
 
+namespace {
+
+// Bootstrap replays WAL starting from the segment that contains the first entry that was not
+// flushed to RocksDB, so the closed segments with all entries flushed are skipped.
+Result<uint64_t> WalBytesToReplay(const Tablet& tablet, const log::Log& log) {
+  const auto flushed_op_ids = VERIFY_RESULT(tablet.MaxPersistentOpId());
+  auto flushed_index = flushed_op_ids.regular.index;
+  if (tablet.doc_db().intents) {
+    flushed_index = std::min(flushed_index, flushed_op_ids.intents.index);
+  }
+
+  log::SegmentSequence segments;
+  RETURN_NOT_OK(log.GetSegmentsSnapshot(&segments));
+  uint64_t result = 0;
+  for (const auto& segment : segments) {
+    if (segment->HasFooter() && segment->footer().max_replicate_index() <= flushed_index) {
+      continue;
+    }
+    result += segment->readable_up_to();
+  }
+  return result;
+}
+
+} // namespace
+
+Status TabletPeer::StoreStartupHints() {
+  auto tablet = shared_tablet();
+  auto consensus = shared_consensus();
+  const auto current_state = state();
+  if (current_state != RaftGroupStatePB::RUNNING || !tablet || !consensus) {
+    return STATUS_FORMAT(
+        IllegalState, "Tablet peer is not running: $0", RaftGroupStatePB_Name(current_state));
+  }
+
+  TabletStartupHintsPB hints;
+  hints.set_was_leader(consensus->role() == consensus::RaftPeerPB::LEADER);
+  const double uptime_sec = ToSeconds(CoarseMonoClock::Now() - start_time_);
+  if (tablet->metrics() && uptime_sec > 0) {
+    const auto rows = tablet->metrics()->rows_inserted->value() - rows_inserted_at_start_;
+    hints.set_write_rows_per_sec(rows / uptime_sec);
+  }
+  if (log_available()) {
+    auto wal_bytes = WalBytesToReplay(*tablet, *log());
+    if (wal_bytes.ok()) {
+      hints.set_wal_bytes_to_replay(*wal_bytes);
+    } else {
+      LOG_WITH_PREFIX(WARNING) << "Failed to calculate WAL bytes to replay: "
+                               << wal_bytes.status();
+    }
+  }
+  meta_->set_startup_hints(hints);
+  return meta_->Flush();
+}
+
 bool TabletPeer::StartShutdown() {
   LOG_WITH_PREFIX(INFO) << "Initiating TabletPeer shutdown";
 
@@ -126,6 +126,10 @@ class TabletPeer : public consensus::ConsensusContext,
   // in the consensus configuration.
   CHECKED_STATUS Start(const consensus::ConsensusBootstrapInfo& info);
 
+  // Stores leadership of this peer and write rate since it was started as startup hints in the
+  // Raft group metadata, so the tablet could be prioritized on the next tablet server startup.
+  CHECKED_STATUS StoreStartupHints();
+
   // Starts shutdown process.
   // Returns true if shutdown was just initiated, false if shutdown was already running.
   MUST_USE_RESULT bool StartShutdown();
@@ -402,6 +406,11 @@ class TabletPeer : public consensus::ConsensusContext,
 
   std::unique_ptr<Preparer> prepare_thread_;
 
+  // Time when the peer was started and number of rows inserted by the bootstrap, used to
+  // calculate write rate for startup hints.
+  CoarseTimePoint start_time_;
+  int64_t rows_inserted_at_start_ = 0;
+
   scoped_refptr<server::Clock> clock_;
 
   scoped_refptr<log::LogAnchorRegistry> log_anchor_registry_;
@@ -279,6 +279,52 @@ void AdjustYsqlOperationTransactionality(
   }
 }
 
+// Only reads could use BOUNDED_STALENESS consistency level.
+template <class Req>
+Status CheckFollowerStaleness(const Req& req, const TabletPeer& tablet_peer, server::Clock* clock) {
+  return Status::OK();
+}
+
+// Checks that follower could serve the read without violating its staleness bound.
+// When the read time is picked by the client, follower should have all data up to it.
+// Otherwise the read is performed at the follower safe time, so it should be not older than now
+// minus max staleness.
+Status CheckFollowerStaleness(
+    const ReadRequestPB& req, const TabletPeer& tablet_peer, server::Clock* clock) {
+  HybridTime required;
+  if (req.has_read_time() && req.read_time().has_read_ht()) {
+    required = HybridTime(req.read_time().read_ht());
+  } else {
+    if (!clock) {
+      return Status::OK();
+    }
+    // Clock is not updated with the propagated time yet, so it is taken into account explicitly.
+    // Thus zero bound guarantees that client sees its own writes.
+    auto now_ht = clock->Now();
+    if (req.has_propagated_hybrid_time()) {
+      now_ht = std::max(now_ht, HybridTime(req.propagated_hybrid_time()));
+    }
+    const MicrosTime now = now_ht.GetPhysicalValueMicros();
+    const MicrosTime staleness = req.max_staleness_ms() * MonoTime::kMicrosecondsPerMillisecond;
+    if (staleness == 0) {
+      required = now_ht;
+    } else {
+      required = HybridTime::FromMicros(now > staleness ? now - staleness : 0);
+    }
+  }
+  auto tablet = tablet_peer.shared_tablet();
+  if (!tablet) {
+    return STATUS(IllegalState, "Tablet is not running");
+  }
+  auto safe_time = tablet->SafeTime(tablet::RequireLease::kFalse);
+  if (safe_time < required) {
+    return STATUS_FORMAT(
+        IllegalState, "Follower safe time $0 is behind required read time $1",
+        safe_time, required);
+  }
+  return Status::OK();
+}
+
 } // namespace
 
 template<class Resp>
@@ -1093,6 +1139,14 @@ bool TabletServiceImpl::DoGetTabletOrRespond(
           return false;
         }
       }
+      if (req->consistency_level() == YBConsistencyLevel::BOUNDED_STALENESS) {
+        s = CheckFollowerStaleness(*req, *tablet_peer, server_ ? server_->Clock() : nullptr);
+        if (PREDICT_FALSE(!s.ok())) {
+          SetupErrorAndRespond(
+              resp->mutable_error(), s, TabletServerErrorPB::STALE_FOLLOWER, context);
+          return false;
+        }
+      }
     } else {
       // We are here because we are the leader.
       if (PREDICT_FALSE(FLAGS_assert_reads_from_follower_rejected_because_of_staleness)) {
@@ -33,6 +33,7 @@
 #include "yb/tserver/ts_tablet_manager.h"
 
 #include <string>
+#include <tuple>
 
 #include <gtest/gtest.h>
 #include <gflags/gflags.h>
@@ -58,6 +59,9 @@
   ASSERT_NO_FATALS(AssertMonotonicReportSeqno(report_seqno, tablet_report))
 
 DECLARE_bool(pretend_memory_exceeded_enforce_flush);
+DECLARE_bool(prioritize_tablets_on_startup);
+
+using namespace std::literals;
 
 namespace yb {
 namespace tserver {
@@ -201,6 +205,75 @@ TEST_F(TsTabletManagerTest, TestProperBackgroundFlushOnStartup) {
   }
 }
 
+TEST_F(TsTabletManagerTest, TestStartupPriority) {
+  FlagSaver flag_saver;
+
+  // Tablets with hints: was leader, write rows per second.
+  const std::vector<std::tuple<TabletId, bool, double>> kTablets = {
+    std::make_tuple("follower-tablet", false, 1000),
+    std::make_tuple("idle-leader-tablet", true, 0),
+    std::make_tuple("busy-leader-tablet", true, 1000),
+  };
+
+  for (const auto& tablet : kTablets) {
+    std::shared_ptr<TabletPeer> peer;
+    ASSERT_OK(CreateNewTablet(std::get<0>(tablet), schema_, &peer));
+    tablet::TabletStartupHintsPB hints;
+    hints.set_was_leader(std::get<1>(tablet));
+    hints.set_write_rows_per_sec(std::get<2>(tablet));
+    peer->tablet_metadata()->set_startup_hints(hints);
+    ASSERT_OK(peer->tablet_metadata()->Flush());
+  }
+
+  // Keep hints stored above during shutdown.
+  FLAGS_prioritize_tablets_on_startup = false;
+  mini_server_->Shutdown();
+  FLAGS_prioritize_tablets_on_startup = true;
+  CreateMiniTabletServer();
+  ASSERT_OK(mini_server_->Start());
+  ASSERT_OK(mini_server_->WaitStarted());
+  tablet_manager_ = mini_server_->server()->tablet_manager();
+
+  TabletStartupProgress progress;
+  ASSERT_OK(WaitFor([this, &progress] {
+    progress = tablet_manager_->GetStartupProgress();
+    return progress.tablets_opened == progress.tablets.size();
+  }, 10s, "Tablets opened"));
+
+  ASSERT_EQ(kTablets.size(), progress.tablets.size());
+  ASSERT_EQ("busy-leader-tablet", progress.tablets[0].tablet_id);
+  ASSERT_EQ("idle-leader-tablet", progress.tablets[1].tablet_id);
+  ASSERT_EQ("follower-tablet", progress.tablets[2].tablet_id);
+  ASSERT_GT(progress.wal_bytes_total, 0U);
+  ASSERT_EQ(progress.wal_bytes_total, progress.wal_bytes_opened);
+
+  // Hints are refreshed on shutdown, all tablets of the single node cluster are leaders.
+  for (const auto& info : progress.tablets) {
+    std::shared_ptr<TabletPeer> peer;
+    ASSERT_TRUE(tablet_manager_->LookupTablet(info.tablet_id, &peer));
+    ASSERT_OK(peer->consensus()->WaitUntilLeaderForTests(10s));
+  }
+  mini_server_->Shutdown();
+  CreateMiniTabletServer();
+  ASSERT_OK(mini_server_->Start());
+  ASSERT_OK(mini_server_->WaitStarted());
+  tablet_manager_ = mini_server_->server()->tablet_manager();
+  for (const auto& info : tablet_manager_->GetStartupProgress().tablets) {
+    ASSERT_TRUE(info.was_leader) << info.tablet_id;
+  }
+
+  // Hints are cleared when the tablet is opened, so they are not used after a crash.
+  ASSERT_OK(WaitFor([this, &progress] {
+    progress = tablet_manager_->GetStartupProgress();
+    return progress.tablets_opened == progress.tablets.size();
+  }, 10s, "Tablets opened"));
+  for (const auto& info : progress.tablets) {
+    std::shared_ptr<TabletPeer> peer;
+    ASSERT_TRUE(tablet_manager_->LookupTablet(info.tablet_id, &peer));
+    ASSERT_EQ(0, peer->tablet_metadata()->startup_hints().ByteSize()) << info.tablet_id;
+  }
+}
+
 static void AssertMonotonicReportSeqno(int64_t* report_seqno,
                                        const TabletReportPB &report) {
   ASSERT_LT(*report_seqno, report.sequence_number());
@@ -33,6 +33,7 @@
 #include "yb/tserver/ts_tablet_manager.h"
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -49,6 +50,8 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_anchor_registry.h"
+#include "yb/consensus/log_sync_scheduler.h"
+#include "yb/consensus/log_util.h"
 #include "yb/consensus/metadata.pb.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/quorum_util.h"
@@ -119,6 +122,25 @@ DEFINE_int32(db_block_cache_num_shard_bits, 4,
              "Number of bits to use for sharding the block cache (defaults to 4 bits)");
 TAG_FLAG(db_block_cache_num_shard_bits, advanced);
 
+DEFINE_int32(log_replay_threads, 0,
+             "Number of threads shared by bootstrapping tablets to read and decode WAL segments "
+             "and to prepare write batches ahead of log replay. 0 means that each tablet "
+             "bootstrap reads and replays its log sequentially.");
+TAG_FLAG(log_replay_threads, advanced);
+
+DEFINE_bool(prioritize_tablets_on_startup, true,
+            "Whether tablets found on startup should be opened in priority order: tablets that "
+            "were leaders first, then tablets with higher write rate, and tablets with less WAL "
+            "to replay first among tablets with the same priority. Leadership and write rate "
+            "are stored in tablet metadata on tablet server shutdown.");
+TAG_FLAG(prioritize_tablets_on_startup, advanced);
+
+DEFINE_bool(db_block_cache_frequency_admission, false,
+            "Whether block cache should track access frequency of blocks and skip caching of a "
+            "block that is accessed less frequently than the block it would evict (TinyLFU). "
+            "Prevents large scans from flushing frequently used blocks.");
+TAG_FLAG(db_block_cache_frequency_admission, advanced);
+
 DEFINE_bool(enable_log_cache_gc, true,
             "Set to true to enable log cache garbage collector.");
 
@@ -194,6 +216,11 @@ DEFINE_int32(read_pool_max_queue_size, 128,
              "is used to run multiple read operations, that are part of the same tablet rpc, "
              "in parallel.");
 
+DEFINE_int32(rocksdb_async_readahead_threads, 4,
+             "Max number of threads that read SST data blocks ahead of forward scans, see "
+             "rocksdb_async_readahead_blocks.");
+TAG_FLAG(rocksdb_async_readahead_threads, advanced);
+
 DEFINE_test_flag(int32, sleep_after_tombstoning_tablet_secs, 0,
                  "Whether we sleep in LogAndTombstone after calling DeleteTabletData.");
 
@@ -203,6 +230,8 @@ DEFINE_int32(tserver_yb_client_default_timeout_ms, kTServerYbClientDefaultTimeou
              "Default timeout for the YBClient embedded into the tablet server that is used "
              "for distributed transactions.");
 
+DECLARE_bool(log_group_sync);
+
 namespace yb {
 namespace tserver {
 
@@ -374,6 +403,47 @@ class FunctorGC : public GarbageCollector {
   std::function<void(size_t)> impl_;
 };
 
+// Returns total size of WAL segments located in wal_dir.
+uint64_t WalSizeBytes(Env* env, const std::string& wal_dir) {
+  auto children = env->GetChildren(wal_dir, ExcludeDots::kTrue);
+  if (!children.ok()) {
+    return 0;
+  }
+  uint64_t result = 0;
+  for (const auto& child : *children) {
+    if (!log::IsLogFileName(child)) {
+      continue;
+    }
+    auto size = env->GetFileSize(JoinPathSegments(wal_dir, child));
+    if (size.ok()) {
+      result += *size;
+    }
+  }
+  return result;
+}
+
+// Write rates that differ less than twice are considered equal, so tablets with less WAL to
+// replay could be opened first.
+int WriteRateBucket(double write_rows_per_sec) {
+  return write_rows_per_sec < 1 ? 0 : 1 + std::ilogb(write_rows_per_sec);
+}
+
+// Leaders are opened first, so their Raft groups do not wait for leader election to become
+// available, then tablets with higher write rate. Tablets with less WAL to replay go first
+// among tablets with the same priority, so more tablets become available sooner.
+bool OpensBefore(const TabletStartupProgress::TabletInfo& lhs,
+                 const TabletStartupProgress::TabletInfo& rhs) {
+  if (lhs.was_leader != rhs.was_leader) {
+    return lhs.was_leader;
+  }
+  const auto lhs_rate = WriteRateBucket(lhs.write_rows_per_sec);
+  const auto rhs_rate = WriteRateBucket(rhs.write_rows_per_sec);
+  if (lhs_rate != rhs_rate) {
+    return lhs_rate > rhs_rate;
+  }
+  return lhs.wal_bytes < rhs.wal_bytes;
+}
+
 } // namespace
 
 TSTabletManager::TSTabletManager(FsManager* fs_manager,
@@ -421,6 +491,10 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
                .set_max_queue_size(FLAGS_read_pool_max_queue_size)
                .set_metrics(std::move(read_metrics))
                .Build(&read_pool_));
+  CHECK_OK(ThreadPoolBuilder("sst-readahead")
+               .set_max_threads(FLAGS_rocksdb_async_readahead_threads)
+               .Build(&readahead_pool_));
+  tablet_options_.readahead_thread_pool = readahead_pool_.get();
 
   int64_t block_cache_size_bytes = FLAGS_db_block_cache_size_bytes;
   int64_t total_ram_avail = MemTracker::GetRootTracker()->limit();
@@ -440,8 +514,11 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
       block_cache_size_bytes, "BlockBasedTable", server_->mem_tracker());
 
   if (FLAGS_db_block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
-    tablet_options_.block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
-                                                       FLAGS_db_block_cache_num_shard_bits);
+    tablet_options_.block_cache = rocksdb::NewLRUCache(
+        block_cache_size_bytes, FLAGS_db_block_cache_num_shard_bits,
+        false /* strict_capacity_limit */,
+        FLAGS_db_block_cache_frequency_admission ? rocksdb::CacheAdmissionPolicy::kFrequencySketch
+                                                 : rocksdb::CacheAdmissionPolicy::kAdmitAll);
     tablet_options_.block_cache->SetMetrics(server_->metric_entity());
     block_based_table_gc_ = std::make_shared<LRUCacheGC>(tablet_options_.block_cache);
     block_based_table_mem_tracker_->AddGarbageCollector(block_based_table_gc_);
@@ -519,6 +596,21 @@ Status TSTabletManager::Init() {
                 .set_metrics(std::move(metrics))
                 .Build(&open_tablet_pool_));
 
+  if (FLAGS_log_replay_threads > 0) {
+    RETURN_NOT_OK(ThreadPoolBuilder("log-replay")
+                  .set_max_threads(FLAGS_log_replay_threads)
+                  .Build(&log_replay_pool_));
+  }
+
+  if (FLAGS_log_group_sync) {
+    for (const auto& wal_root_dir : fs_manager_->GetWalRootDirs()) {
+      std::unique_ptr<log::LogSyncScheduler> scheduler(
+          new log::LogSyncScheduler(wal_root_dir, server_->metric_entity()));
+      RETURN_NOT_OK(scheduler->Start());
+      log_sync_schedulers_.emplace(wal_root_dir, std::move(scheduler));
+    }
+  }
+
   CleanupCheckpoints();
 
   // Search for tablets in the metadata dir.
@@ -551,6 +643,8 @@ Status TSTabletManager::Init() {
     metas.push_back(meta);
   }
 
+  PrioritizeTabletsForOpen(&metas);
+
   // Now submit the "Open" task for each.
   for (const RaftGroupMetadataPtr& meta : metas) {
     scoped_refptr<TransitionInProgressDeleter> deleter;
@@ -577,6 +671,70 @@ Status TSTabletManager::Init() {
   return Status::OK();
 }
 
+void TSTabletManager::PrioritizeTabletsForOpen(vector<RaftGroupMetadataPtr>* metas) {
+  vector<std::pair<RaftGroupMetadataPtr, TabletStartupProgress::TabletInfo>> entries;
+  entries.reserve(metas->size());
+  for (const auto& meta : *metas) {
+    TabletStartupProgress::TabletInfo info;
+    info.tablet_id = meta->raft_group_id();
+    const auto hints = meta->startup_hints();
+    // Without hints, e.g. after a crash, all WAL segments of the tablet are counted.
+    info.wal_bytes = hints.has_wal_bytes_to_replay()
+        ? hints.wal_bytes_to_replay() : WalSizeBytes(fs_manager_->env(), meta->wal_dir());
+    info.was_leader = hints.was_leader();
+    info.write_rows_per_sec = hints.write_rows_per_sec();
+    entries.emplace_back(meta, std::move(info));
+  }
+
+  if (FLAGS_prioritize_tablets_on_startup) {
+    std::stable_sort(entries.begin(), entries.end(), [](const auto& lhs, const auto& rhs) {
+      return OpensBefore(lhs.second, rhs.second);
+    });
+  }
+
+  metas->clear();
+  std::lock_guard<std::mutex> lock(startup_progress_mutex_);
+  startup_progress_.start_time = CoarseMonoClock::Now();
+  for (auto& entry : entries) {
+    metas->push_back(entry.first);
+    startup_tablet_index_.emplace(entry.second.tablet_id, startup_progress_.tablets.size());
+    startup_progress_.wal_bytes_total += entry.second.wal_bytes;
+    startup_progress_.tablets.push_back(std::move(entry.second));
+  }
+  if (startup_progress_.tablets.empty()) {
+    startup_progress_.finish_time = startup_progress_.start_time;
+  }
+  LOG_WITH_PREFIX(INFO) << "Opening " << startup_progress_.tablets.size() << " tablets with "
+                        << HumanReadableNumBytes::ToString(startup_progress_.wal_bytes_total)
+                        << " of WAL";
+}
+
+void TSTabletManager::TabletOpenFinished(const TabletId& tablet_id) {
+  std::lock_guard<std::mutex> lock(startup_progress_mutex_);
+  auto it = startup_tablet_index_.find(tablet_id);
+  if (it == startup_tablet_index_.end()) {
+    return;
+  }
+  auto& info = startup_progress_.tablets[it->second];
+  if (info.opened) {
+    return;
+  }
+  info.opened = true;
+  ++startup_progress_.tablets_opened;
+  startup_progress_.wal_bytes_opened += info.wal_bytes;
+  if (startup_progress_.tablets_opened == startup_progress_.tablets.size()) {
+    startup_progress_.finish_time = CoarseMonoClock::Now();
+    LOG_WITH_PREFIX(INFO)
+        << "Opened " << startup_progress_.tablets_opened << " tablets in "
+        << MonoDelta(startup_progress_.finish_time - startup_progress_.start_time);
+  }
+}
+
+TabletStartupProgress TSTabletManager::GetStartupProgress() const {
+  std::lock_guard<std::mutex> lock(startup_progress_mutex_);
+  return startup_progress_;
+}
+
 void TSTabletManager::CleanupCheckpoints() {
   for (const auto& data_root : fs_manager_->GetDataRootDirs()) {
     auto tables_dir = JoinPathSegments(data_root, FsManager::kRocksDBDirName);
@@ -613,6 +771,12 @@ Status TSTabletManager::Start() {
   return Status::OK();
 }
 
+log::LogSyncScheduler* TSTabletManager::log_sync_scheduler(
+    const std::string& wal_root_dir) const {
+  auto it = log_sync_schedulers_.find(wal_root_dir);
+  return it != log_sync_schedulers_.end() ? it->second.get() : nullptr;
+}
+
 Status TSTabletManager::WaitForAllBootstrapsToFinish() {
   CHECK_EQ(state(), MANAGER_RUNNING);
 
@@ -1093,6 +1257,16 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
   shared_ptr<TabletClass> tablet;
   scoped_refptr<Log> log;
   const string kLogPrefix = TabletLogPrefix(tablet_id);
+  auto se = ScopeExit([this, &tablet_id] {
+    TabletOpenFinished(tablet_id);
+  });
+
+  // Hints describe the tablet at the last clean shutdown, so they are cleared before bootstrap
+  // changes the tablet. Otherwise they would be used again after a crash.
+  if (meta->startup_hints().ByteSize() != 0) {
+    meta->set_startup_hints(tablet::TabletStartupHintsPB());
+    WARN_NOT_OK(meta->Flush(), kLogPrefix + "Failed to clear startup hints");
+  }
 
   LOG(INFO) << kLogPrefix << "Bootstrapping tablet";
   TRACE("Bootstrapping tablet");
@@ -1124,6 +1298,8 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
         .local_tablet_filter = std::bind(&TSTabletManager::PreserveLocalLeadersOnly, this, _1),
         .transaction_coordinator_context = tablet_peer.get(),
         .append_pool = append_pool(),
+        .log_sync_scheduler = log_sync_scheduler(meta->wal_root_dir()),
+        .log_replay_pool = log_replay_pool(),
         .retryable_requests = &retryable_requests,
         .txns_enabled = tablet::TransactionsEnabled::kTrue,
         // We are assuming we're never dealing with the system catalog tablet in TSTabletManager.
@@ -1216,13 +1392,45 @@ void TSTabletManager::StartShutdown() {
   // Take a snapshot of the peers list -- that way we don't have to hold
   // on to the lock while shutting them down, which might cause a lock
   // inversion. (see KUDU-308 for example).
-  for (const TabletPeerPtr& peer : GetTabletPeers()) {
+  auto peers = GetTabletPeers();
+  if (FLAGS_prioritize_tablets_on_startup) {
+    StoreStartupHints(peers);
+  }
+  for (const TabletPeerPtr& peer : peers) {
     if (peer->StartShutdown()) {
       shutting_down_peers_.push_back(peer);
     }
   }
 }
 
+void TSTabletManager::StoreStartupHints(const TabletPeers& peers) {
+  // Each tablet flushes its own metadata file, so hints of different tablets are stored in
+  // parallel.
+  std::unique_ptr<ThreadPool> pool;
+  auto status = ThreadPoolBuilder("startup-hints")
+      .set_max_threads(base::NumCPUs())
+      .Build(&pool);
+  if (!status.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Failed to create startup hints pool: " << status;
+  }
+  for (const TabletPeerPtr& peer : peers) {
+    if (peer->state() != RaftGroupStatePB::RUNNING) {
+      continue;
+    }
+    auto store = [this, peer] {
+      WARN_NOT_OK(peer->StoreStartupHints(),
+                  Format("$0Failed to store startup hints", TabletLogPrefix(peer->tablet_id())));
+    };
+    if (!pool || !pool->SubmitFunc(store).ok()) {
+      store();
+    }
+  }
+  if (pool) {
+    pool->Wait();
+    pool->Shutdown();
+  }
+}
+
 void TSTabletManager::CompleteShutdown() {
   for (const TabletPeerPtr& peer : shutting_down_peers_) {
     peer->CompleteShutdown();
@@ -1240,6 +1448,14 @@ void TSTabletManager::CompleteShutdown() {
   if (append_pool_) {
     append_pool_->Shutdown();
   }
+  if (log_replay_pool_) {
+    log_replay_pool_->Shutdown();
+  }
+  // Tablets wait for their readahead reads when they are closed.
+  readahead_pool_->Shutdown();
+  for (const auto& dir_and_scheduler : log_sync_schedulers_) {
+    dir_and_scheduler.second->Shutdown();
+  }
 
   {
     std::lock_guard<RWMutex> l(lock_);
@@ -32,7 +32,9 @@
 #ifndef YB_TSERVER_TS_TABLET_MANAGER_H
 #define YB_TSERVER_TS_TABLET_MANAGER_H
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -58,6 +60,7 @@
 #include "yb/tserver/tserver_admin.pb.h"
 #include "yb/util/locks.h"
 #include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
 #include "yb/util/rw_mutex.h"
 #include "yb/util/status.h"
 #include "yb/util/threadpool.h"
@@ -78,6 +81,10 @@ namespace consensus {
 class RaftConfigPB;
 } // namespace consensus
 
+namespace log {
+class LogSyncScheduler;
+}
+
 namespace master {
 class ReportedTabletPB;
 class TabletReportPB;
@@ -109,6 +116,27 @@ class TransitionInProgressDeleter;
     } \
   } while (0)
 
+// Progress of opening tablets that were found on disk during tablet server startup.
+struct TabletStartupProgress {
+  struct TabletInfo {
+    TabletId tablet_id;
+    // Size of WAL segments that should be replayed to open the tablet.
+    uint64_t wal_bytes = 0;
+    bool was_leader = false;
+    double write_rows_per_sec = 0;
+    bool opened = false;
+  };
+
+  size_t tablets_opened = 0;
+  uint64_t wal_bytes_total = 0;
+  uint64_t wal_bytes_opened = 0;
+  CoarseTimePoint start_time;
+  // Time when the last tablet was opened, not set while startup is in progress.
+  CoarseTimePoint finish_time;
+  // Tablets in the order they are submitted for opening.
+  std::vector<TabletInfo> tablets;
+};
+
 // Keeps track of the tablets hosted on the tablet server side.
 //
 // TODO: will also be responsible for keeping the local metadata about
@@ -147,6 +175,13 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   ThreadPool* raft_pool() const { return raft_pool_.get(); }
   ThreadPool* read_pool() const { return read_pool_.get(); }
   ThreadPool* append_pool() const { return append_pool_.get(); }
+  ThreadPool* log_replay_pool() const { return log_replay_pool_.get(); }
+
+  TabletStartupProgress GetStartupProgress() const;
+
+  // Returns group sync scheduler for logs located in specified WAL root directory, nullptr if
+  // group sync is disabled.
+  log::LogSyncScheduler* log_sync_scheduler(const std::string& wal_root_dir) const;
 
   // Create a new tablet and register it with the tablet manager. The new tablet
   // is persisted on disk and opened before this method returns.
@@ -352,6 +387,17 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   void OpenTablet(const scoped_refptr<tablet::RaftGroupMetadata>& meta,
                   const scoped_refptr<TransitionInProgressDeleter>& deleter);
 
+  // Orders tablets found on startup, so tablets that were leaders and had high write rate are
+  // opened first, and tablets with less WAL to replay are opened before others with the same
+  // priority.
+  void PrioritizeTabletsForOpen(std::vector<scoped_refptr<tablet::RaftGroupMetadata>>* metas);
+
+  // Updates startup progress when opening of the tablet is finished.
+  void TabletOpenFinished(const TabletId& tablet_id);
+
+  // Stores startup hints of running tablets, used to order tablets on the next startup.
+  void StoreStartupHints(const TabletPeers& peers);
+
   // Open a tablet whose metadata has already been loaded.
   void BootstrapAndInitTablet(const scoped_refptr<tablet::RaftGroupMetadata>& meta,
                               std::shared_ptr<tablet::TabletPeer>* peer);
@@ -475,9 +521,19 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
   // Thread pool for appender threads, shared between all tablets.
   std::unique_ptr<ThreadPool> append_pool_;
 
+  // Thread pool that reads WAL segments and prepares write batches ahead of log replay during
+  // tablet bootstrap, shared between all tablets. Null when log_replay_threads is 0.
+  std::unique_ptr<ThreadPool> log_replay_pool_;
+
+  // Group sync schedulers of WAL root directories, used when log_group_sync is enabled.
+  std::map<std::string, std::unique_ptr<log::LogSyncScheduler>> log_sync_schedulers_;
+
   // Thread pool for read ops, that are run in parallel, shared between all tablets.
   std::unique_ptr<ThreadPool> read_pool_;
 
+  // Thread pool that reads SST data blocks ahead of forward scans, shared between all tablets.
+  std::unique_ptr<ThreadPool> readahead_pool_;
+
   // Used for scheduling flushes
   std::unique_ptr<BackgroundTask> background_task_;
 
@@ -488,6 +544,11 @@ class TSTabletManager : public tserver::TabletPeerLookupIf {
 
   TabletPeers shutting_down_peers_;
 
+  mutable std::mutex startup_progress_mutex_;
+  TabletStartupProgress startup_progress_;
+  // Index of tablet in startup_progress_.tablets by tablet id.
+  std::unordered_map<TabletId, size_t> startup_tablet_index_;
+
   std::shared_ptr<GarbageCollector> block_based_table_gc_;
   std::shared_ptr<GarbageCollector> log_cache_gc_;
 
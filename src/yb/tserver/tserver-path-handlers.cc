@@ -42,11 +42,13 @@
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/quorum_util.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/join.h"
 #include "yb/gutil/strings/numbers.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/rocksdb/rate_limiter.h"
 #include "yb/server/webui_util.h"
 #include "yb/tablet/maintenance_manager.h"
 #include "yb/tablet/tablet.h"
@@ -56,6 +58,7 @@
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
+#include "yb/util/priority_thread_pool.h"
 #include "yb/util/url-coding.h"
 
 namespace {
@@ -182,6 +185,14 @@ Status TabletServerPathHandlers::Register(Webserver* server) {
       "/maintenance-manager", "",
       std::bind(&TabletServerPathHandlers::HandleMaintenanceManagerPage, this, _1, _2),
       true /* styled */, false /* is_on_nav_bar */);
+  server->RegisterPathHandler(
+      "/startup", "",
+      std::bind(&TabletServerPathHandlers::HandleStartupPage, this, _1, _2),
+      true /* styled */, false /* is_on_nav_bar */);
+  server->RegisterPathHandler(
+      "/compactions", "",
+      std::bind(&TabletServerPathHandlers::HandleCompactionsPage, this, _1, _2),
+      true /* styled */, false /* is_on_nav_bar */);
 
   return Status::OK();
 }
@@ -582,6 +593,11 @@ void TabletServerPathHandlers::HandleDashboardsPage(const Webserver::WebRequest&
   *output << GetDashboardLine("maintenance-manager", "Maintenance Manager",
                               "List of operations that are currently running and those "
                               "that are registered.");
+  *output << GetDashboardLine("startup", "Startup Progress",
+                              "Progress of opening tablets on tablet server startup.");
+  *output << GetDashboardLine("compactions", "Compactions",
+                              "Queue of compactions and flushes of all tablets, and tablets with "
+                              "the highest read amplification.");
 }
 
 string TabletServerPathHandlers::GetDashboardLine(const std::string& link,
@@ -651,5 +667,129 @@ void TabletServerPathHandlers::HandleMaintenanceManagerPage(const Webserver::Web
   *output << "</table>\n";
 }
 
+void TabletServerPathHandlers::HandleStartupPage(const Webserver::WebRequest& req,
+                                                 std::stringstream* output) {
+  auto progress = tserver_->tablet_manager()->GetStartupProgress();
+  const bool finished = progress.tablets_opened == progress.tablets.size();
+  const auto end_time = finished ? progress.finish_time : CoarseMonoClock::Now();
+
+  *output << "<h1>Startup Progress</h1>\n";
+  *output << "<table class='table table-striped'>\n";
+  *output << Substitute("  <tr><td>Tablets opened</td><td>$0 of $1</td></tr>\n",
+                        progress.tablets_opened, progress.tablets.size());
+  *output << Substitute("  <tr><td>WAL replayed</td><td>$0 of $1</td></tr>\n",
+                        HumanReadableNumBytes::ToString(progress.wal_bytes_opened),
+                        HumanReadableNumBytes::ToString(progress.wal_bytes_total));
+  *output << Substitute("  <tr><td>$0</td><td>$1</td></tr>\n",
+                        finished ? "Startup time" : "Time since startup",
+                        HumanReadableElapsedTime::ToShortString(
+                            ToSeconds(end_time - progress.start_time)));
+  *output << "</table>\n";
+
+  if (finished) {
+    return;
+  }
+
+  *output << "<h3>Tablets waiting to be opened</h3>\n";
+  *output << "<table class='table table-striped'>\n";
+  *output << "  <tr><th>Tablet ID</th><th>WAL size</th><th>Was leader</th>"
+          << "<th>Write rate (rows/sec)</th><th>Status</th></tr>\n";
+  for (const auto& info : progress.tablets) {
+    if (info.opened) {
+      continue;
+    }
+    string status;
+    std::shared_ptr<TabletPeer> peer;
+    if (tserver_->tablet_manager()->LookupTablet(info.tablet_id, &peer)) {
+      status = peer->status_listener()->last_status();
+    }
+    *output << Substitute(
+        "  <tr><td>$0</td><td>$1</td><td>$2</td><td>$3</td><td>$4</td></tr>\n",
+        TabletLink(info.tablet_id),
+        HumanReadableNumBytes::ToString(info.wal_bytes),
+        info.was_leader ? "yes" : "no",
+        info.write_rows_per_sec,
+        EscapeForHtmlToString(status));
+  }
+  *output << "</table>\n";
+}
+
+void TabletServerPathHandlers::HandleCompactionsPage(const Webserver::WebRequest& req,
+                                                     std::stringstream* output) {
+  static constexpr size_t kMaxTabletsToShow = 20;
+
+  auto* thread_pool = docdb::GetPriorityThreadPoolForCompactionsAndFlushes();
+  if (ContainsKey(req.parsed_args, "raw")) {
+    if (thread_pool) {
+      *output << thread_pool->StateToString();
+    }
+    return;
+  }
+
+  *output << "<h1>Compactions</h1>\n";
+  *output << "<h3>Compaction and flush queue</h3>\n";
+  *output << "<p>Tasks of all tablets, in order they are picked, followed by running tasks.</p>\n";
+  *output << "<table class='table table-striped'>\n";
+  *output << "  <tr><th>Serial No</th><th>Priority</th><th>State</th><th>Task</th></tr>\n";
+  if (thread_pool) {
+    for (const auto& task : thread_pool->Tasks()) {
+      *output << Substitute("  <tr><td>$0</td><td>$1</td><td>$2</td><td>$3</td></tr>\n",
+                            task.serial_no,
+                            task.priority,
+                            EscapeForHtmlToString(ToString(task.state)),
+                            EscapeForHtmlToString(task.description));
+    }
+  }
+  *output << "</table>\n";
+
+  // Only present when rocksdb_compact_flush_rate_limit_per_data_dir is set.
+  *output << "<h3>Rate limited writes per data directory</h3>\n";
+  *output << "<table class='table table-striped'>\n";
+  *output << "  <tr><th>Data directory</th><th>Written by flushes and compactions</th></tr>\n";
+  for (const auto& entry : docdb::GetDataDirRateLimiters()) {
+    *output << Substitute("  <tr><td>$0</td><td>$1</td></tr>\n",
+                          EscapeForHtmlToString(entry.first),
+                          HumanReadableNumBytes::ToString(entry.second->GetTotalBytesThrough()));
+  }
+  *output << "</table>\n";
+
+  struct TabletSSTFiles {
+    std::string tablet_id;
+    uint64_t num_sst_files;
+    uint64_t sst_files_size;
+  };
+  std::vector<TabletSSTFiles> tablets;
+  vector<std::shared_ptr<TabletPeer>> peers;
+  tserver_->tablet_manager()->GetTabletPeers(&peers);
+  for (const auto& peer : peers) {
+    auto tablet = peer->shared_tablet();
+    if (!tablet) {
+      continue;
+    }
+    tablets.push_back(TabletSSTFiles {
+      .tablet_id = peer->tablet_id(),
+      .num_sst_files = tablet->GetCurrentVersionNumSSTFiles(),
+      .sst_files_size = tablet->GetCurrentVersionSstFilesSize(),
+    });
+  }
+  std::sort(tablets.begin(), tablets.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.num_sst_files > rhs.num_sst_files;
+  });
+  if (tablets.size() > kMaxTabletsToShow) {
+    tablets.resize(kMaxTabletsToShow);
+  }
+
+  *output << "<h3>Tablets with the most SST files</h3>\n";
+  *output << "<table class='table table-striped'>\n";
+  *output << "  <tr><th>Tablet ID</th><th>SST files</th><th>SST files size</th></tr>\n";
+  for (const auto& tablet : tablets) {
+    *output << Substitute("  <tr><td>$0</td><td>$1</td><td>$2</td></tr>\n",
+                          TabletLink(tablet.tablet_id),
+                          tablet.num_sst_files,
+                          HumanReadableNumBytes::ToString(tablet.sst_files_size));
+  }
+  *output << "</table>\n";
+}
+
 }  // namespace tserver
 }  // namespace yb
@@ -290,4 +290,41 @@ TEST(PriorityThreadPoolTest, ChangePriority) {
   ASSERT_EQ(running, std::vector<int>({2, 5, 6}));
 }
 
+TEST(PriorityThreadPoolTest, Tasks) {
+  const int kMaxRunningTasks = 2;
+  PriorityThreadPool thread_pool(kMaxRunningTasks);
+  Share share;
+  std::vector<int> running;
+
+  auto se = ScopeExit([&share, &thread_pool] {
+    thread_pool.StartShutdown();
+    share.StopAll();
+    thread_pool.CompleteShutdown();
+  });
+
+  SubmitTask(1, &share, &thread_pool);
+  SubmitTask(2, &share, &thread_pool);
+  auto task3 = SubmitTask(3, &share, &thread_pool);
+  SubmitTask(4, &share, &thread_pool);
+
+  share.FillRunningTaskPriorities(&running);
+  ASSERT_EQ(running, std::vector<int>({3, 4}));
+
+  // Tasks 1 and 2 were started and then paused in favor of tasks with higher priority.
+  // Not running tasks go first, in order they would be picked, then running tasks.
+  auto tasks = thread_pool.Tasks();
+  std::vector<int> priorities;
+  std::vector<PriorityThreadPoolTaskState> states;
+  for (const auto& task : tasks) {
+    priorities.push_back(task.priority);
+    states.push_back(task.state);
+  }
+  ASSERT_EQ(priorities, std::vector<int>({2, 1, 4, 3}));
+  ASSERT_EQ(states, std::vector<PriorityThreadPoolTaskState>({
+      PriorityThreadPoolTaskState::kPaused, PriorityThreadPoolTaskState::kPaused,
+      PriorityThreadPoolTaskState::kRunning, PriorityThreadPoolTaskState::kRunning}));
+  ASSERT_EQ(tasks[3].serial_no, task3);
+  ASSERT_EQ(tasks[3].description, "{ index: 3 }");
+}
+
 } // namespace yb
@@ -50,8 +50,6 @@ static constexpr int kEmptyQueuePriority = -1;
 
 YB_STRONGLY_TYPED_BOOL(PickTask);
 
-YB_DEFINE_ENUM(PriorityThreadPoolTaskState, (kPaused)(kNotStarted)(kRunning));
-
 class PriorityThreadPoolInternalTask {
  public:
   PriorityThreadPoolInternalTask(int priority, TaskPtr task, PriorityThreadPoolWorker* worker)
@@ -108,7 +106,6 @@ class PriorityThreadPoolInternalTask {
                   TaskToString(), worker_, state(), priority(), serial_no_);
   }
 
- private:
   const std::string& TaskToString() const {
     if (!task_to_string_ready_.load(std::memory_order_acquire)) {
       std::lock_guard<simple_spinlock> lock(task_to_string_mutex_);
@@ -120,6 +117,7 @@ class PriorityThreadPoolInternalTask {
     return task_to_string_;
   }
 
+ private:
   std::atomic<int> priority_;
   const size_t serial_no_;
   std::atomic<PriorityThreadPoolTaskState> state_{PriorityThreadPoolTaskState::kNotStarted};
@@ -505,6 +503,18 @@ class PriorityThreadPool::Impl : public PriorityThreadPoolWorkerContext {
     return DoStateToString();
   }
 
+  std::vector<PriorityThreadPoolTaskInfo> Tasks() {
+    std::vector<PriorityThreadPoolTaskInfo> result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    result.reserve(tasks_.size());
+    for (const auto& task : tasks_.get<StateAndPriorityTag>()) {
+      result.push_back(PriorityThreadPoolTaskInfo {
+        task.serial_no(), task.priority(), task.state(), task.TaskToString()
+      });
+    }
+    return result;
+  }
+
  private:
   std::string DoStateToString() REQUIRES(mutex_) {
     return Format(
@@ -718,6 +728,10 @@ std::string PriorityThreadPool::StateToString() {
   return impl_->StateToString();
 }
 
+std::vector<PriorityThreadPoolTaskInfo> PriorityThreadPool::Tasks() {
+  return impl_->Tasks();
+}
+
 bool PriorityThreadPool::ChangeTaskPriority(size_t serial_no, int priority) {
   return impl_->ChangeTaskPriority(serial_no, priority);
 }
@@ -15,6 +15,8 @@
 #define YB_UTIL_PRIORITY_THREAD_POOL_H
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "yb/util/locks.h"
 #include "yb/util/status.h"
@@ -54,6 +56,16 @@ class PriorityThreadPoolTask {
   const size_t serial_no_;
 };
 
+YB_DEFINE_ENUM(PriorityThreadPoolTaskState, (kPaused)(kNotStarted)(kRunning));
+
+// Snapshot of the task state in the pool, used for diagnostics.
+struct PriorityThreadPoolTaskInfo {
+  size_t serial_no;
+  int priority;
+  PriorityThreadPoolTaskState state;
+  std::string description;
+};
+
 // Tasks submitted to this pool have assigned priority and are picked from queue using it.
 class PriorityThreadPool {
  public:
@@ -99,6 +111,10 @@ class PriorityThreadPool {
   // Dumps state to string, useful for debugging.
   std::string StateToString();
 
+  // Returns tasks that are queued or running in the pool. Tasks that are not running go first, in
+  // order they would be picked, followed by running tasks.
+  std::vector<PriorityThreadPoolTaskInfo> Tasks();
+
  private:
   class Impl;
   std::unique_ptr<Impl> impl_;
@@ -27,8 +27,16 @@
 #include "yb/gutil/endian.h"
 #include "yb/gutil/strings/substitute.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/random_util.h"
 
+DEFINE_int32(cql_consistency_one_max_staleness_ms, 0,
+             "When positive, reads with consistency level ONE could be served by the closest "
+             "replica only if returned data is not older than this number of milliseconds. "
+             "Otherwise ONE maps to consistent prefix reads without staleness bound.");
+TAG_FLAG(cql_consistency_one_max_staleness_ms, advanced);
+TAG_FLAG(cql_consistency_one_max_staleness_ms, runtime);
+
 namespace yb {
 namespace cqlserver {
 
@@ -155,8 +163,15 @@ Status CQLMessage::QueryParameters::ValidateConsistency() {
     }
     case Consistency::ONE: {
       // Here we repurpose cassandra's ONE consistency level to be CONSISTENT_PREFIX for us since
-      // that seems to be the most appropriate.
-      set_yb_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+      // that seems to be the most appropriate. When staleness bound is configured, it is
+      // BOUNDED_STALENESS instead.
+      const auto max_staleness_ms = FLAGS_cql_consistency_one_max_staleness_ms;
+      if (max_staleness_ms > 0) {
+        set_yb_consistency_level(YBConsistencyLevel::BOUNDED_STALENESS);
+        set_max_staleness(MonoDelta::FromMilliseconds(max_staleness_ms));
+      } else {
+        set_yb_consistency_level(YBConsistencyLevel::CONSISTENT_PREFIX);
+      }
       break;
     }
     default:
@@ -26,6 +26,7 @@
 #include "yb/util/crypt.h"
 
 #include "yb/yql/cql/cqlserver/cql_service.h"
+#include "yb/yql/cql/ql/ptree/pt_dml.h"
 
 METRIC_DEFINE_histogram(
     server, handler_latency_yb_cqlserver_CQLServerService_GetProcessor,
@@ -71,6 +72,18 @@ METRIC_DEFINE_counter(server, cql_processors_created,
                       yb::MetricUnit::kUnits,
                       "Number of created CQL Processors.");
 
+METRIC_DEFINE_counter(server, cql_unprepared_stmt_cache_hits,
+                      "Number of unprepared queries executed using cached statements.",
+                      yb::MetricUnit::kRequests,
+                      "Number of unprepared queries executed using cached parsed and analyzed "
+                      "statements.");
+
+METRIC_DEFINE_counter(server, cql_unprepared_stmt_cache_misses,
+                      "Number of unprepared queries parsed and analyzed.",
+                      yb::MetricUnit::kRequests,
+                      "Number of unprepared queries that were not found in the statement cache "
+                      "and had to be parsed and analyzed.");
+
 DECLARE_bool(use_cassandra_authentication);
 
 namespace yb {
@@ -99,6 +112,7 @@ using ql::SetKeyspaceResult;
 using ql::SchemaChangeResult;
 using ql::QLProcessor;
 using ql::ParseTree;
+using ql::TreeNodeOpcode;
 using ql::Statement;
 using ql::StatementBatch;
 using ql::StatementExecutedCallback;
@@ -128,6 +142,10 @@ CQLMetrics::CQLMetrics(const scoped_refptr<yb::MetricEntity>& metric_entity)
       METRIC_yb_cqlserver_CQLServerService_ParsingErrors.Instantiate(metric_entity);
   cql_processors_alive_ = METRIC_cql_processors_alive.Instantiate(metric_entity, 0);
   cql_processors_created_ = METRIC_cql_processors_created.Instantiate(metric_entity);
+  cql_unprepared_stmt_cache_hits_ =
+      METRIC_cql_unprepared_stmt_cache_hits.Instantiate(metric_entity);
+  cql_unprepared_stmt_cache_misses_ =
+      METRIC_cql_unprepared_stmt_cache_misses.Instantiate(metric_entity);
 }
 
 //------------------------------------------------------------------------------------------------
@@ -211,6 +229,7 @@ void CQLProcessor::SendResponse(const CQLResponse& response) {
   request_ = nullptr;
   stmts_.clear();
   parse_trees_.clear();
+  unprepared_stmt_ = nullptr;
   SetCurrentSession(nullptr);
   service_impl_->ReturnProcessor(pos_);
 }
@@ -318,8 +337,43 @@ CQLResponse* CQLProcessor::ProcessRequest(const ExecuteRequest& req) {
 
 CQLResponse* CQLProcessor::ProcessRequest(const QueryRequest& req) {
   VLOG(1) << "QUERY " << req.query();
-  RunAsync(req.query(), req.params(), statement_executed_cb_);
-  return nullptr;
+  const auto& cache = service_impl_->unprepared_stmts_cache();
+  if (cache == nullptr) {
+    RunAsync(req.query(), req.params(), statement_executed_cb_);
+    return nullptr;
+  }
+
+  // Look up the statement parsed and analyzed for a previous query with the same text. The
+  // statement is used only when its table is still the one in the metadata cache, i.e. the table
+  // has not been altered or dropped through this proxy in the meantime.
+  const CQLMessage::QueryId query_id = CQLStatement::GetQueryId(
+      ql_env_.CurrentKeyspace(), req.query());
+  shared_ptr<CQLStatement> stmt = cache->Get(query_id);
+  if (stmt != nullptr && !IsTableUpToDate(*stmt)) {
+    cache->Delete(stmt);
+    stmt = nullptr;
+  }
+
+  if (stmt != nullptr) {
+    IncrementCounter(cql_metrics_->cql_unprepared_stmt_cache_hits_);
+    stmt->clear_reparsed();
+  } else {
+    IncrementCounter(cql_metrics_->cql_unprepared_stmt_cache_misses_);
+    stmt = cache->Allocate(query_id, ql_env_.CurrentKeyspace(), req.query());
+    const Status s = stmt->Prepare(this, cache->mem_tracker());
+    if (!s.ok()) {
+      cache->Delete(stmt);
+      return ProcessError(s);
+    }
+    // Only DML statements are cached, the rest are executed once and deleted.
+    if (!IsDmlStatement(*stmt)) {
+      cache->Delete(stmt);
+    }
+  }
+
+  unprepared_stmt_ = stmt;
+  const Status s = stmt->ExecuteAsync(this, req.params(), statement_executed_cb_);
+  return s.ok() ? nullptr : ProcessError(s);
 }
 
 CQLResponse* CQLProcessor::ProcessRequest(const BatchRequest& req) {
@@ -392,6 +446,35 @@ shared_ptr<const CQLStatement> CQLProcessor::GetPreparedStatement(const CQLMessa
   return stmt;
 }
 
+bool CQLProcessor::IsDmlStatement(const CQLStatement& stmt) {
+  const Result<const ParseTree&> parse_tree = stmt.GetParseTree();
+  if (!parse_tree || parse_tree->root() == nullptr) {
+    return false;
+  }
+  switch (parse_tree->root()->opcode()) {
+    case TreeNodeOpcode::kPTSelectStmt: FALLTHROUGH_INTENDED;
+    case TreeNodeOpcode::kPTInsertStmt: FALLTHROUGH_INTENDED;
+    case TreeNodeOpcode::kPTUpdateStmt: FALLTHROUGH_INTENDED;
+    case TreeNodeOpcode::kPTDeleteStmt:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool CQLProcessor::IsTableUpToDate(const CQLStatement& stmt) {
+  if (!IsDmlStatement(stmt)) {
+    return false;
+  }
+  const auto& table = static_cast<const ql::PTDmlStmt&>(
+      *CHECK_RESULT(stmt.GetParseTree()).root()).table();
+  if (table == nullptr) {
+    return true;
+  }
+  bool cache_used = false;
+  return ql_env_.GetTableDesc(table->id(), &cache_used) == table && cache_used;
+}
+
 void CQLProcessor::StatementExecuted(const Status& s, const ExecutedResult::SharedPtr& result) {
   unique_ptr<CQLResponse> response(s.ok() ? ProcessResult(result) : ProcessError(s));
   PrepareAndSendResponse(response);
@@ -414,6 +497,11 @@ CQLResponse* CQLProcessor::ProcessError(const Status& s,
           query_id = stmt->query_id();
         }
       }
+      // The statement of an unprepared query is deleted from its cache and the query is retried
+      // below like any other query.
+      if (unprepared_stmt_ != nullptr && unprepared_stmt_->stale()) {
+        service_impl_->unprepared_stmts_cache()->Delete(unprepared_stmt_);
+      }
       if (query_id) {
         return new UnpreparedErrorResponse(*request_, *query_id);
       }
@@ -424,6 +512,7 @@ CQLResponse* CQLProcessor::ProcessError(const Status& s,
       if (++retry_count_ == 1) {
         stmts_.clear();
         parse_trees_.clear();
+        unprepared_stmt_ = nullptr;
         Reschedule(&process_request_task_.Bind(this));
         return nullptr;
       }
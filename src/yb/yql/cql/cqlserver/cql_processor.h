@@ -50,6 +50,9 @@ class CQLMetrics : public ql::QLMetrics {
 
   scoped_refptr<AtomicGauge<int64_t>> cql_processors_alive_;
   scoped_refptr<Counter> cql_processors_created_;
+
+  scoped_refptr<Counter> cql_unprepared_stmt_cache_hits_;
+  scoped_refptr<Counter> cql_unprepared_stmt_cache_misses_;
 };
 
 
@@ -88,6 +91,12 @@ class CQLProcessor : public ql::QLProcessor {
   // Get a prepared statement and adds it to the set of statements currently being executed.
   std::shared_ptr<const CQLStatement> GetPreparedStatement(const CQLMessage::QueryId& id);
 
+  // Whether the statement is a DML, i.e. could be cached for unprepared queries.
+  static bool IsDmlStatement(const CQLStatement& stmt);
+
+  // Whether the table of a cached DML statement is the current one in the metadata cache.
+  bool IsTableUpToDate(const CQLStatement& stmt);
+
   // Statement executed callback.
   void StatementExecuted(const Status& s, const ql::ExecutedResult::SharedPtr& result = nullptr);
 
@@ -116,6 +125,8 @@ class CQLProcessor : public ql::QLProcessor {
   std::shared_ptr<const CQLRequest> request_;
   std::unordered_set<std::shared_ptr<const CQLStatement>> stmts_;
   std::unordered_set<ql::ParseTree::UniPtr> parse_trees_;
+  // Statement of the unprepared query being executed, if the statement cache is enabled.
+  std::shared_ptr<const CQLStatement> unprepared_stmt_;
 
   // Current retry count.
   int retry_count_ = 0;
@@ -40,6 +40,10 @@ DECLARE_bool(use_cassandra_authentication);
 DEFINE_int64(cql_service_max_prepared_statement_size_bytes, 128_MB,
              "The maximum amount of memory the CQL proxy should use to maintain prepared "
              "statements. 0 or negative means unlimited.");
+DEFINE_int64(cql_service_max_unprepared_statement_cache_size_bytes, 32_MB,
+             "The maximum amount of memory the CQL proxy should use to cache parsed and analyzed "
+             "DML statements of unprepared queries, so the same query text is not parsed and "
+             "analyzed again. 0 or negative means disabled.");
 DEFINE_int32(cql_ybclient_reactor_threads, 24,
              "The number of reactor threads to be used for processing ybclient "
              "requests originating in the cql layer");
@@ -82,6 +86,12 @@ CQLServiceImpl::CQLServiceImpl(CQLServer* server, const CQLServerOptions& opts,
       FLAGS_cql_service_max_prepared_statement_size_bytes : -1,
       "CQL prepared statements", server->mem_tracker());
 
+  if (FLAGS_cql_service_max_unprepared_statement_cache_size_bytes > 0) {
+    unprepared_stmts_cache_ = std::make_shared<CQLStatementCache>(MemTracker::CreateTracker(
+        FLAGS_cql_service_max_unprepared_statement_cache_size_bytes,
+        "CQL unprepared statements", server->mem_tracker()));
+  }
+
   auth_prepared_stmt_ = std::make_shared<ql::Statement>(
       "",
       Substitute("SELECT $0, $1 FROM system_auth.roles WHERE role = ?",
@@ -120,6 +130,9 @@ const std::shared_ptr<client::YBMetaDataCache>& CQLServiceImpl::metadata_cache()
 
 void CQLServiceImpl::CompleteInit() {
   prepared_stmts_mem_tracker_->AddGarbageCollector(shared_from_this());
+  if (unprepared_stmts_cache_) {
+    unprepared_stmts_cache_->CompleteInit();
+  }
 }
 
 void CQLServiceImpl::Shutdown() {
@@ -79,6 +79,11 @@ class CQLServiceImpl : public CQLServerServiceIf,
     return prepared_stmts_mem_tracker_;
   }
 
+  // Return the cache of statements of unprepared queries, nullptr if the cache is disabled.
+  const std::shared_ptr<CQLStatementCache>& unprepared_stmts_cache() const {
+    return unprepared_stmts_cache_;
+  }
+
   // Return the YBClient to communicate with either master or tserver.
   client::YBClient* client() const;
 
@@ -150,6 +155,9 @@ class CQLServiceImpl : public CQLServerServiceIf,
 
   std::shared_ptr<ql::Statement> auth_prepared_stmt_;
 
+  // Cache of statements of unprepared queries.
+  std::shared_ptr<CQLStatementCache> unprepared_stmts_cache_;
+
   // Tracker to measure and limit memory usage of prepared statements.
   MemTrackerPtr prepared_stmts_mem_tracker_;
 
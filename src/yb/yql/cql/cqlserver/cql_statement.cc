@@ -39,5 +39,83 @@ CQLMessage::QueryId CQLStatement::GetQueryId(const string& keyspace, const strin
   return CQLMessage::QueryId(util::to_char_ptr(md5), sizeof(md5));
 }
 
+//------------------------------------------------------------------------------------------------
+CQLStatementCache::CQLStatementCache(MemTrackerPtr mem_tracker)
+    : mem_tracker_(std::move(mem_tracker)) {
+}
+
+CQLStatementCache::~CQLStatementCache() {
+}
+
+void CQLStatementCache::CompleteInit() {
+  mem_tracker_->AddGarbageCollector(shared_from_this());
+}
+
+std::shared_ptr<CQLStatement> CQLStatementCache::Allocate(
+    const CQLMessage::QueryId& query_id, const string& keyspace, const string& query) {
+  std::lock_guard<std::mutex> guard(mutex_);
+
+  std::shared_ptr<CQLStatement> stmt;
+  const auto itr = stmts_map_.find(query_id);
+  if (itr == stmts_map_.end()) {
+    // Allocate the statement placeholder, so concurrent clients running the same new query wait
+    // for a single client to prepare it.
+    stmt = stmts_map_.emplace(
+        query_id, std::make_shared<CQLStatement>(keyspace, query, stmts_list_.end()))
+        .first->second;
+    stmt->set_pos(stmts_list_.insert(stmts_list_.begin(), stmt));
+  } else {
+    stmt = itr->second;
+    stmts_list_.splice(stmts_list_.begin(), stmts_list_, stmt->pos());
+  }
+  return stmt;
+}
+
+std::shared_ptr<CQLStatement> CQLStatementCache::Get(const CQLMessage::QueryId& query_id) {
+  std::lock_guard<std::mutex> guard(mutex_);
+
+  const auto itr = stmts_map_.find(query_id);
+  if (itr == stmts_map_.end()) {
+    return nullptr;
+  }
+
+  std::shared_ptr<CQLStatement> stmt = itr->second;
+  if (stmt->unprepared()) {
+    return nullptr;
+  }
+  if (stmt->stale()) {
+    DeleteUnlocked(stmt);
+    return nullptr;
+  }
+
+  stmts_list_.splice(stmts_list_.begin(), stmts_list_, stmt->pos());
+  return stmt;
+}
+
+void CQLStatementCache::Delete(const std::shared_ptr<const CQLStatement>& stmt) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  DeleteUnlocked(stmt);
+}
+
+void CQLStatementCache::DeleteUnlocked(std::shared_ptr<const CQLStatement> stmt) {
+  // Same as deleting a prepared statement, the statement could have been deleted and allocated
+  // again by another client already, so check that it is the very statement in the cache.
+  const auto itr = stmts_map_.find(stmt->query_id());
+  if (itr != stmts_map_.end() && itr->second == stmt) {
+    stmts_map_.erase(itr);
+  }
+  if (stmt->pos() != stmts_list_.end()) {
+    stmts_list_.erase(stmt->pos());
+    stmt->set_pos(stmts_list_.end());
+  }
+}
+
+void CQLStatementCache::CollectGarbage(size_t required) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (!stmts_list_.empty()) {
+    DeleteUnlocked(stmts_list_.back());
+  }
+}
+
 }  // namespace cqlserver
 }  // namespace yb
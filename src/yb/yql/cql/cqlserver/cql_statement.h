@@ -20,10 +20,13 @@
 #define YB_YQL_CQL_CQLSERVER_CQL_STATEMENT_H_
 
 #include <list>
+#include <mutex>
 
 #include "yb/yql/cql/cqlserver/cql_message.h"
 #include "yb/yql/cql/ql/statement.h"
 
+#include "yb/util/mem_tracker.h"
+
 namespace yb {
 namespace cqlserver {
 
@@ -59,6 +62,55 @@ class CQLStatement : public ql::Statement {
   mutable CQLStatementListPos pos_;
 };
 
+// A cache of statements parsed and analyzed from the text of unprepared queries. Like prepared
+// statements, the statements are keyed by the query id of the keyspace and query text, so clients
+// that send the same query text repeatedly pay for parsing and semantic analysis only once. The
+// least recently used statements are deleted when the memory tracker of the cache hits its limit.
+class CQLStatementCache : public GarbageCollector,
+                          public std::enable_shared_from_this<CQLStatementCache> {
+ public:
+  explicit CQLStatementCache(MemTrackerPtr mem_tracker);
+  ~CQLStatementCache();
+
+  // Register the cache as the garbage collector of its memory tracker.
+  void CompleteInit();
+
+  // Allocate a statement. If the statement already exists, return it instead.
+  std::shared_ptr<CQLStatement> Allocate(
+      const CQLMessage::QueryId& id, const std::string& keyspace, const std::string& query);
+
+  // Look up a prepared statement by its id. Nullptr will be returned if the statement is not found
+  // or has not finished preparing. Stale statements are deleted from the cache.
+  std::shared_ptr<CQLStatement> Get(const CQLMessage::QueryId& id);
+
+  // Delete the statement from the cache.
+  void Delete(const std::shared_ptr<const CQLStatement>& stmt);
+
+  // Return the memory tracker for the parse trees of the cached statements.
+  const MemTrackerPtr& mem_tracker() const {
+    return mem_tracker_;
+  }
+
+ private:
+  // Delete a statement from the cache and the LRU list. "mutex_" needs to be locked before this
+  // call. The statement is passed by value, so it could be the very shared_ptr being deleted.
+  void DeleteUnlocked(std::shared_ptr<const CQLStatement> stmt);
+
+  // Delete the least recently used statement from the cache to free up memory.
+  void CollectGarbage(size_t required) override;
+
+  const MemTrackerPtr mem_tracker_;
+
+  // Mutex that protects the statements and the LRU list.
+  std::mutex mutex_;
+
+  // Cached statements.
+  CQLStatementMap stmts_map_;
+
+  // Statements LRU list (least recently used one at the end).
+  CQLStatementList stmts_list_;
+};
+
 }  // namespace cqlserver
 }  // namespace yb
 
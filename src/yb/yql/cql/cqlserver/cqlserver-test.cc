@@ -28,6 +28,11 @@
 
 DECLARE_bool(cql_server_always_send_events);
 
+METRIC_DECLARE_counter(cql_unprepared_stmt_cache_hits);
+METRIC_DECLARE_counter(cql_unprepared_stmt_cache_misses);
+METRIC_DECLARE_histogram(handler_latency_yb_cqlserver_SQLProcessor_ParseRequest);
+METRIC_DECLARE_histogram(handler_latency_yb_cqlserver_SQLProcessor_AnalyzeRequest);
+
 namespace yb {
 namespace cqlserver {
 
@@ -50,6 +55,8 @@ class TestCQLService : public YBTableTestBase {
   void SendRequestAndExpectResponse(const string& cmd, const string& resp);
 
   int server_port() { return cql_server_port_; }
+
+  const scoped_refptr<MetricEntity>& metric_entity() { return server_->metric_entity(); }
  private:
   Status SendRequestAndGetResponse(
       const string& cmd, int expected_resp_length, int timeout_in_millis = 60000);
@@ -392,6 +399,74 @@ TEST_F(TestCQLService, SchemaChangeEvent) {
   TestSchemaChangeEvent();
 }
 
+namespace {
+
+// Build QUERY request using version V4 with consistency ONE and no flags.
+string MakeQueryRequest(const string& query) {
+  string body;
+  const uint32_t query_length = query.length();
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    body.push_back(static_cast<char>((query_length >> shift) & 0xff));
+  }
+  body += query;
+  body += BINARY_STRING("\x00\x01" "\x00");
+
+  string request = BINARY_STRING("\x04\x00\x00\x00\x07");
+  const uint32_t body_length = body.length();
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    request.push_back(static_cast<char>((body_length >> shift) & 0xff));
+  }
+  return request + body;
+}
+
+} // namespace
+
+TEST_F(TestCQLService, UnpreparedStatementCache) {
+  // Create keyspace "kong" and table schema_meta.
+  TestSchemaChangeEvent();
+
+  auto hits = METRIC_cql_unprepared_stmt_cache_hits.Instantiate(metric_entity());
+  auto misses = METRIC_cql_unprepared_stmt_cache_misses.Instantiate(metric_entity());
+  auto parse_time =
+      METRIC_handler_latency_yb_cqlserver_SQLProcessor_ParseRequest.Instantiate(metric_entity());
+  auto analyze_time =
+      METRIC_handler_latency_yb_cqlserver_SQLProcessor_AnalyzeRequest.Instantiate(
+          metric_entity());
+  const auto initial_hits = hits->value();
+  const auto initial_misses = misses->value();
+  const auto initial_parses = parse_time->histogram()->TotalCount();
+  const auto initial_parse_us = parse_time->histogram()->TotalSum();
+  const auto initial_analyze_us = analyze_time->histogram()->TotalSum();
+
+  // The same INSERT is parsed and analyzed only once. Expecting VOID results.
+  constexpr int kNumQueries = 100;
+  const string request = MakeQueryRequest(
+      "INSERT INTO schema_meta (key, subsystem, last_executed) VALUES ('k', 's', 'x')");
+  for (int i = 0; i != kNumQueries; ++i) {
+    SendRequestAndExpectResponse(
+        request, BINARY_STRING("\x84\x00\x00\x00\x08" "\x00\x00\x00\x04" "\x00\x00\x00\x01"));
+  }
+
+  ASSERT_EQ(initial_misses + 1, misses->value());
+  ASSERT_EQ(initial_hits + kNumQueries - 1, hits->value());
+  ASSERT_EQ(initial_parses + 1, parse_time->histogram()->TotalCount());
+
+  const auto prepare_us = parse_time->histogram()->TotalSum() - initial_parse_us +
+                          analyze_time->histogram()->TotalSum() - initial_analyze_us;
+  LOG(INFO) << "Parse and analyze time: " << prepare_us << "us, saved by " << kNumQueries - 1
+            << " cache hits: ~" << prepare_us * (kNumQueries - 1) << "us";
+
+  // Statements other than DML are not cached.
+  const string use_request = MakeQueryRequest("USE \"kong\"");
+  for (int i = 0; i != 2; ++i) {
+    SendRequestAndExpectResponse(
+        use_request,
+        BINARY_STRING("\x84\x00\x00\x00\x08" "\x00\x00\x00\x0a" "\x00\x00\x00\x03"
+                                  "\x00\x04" "kong"));
+  }
+  ASSERT_EQ(initial_misses + 3, misses->value());
+}
+
 class TestCQLServiceWithGFlag : public TestCQLService {
  public:
   void SetUp() override {
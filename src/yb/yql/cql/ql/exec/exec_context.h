@@ -20,6 +20,8 @@
 #ifndef YB_YQL_CQL_QL_EXEC_EXEC_CONTEXT_H_
 #define YB_YQL_CQL_QL_EXEC_EXEC_CONTEXT_H_
 
+#include <algorithm>
+
 #include "yb/yql/cql/ql/ptree/process_context.h"
 #include "yb/yql/cql/ql/util/ql_env.h"
 #include "yb/yql/cql/ql/util/statement_params.h"
@@ -120,6 +122,34 @@ class TnodeContext {
     partitions_count_ = count;
   }
 
+  uint64_t partitions_count() const {
+    return partitions_count_;
+  }
+
+  // Used for multi-partition selects that read up to partition_read_window() partitions in
+  // parallel. The op is the template for reads of the next partitions, its request references the
+  // last partition that was started to read. Returns 0 window if partitions are read one by one.
+  size_t partition_read_window() const {
+    return partition_read_window_;
+  }
+  const client::YBqlReadOpPtr& partition_read_op() const {
+    return partition_read_op_;
+  }
+
+  // The window starts with 2 partitions, so a select whose first partition fills the page reads
+  // at most one partition in vain. It grows up to max_window as partitions finish without
+  // filling the page.
+  void SetPartitionReadOp(const client::YBqlReadOpPtr& select_op, size_t max_window) {
+    partition_read_op_ = select_op;
+    partition_read_max_window_ = max_window;
+    partition_read_window_ = std::min<size_t>(2, max_window);
+  }
+
+  // Invoked when a partition was read completely and the page still has room for more rows.
+  void GrowPartitionReadWindow() {
+    partition_read_window_ = std::min(partition_read_window_ * 2, partition_read_max_window_);
+  }
+
   // Access functions for child tnode context.
   TnodeContext* AddChildTnode(const TreeNode* tnode) {
     DCHECK(!child_context_);
@@ -164,6 +194,12 @@ class TnodeContext {
   uint64_t partitions_count_ = 0;
   uint64_t current_partition_index_ = 0;
 
+  // For multi-partition selects that read partitions in parallel: number of partitions read at
+  // the same time, its upper bound and the read op template for the next partition.
+  size_t partition_read_window_ = 0;
+  size_t partition_read_max_window_ = 0;
+  client::YBqlReadOpPtr partition_read_op_;
+
   // Rows result of this statement tnode for DML statements.
   RowsResult::SharedPtr rows_result_;
 
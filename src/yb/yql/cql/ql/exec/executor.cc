@@ -33,11 +33,20 @@
 
 #include "yb/rpc/thread_pool.h"
 #include "yb/util/decimal.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/random_util.h"
 #include "yb/util/thread_restrictions.h"
 #include "yb/util/trace.h"
 
+DEFINE_int32(cql_max_parallel_partition_reads, 16,
+             "Max number of partitions read in parallel by a SELECT with IN condition on the hash "
+             "columns. The select starts with 2 parallel reads and doubles their number each "
+             "time a partition is read without filling the page. 1 to read the partitions one "
+             "by one.");
+TAG_FLAG(cql_max_parallel_partition_reads, advanced);
+TAG_FLAG(cql_max_parallel_partition_reads, runtime);
+
 namespace yb {
 namespace ql {
 
@@ -935,6 +944,7 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
   // Set the consistency level for the operation. Always use strong consistency for system tables.
   select_op->set_yb_consistency_level(tnode->is_system() ? YBConsistencyLevel::STRONG
                                                          : params.yb_consistency_level());
+  select_op->set_max_staleness(params.max_staleness());
 
   // If we have several hash partitions (i.e. IN condition on hash columns) we initialize the
   // start partition here, and then iteratively scan the rest in FetchMoreRows.
@@ -952,12 +962,35 @@ Status Executor::ExecPTNode(const PTSelectStmt *tnode, TnodeContext* tnode_conte
         YBqlReadOpPtr op(table->NewQLSelect());
         op->mutable_request()->CopyFrom(select_op->request());
         op->set_yb_consistency_level(select_op->yb_consistency_level());
+        op->set_max_staleness(select_op->max_staleness());
         tnode_context->AdvanceToNextPartition(op->mutable_request());
         RETURN_NOT_OK(AddOperation(op, tnode_context));
         select_op = op; // Use new op as base for the next one, if any.
       }
       return Status::OK();
     }
+
+    // Otherwise, read up to cql_max_parallel_partition_reads partitions at the same time. The
+    // window starts small and grows while partitions return fewer rows than the page needs. The
+    // rows are still returned in the partition order, so the results and paging state are the same
+    // as if the partitions were read one by one (see ProcessPartitionReads).
+    const auto window = FLAGS_cql_max_parallel_partition_reads;
+    if (window > 1 && tnode_context->UnreadPartitionsRemaining() > 1 && !req->has_offset() &&
+        !tnode->is_aggregate() && !tnode->is_system() && !tnode->child_select() &&
+        !exec_context_->HasTransaction()) {
+      YBqlReadOpPtr template_op(table->NewQLSelect());
+      template_op->mutable_request()->CopyFrom(*req);
+      template_op->mutable_request()->clear_paging_state();
+      template_op->set_yb_consistency_level(select_op->yb_consistency_level());
+      template_op->set_max_staleness(select_op->max_staleness());
+      tnode_context->SetPartitionReadOp(template_op, window);
+
+      req->mutable_paging_state()->set_next_partition_index(
+          tnode_context->current_partition_index());
+      RETURN_NOT_OK(AddOperation(select_op, tnode_context));
+      RETURN_NOT_OK(ReadNextPartitions(tnode_context, req->limit()));
+      return Status::OK();
+    }
   }
 
   // If this select statement uses an uncovered index underneath, save this op as a template to
@@ -1092,6 +1125,167 @@ Result<bool> Executor::FetchMoreRows(const PTSelectStmt* tnode,
 }
 
 
+Result<bool> Executor::ReadNextPartitions(TnodeContext* tnode_context, uint64_t limit) {
+  const YBqlReadOpPtr& template_op = tnode_context->partition_read_op();
+  bool has_new_ops = false;
+  while (tnode_context->ops().size() < tnode_context->partition_read_window() &&
+         tnode_context->UnreadPartitionsRemaining() > 1) {
+    tnode_context->AdvanceToNextPartition(template_op->mutable_request());
+    YBqlReadOpPtr op(template_op->table()->NewQLSelect());
+    op->set_yb_consistency_level(template_op->yb_consistency_level());
+    op->set_max_staleness(template_op->max_staleness());
+    QLReadRequestPB* req = op->mutable_request();
+    req->CopyFrom(template_op->request());
+    req->set_limit(limit);
+    // The partition index is not used by the tablet server, it identifies the partition of the op
+    // when the results are processed.
+    req->mutable_paging_state()->set_next_partition_index(
+        tnode_context->current_partition_index());
+    RETURN_NOT_OK(AddOperation(op, tnode_context));
+    has_new_ops = true;
+  }
+  return has_new_ops;
+}
+
+Result<bool> Executor::ProcessPartitionReads(const PTSelectStmt* tnode,
+                                             TnodeContext* tnode_context) {
+  // Rows read in previous fetches (for paging selects).
+  const size_t previous_fetches_row_count = exec_context_->params().total_num_rows_read();
+
+  // The limit for this fetch: min of page size and result limit (if set).
+  uint64_t fetch_limit = exec_context_->params().page_size();
+  if (tnode->limit()) {
+    QLExpressionPB limit_pb;
+    RETURN_NOT_OK(PTExprToPB(tnode->limit(), &limit_pb));
+    const int64_t limit = limit_pb.value().int32_value() - previous_fetches_row_count;
+    if (limit < static_cast<int64_t>(fetch_limit)) {
+      fetch_limit = std::max<int64_t>(limit, 0);
+    }
+  }
+
+  // Ops are ordered by partition index. The rows of a partition are returned only after all rows
+  // of the preceding partitions, so the ops of the next partitions that completed early are kept
+  // as is until then.
+  bool has_buffered_ops = false;
+  bool preceding_partition_pending = false;
+  bool fetch_done = false;
+  boost::optional<QLPagingStatePB> paging_state;
+  auto& ops = tnode_context->ops();
+  for (auto op_itr = ops.begin(); op_itr != ops.end(); ) {
+    if (fetch_done) {
+      // Rows read ahead for the partitions after the end of this fetch are discarded, the next
+      // fetch reads them again.
+      op_itr = ops.erase(op_itr);
+      continue;
+    }
+    if (preceding_partition_pending) {
+      op_itr++;
+      continue;
+    }
+
+    DCHECK_EQ((*op_itr)->type(), YBOperation::Type::QL_READ);
+    const auto op = std::static_pointer_cast<YBqlReadOp>(*op_itr);
+    QLReadRequestPB* req = op->mutable_request();
+    const uint64_t partition_index = req->paging_state().next_partition_index();
+    const size_t row_limit = fetch_limit - tnode_context->row_count();
+
+    // The read of this partition was started when more rows fitted into this fetch. Read it
+    // again with the actual limit.
+    const size_t op_row_count = op->rows_data().empty() ?
+        0 : VERIFY_RESULT(QLRowBlock::GetRowCount(YQL_CLIENT_CQL, op->rows_data()));
+    if (op_row_count > row_limit) {
+      req->set_limit(row_limit);
+      op->mutable_response()->Clear();
+      op->mutable_rows_data()->clear();
+      TRACE("Apply");
+      RETURN_NOT_OK(session_->Apply(op));
+      has_buffered_ops = true;
+      preceding_partition_pending = true;
+      op_itr++;
+      continue;
+    }
+
+    if (!op->rows_data().empty()) {
+      RETURN_NOT_OK(tnode_context->AppendRowsResult(std::make_shared<RowsResult>(op.get())));
+    }
+
+    // If there is no paging state or the paging state contains only num_rows_skipped, the
+    // partition is finished.
+    const QLResponsePB& response = op->response();
+    const bool partition_finished =
+        !response.has_paging_state() ||
+        (response.paging_state().next_partition_key().empty() &&
+         response.paging_state().next_row_key().empty());
+    const size_t total_row_count = previous_fetches_row_count + tnode_context->row_count();
+
+    if (tnode_context->row_count() >= fetch_limit) {
+      // Resume from the exact place where we left off: partition index and primary key within
+      // that partition.
+      fetch_done = true;
+      if (req->return_paging_state() &&
+          (!partition_finished || partition_index + 1 < tnode_context->partitions_count())) {
+        paging_state.emplace();
+        paging_state->set_total_num_rows_read(total_row_count);
+        paging_state->set_table_id(tnode->table()->id());
+        if (partition_finished) {
+          paging_state->set_next_partition_index(partition_index + 1);
+        } else {
+          paging_state->set_next_partition_index(partition_index);
+          paging_state->set_next_partition_key(response.paging_state().next_partition_key());
+          paging_state->set_next_row_key(response.paging_state().next_row_key());
+        }
+        paging_state->set_original_request_id(exec_context_->params().request_id());
+      }
+      op_itr = ops.erase(op_itr);
+      continue;
+    }
+
+    if (!partition_finished) {
+      // Continue reading this partition, the next partitions wait for it.
+      QLPagingStatePB* req_paging_state = req->mutable_paging_state();
+      req_paging_state->set_next_partition_key(response.paging_state().next_partition_key());
+      req_paging_state->set_next_row_key(response.paging_state().next_row_key());
+      req_paging_state->set_total_num_rows_read(total_row_count);
+      req->set_limit(fetch_limit - tnode_context->row_count());
+      op->mutable_response()->Clear();
+      TRACE("Apply");
+      RETURN_NOT_OK(session_->Apply(op));
+      has_buffered_ops = true;
+      preceding_partition_pending = true;
+      op_itr++;
+      continue;
+    }
+
+    // The partition did not fill the page, so more partitions could be read at the same time.
+    tnode_context->GrowPartitionReadWindow();
+
+    // Remove the op of the finished partition.
+    op_itr = ops.erase(op_itr);
+  }
+
+  if (!fetch_done) {
+    // Keep the window of partitions read in parallel full.
+    const uint64_t limit = fetch_limit - tnode_context->row_count();
+    if (VERIFY_RESULT(ReadNextPartitions(tnode_context, limit))) {
+      has_buffered_ops = true;
+    }
+    if (!ops.empty()) {
+      return has_buffered_ops;
+    }
+  }
+
+  // The select is done for this fetch.
+  if (!tnode_context->rows_result()) {
+    RETURN_NOT_OK(tnode_context->AppendRowsResult(std::make_shared<RowsResult>(tnode)));
+  }
+  if (paging_state) {
+    tnode_context->rows_result()->SetPagingState(*paging_state);
+  } else {
+    tnode_context->rows_result()->ClearPagingState();
+  }
+  return has_buffered_ops;
+}
+
 Result<bool> Executor::FetchRowsByKeys(const PTSelectStmt* tnode,
                                        const YBqlReadOpPtr& select_op,
                                        const QLRowBlock& keys,
@@ -1100,6 +1294,7 @@ Result<bool> Executor::FetchRowsByKeys(const PTSelectStmt* tnode,
   for (const QLRow& key : keys.rows()) {
     YBqlReadOpPtr op(tnode->table()->NewQLSelect());
     op->set_yb_consistency_level(select_op->yb_consistency_level());
+    op->set_max_staleness(select_op->max_staleness());
     QLReadRequestPB* req = op->mutable_request();
     req->CopyFrom(select_op->request());
     RETURN_NOT_OK(WhereKeyToPB(req, schema, key));
@@ -1775,6 +1970,11 @@ Result<bool> Executor::ProcessTnodeResults(TnodeContext* tnode_context) {
 
   // Go through each op in a TnodeContext and process async results.
   const TreeNode *tnode = tnode_context->tnode();
+  if (tnode_context->partition_read_window() > 0) {
+    DCHECK_EQ(tnode->opcode(), TreeNodeOpcode::kPTSelectStmt);
+    return ProcessPartitionReads(static_cast<const PTSelectStmt *>(tnode), tnode_context);
+  }
+
   auto& ops = tnode_context->ops();
   for (auto op_itr = ops.begin(); op_itr != ops.end(); ) {
     YBqlOpPtr& op = *op_itr;
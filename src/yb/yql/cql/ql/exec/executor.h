@@ -220,6 +220,14 @@ class Executor : public QLExprExecutor {
                              TnodeContext* tnode_context,
                              ExecContext* exec_context);
 
+  // Process results of a multi-partition select that reads several partitions in parallel.
+  // Returns true if there are new ops being buffered to be flushed.
+  Result<bool> ProcessPartitionReads(const PTSelectStmt* tnode, TnodeContext* tnode_context);
+
+  // Start reads of the next partitions of a multi-partition select, as long as its window of
+  // partitions read in parallel is not full. Returns true if new ops were buffered.
+  Result<bool> ReadNextPartitions(TnodeContext* tnode_context, uint64_t limit);
+
   // Fetch rows for a select statement using primary keys selected from an uncovered index.
   Result<bool> FetchRowsByKeys(const PTSelectStmt* tnode,
                                const client::YBqlReadOpPtr& select_op,
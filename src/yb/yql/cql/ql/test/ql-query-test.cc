@@ -31,6 +31,8 @@ using std::unique_ptr;
 using std::shared_ptr;
 using strings::Substitute;
 
+DECLARE_int32(cql_max_parallel_partition_reads);
+
 namespace yb {
 namespace ql {
 
@@ -864,6 +866,72 @@ TEST_F(TestQLQuery, TestPagingState) {
   }
 }
 
+namespace {
+
+// Reads all pages of the select and returns the rows and number of pages read.
+std::pair<string, int> ReadAllPages(TestQLProcessor* processor, const string& select_stmt,
+                                    int page_size) {
+  StatementParameters params;
+  params.set_page_size(page_size);
+  string rows;
+  int page_count = 0;
+  do {
+    CHECK_OK(processor->Run(select_stmt, params));
+    auto row_block = processor->row_block();
+    CHECK_LE(row_block->row_count(), page_size);
+    rows.append(row_block->ToString());
+    page_count++;
+    if (processor->rows_result()->paging_state().empty()) {
+      break;
+    }
+    CHECK_OK(params.SetPagingState(processor->rows_result()->paging_state()));
+  } while (true);
+  return std::make_pair(rows, page_count);
+}
+
+} // namespace
+
+TEST_F(TestQLQuery, TestParallelPartitionReads) {
+  // Init the simulated cluster.
+  ASSERT_NO_FATALS(CreateSimulatedCluster());
+
+  // Get a processor.
+  TestQLProcessor *processor = GetQLProcessor();
+
+  CHECK_VALID_STMT("CREATE TABLE t (h int, r int, v int, primary key((h), r)) "
+                   "WITH CLUSTERING ORDER BY (r DESC);");
+
+  // Partitions of different sizes, some of them empty.
+  static constexpr int kNumKeys = 20;
+  string in_list;
+  for (int h = 0; h < kNumKeys; h++) {
+    for (int r = 0; r < h % 7; r++) {
+      CHECK_VALID_STMT(Substitute("INSERT INTO t (h, r, v) VALUES ($0, $1, $2);", h, r, h + r));
+    }
+    in_list += (h == 0 ? "" : ", ") + std::to_string(kNumKeys - 1 - h);
+  }
+
+  for (const string& select_stmt : {
+           Substitute("SELECT h, r, v FROM t WHERE h IN ($0);", in_list),
+           Substitute("SELECT h, r, v FROM t WHERE h IN ($0) AND r > 1;", in_list),
+           Substitute("SELECT h, r, v FROM t WHERE h IN ($0) LIMIT 13;", in_list),
+           Substitute("SELECT h, r, v FROM t WHERE h IN ($0) ORDER BY r ASC;", in_list)}) {
+    for (int page_size : {1, 4, 7, 1000}) {
+      // Partitions read one by one are the reference.
+      FLAGS_cql_max_parallel_partition_reads = 1;
+      const auto expected = ReadAllPages(processor, select_stmt, page_size);
+      for (int window : {2, 5, kNumKeys * 2}) {
+        FLAGS_cql_max_parallel_partition_reads = window;
+        const auto result = ReadAllPages(processor, select_stmt, page_size);
+        ASSERT_EQ(expected.first, result.first) << select_stmt << ", page size: " << page_size
+                                                << ", window: " << window;
+        ASSERT_EQ(expected.second, result.second) << select_stmt << ", page size: " << page_size
+                                                  << ", window: " << window;
+      }
+    }
+  }
+}
+
 #define RUN_PAGINATION_WITH_DESC_TEST(processor, type, values, rows)                               \
 do {                                                                                               \
   /* Creating the table. */                                                                        \
@@ -23,6 +23,7 @@
 #include "yb/common/common_fwd.h"
 #include "yb/common/ql_protocol.pb.h"
 
+#include "yb/util/monotime.h"
 #include "yb/util/status.h"
 
 namespace yb {
@@ -78,6 +79,11 @@ class StatementParameters {
     return yb_consistency_level_;
   }
 
+  // Max staleness of data read with BOUNDED_STALENESS consistency level.
+  MonoDelta max_staleness() const {
+    return max_staleness_;
+  }
+
   void set_request_id(uint64_t value) {
     request_id_ = value;
   }
@@ -91,6 +97,10 @@ class StatementParameters {
     yb_consistency_level_ = yb_consistency_level;
   }
 
+  void set_max_staleness(MonoDelta max_staleness) {
+    max_staleness_ = max_staleness;
+  }
+
  private:
   const QLPagingStatePB& paging_state() const {
     return paging_state_ != nullptr ? *paging_state_ : QLPagingStatePB::default_instance();
@@ -105,6 +115,9 @@ class StatementParameters {
   // Consistency level for YB.
   YBConsistencyLevel yb_consistency_level_;
 
+  // Staleness bound for YB consistency level BOUNDED_STALENESS.
+  MonoDelta max_staleness_;
+
   // Unique identifier of call that initiated this request.
   uint64_t request_id_;
 };
@@ -247,7 +247,7 @@ Status PgDml::Fetch(int32_t natts,
   }
 
   // Load data from cache in doc_op_ to cursor_ if it is not pointing to any data.
-  if (cursor_.empty()) {
+  if (cursor_.empty() && columnar_cursor_.empty()) {
     int64_t row_count = 0;
     // Keep reading untill we either reach the end or get some rows.
     while (row_count == 0) {
@@ -258,8 +258,12 @@ Status PgDml::Fetch(int32_t natts,
       }
 
       // Read from cache.
-      RETURN_NOT_OK(doc_op_->GetResult(&row_batch_));
-      RETURN_NOT_OK(PgDocData::LoadCache(row_batch_, &row_count, &cursor_));
+      RETURN_NOT_OK(doc_op_->GetResult(&row_batch_, &rows_data_format_));
+      if (rows_data_format_ == PGSQL_ROWS_DATA_COLUMNAR) {
+        RETURN_NOT_OK(columnar_cursor_.Load(row_batch_, &row_count));
+      } else {
+        RETURN_NOT_OK(PgDocData::LoadCache(row_batch_, &row_count, &cursor_));
+      }
     }
 
     accumulated_row_count_ += row_count;
@@ -274,7 +278,14 @@ Status PgDml::Fetch(int32_t natts,
 }
 
 Status PgDml::WritePgTuple(PgTuple *pg_tuple) {
+  const bool columnar = rows_data_format_ == PGSQL_ROWS_DATA_COLUMNAR;
+  if (columnar && columnar_cursor_.column_count() != targets_.size()) {
+    return STATUS_FORMAT(Corruption, "Expected $0 columns in result, found $1",
+                         targets_.size(), columnar_cursor_.column_count());
+  }
+
   int attr_num = 0;
+  size_t column = 0;
   for (const PgExpr *target : targets_) {
     if (!target->is_colref() && !target->is_aggregate()) {
       return STATUS(InternalError,
@@ -285,8 +296,17 @@ Status PgDml::WritePgTuple(PgTuple *pg_tuple) {
     } else {
       attr_num++;
     }
-    PgWireDataHeader header = PgDocData::ReadDataHeader(&cursor_);
-    target->TranslateData(&cursor_, header, attr_num - 1, pg_tuple);
+    if (columnar) {
+      PgWireDataHeader header = columnar_cursor_.ReadDataHeader(column);
+      target->TranslateData(columnar_cursor_.column_cursor(column), header, attr_num - 1, pg_tuple);
+    } else {
+      PgWireDataHeader header = PgDocData::ReadDataHeader(&cursor_);
+      target->TranslateData(&cursor_, header, attr_num - 1, pg_tuple);
+    }
+    ++column;
+  }
+  if (columnar) {
+    columnar_cursor_.NextRow();
   }
   return Status::OK();
 }
@@ -19,6 +19,7 @@
 #include "yb/yql/pggate/pg_session.h"
 #include "yb/yql/pggate/pg_statement.h"
 #include "yb/yql/pggate/pg_doc_op.h"
+#include "yb/yql/pggate/util/pg_doc_data.h"
 
 namespace yb {
 namespace pggate {
@@ -137,6 +138,10 @@ class PgDml : public PgStatement {
   // Cursor.
   Slice cursor_;
 
+  // Encoding of row_batch_ and cursor used when it is columnar.
+  PgsqlRowsDataFormat rows_data_format_ = PGSQL_ROWS_DATA_ROWWISE;
+  PgColumnarCursor columnar_cursor_;
+
   // Total number of rows that have been found.
   int64_t accumulated_row_count_ = 0;
 
@@ -15,6 +15,8 @@
 #include "yb/yql/pggate/pg_doc_op.h"
 #include "yb/yql/pggate/pg_txn_manager.h"
 
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 
 #include "yb/client/table.h"
@@ -25,6 +27,7 @@
 #include "yb/yql/pggate/pggate_if_cxx_decl.h"
 
 #include "yb/common/pgsql_error.h"
+#include "yb/common/ql_value.h"
 #include "yb/common/transaction_error.h"
 #include "yb/util/yb_pg_errcodes.h"
 #include "yb/yql/pggate/ybc_pggate.h"
@@ -102,7 +105,7 @@ void PgDocOp::InitUnlocked(std::unique_lock<std::mutex>* lock) {
   has_cached_data_ = false;
 }
 
-Status PgDocOp::GetResult(string *result_set) {
+Status PgDocOp::GetResult(string *result_set, PgsqlRowsDataFormat *rows_data_format) {
   std::unique_lock<std::mutex> lock(mtx_);
   if (is_canceled_) {
     return STATUS(IllegalState, "Operation canceled");
@@ -121,7 +124,7 @@ Status PgDocOp::GetResult(string *result_set) {
   RETURN_NOT_OK(exec_status_);
 
   // Read from cache.
-  ReadFromCacheUnlocked(result_set);
+  ReadFromCacheUnlocked(result_set, rows_data_format);
 
   // This will pre-fetch the next chunk of data if we've consumed all cached
   // rows.
@@ -132,14 +135,17 @@ Status PgDocOp::GetResult(string *result_set) {
 
 void PgDocOp::WriteToCacheUnlocked(std::shared_ptr<client::YBPgsqlOp> yb_op) {
   if (!yb_op->rows_data().empty()) {
-    result_cache_.push_back(yb_op->rows_data());
+    result_cache_.push_back({yb_op->rows_data(), yb_op->response().rows_data_format()});
     has_cached_data_ = !result_cache_.empty();
   }
 }
 
-void PgDocOp::ReadFromCacheUnlocked(string *result) {
+void PgDocOp::ReadFromCacheUnlocked(string *result, PgsqlRowsDataFormat *rows_data_format) {
   if (!result_cache_.empty()) {
-    *result = result_cache_.front();
+    *result = std::move(result_cache_.front().rows_data);
+    if (rows_data_format) {
+      *rows_data_format = result_cache_.front().rows_data_format;
+    }
     result_cache_.pop_front();
     has_cached_data_ = !result_cache_.empty();
   }
@@ -147,7 +153,7 @@ void PgDocOp::ReadFromCacheUnlocked(string *result) {
 
 Status PgDocOp::SendRequestIfNeededUnlocked() {
   // Request more data if more execution is needed and cache is empty.
-  if (!has_cached_data_ && !end_of_data_ && !waiting_for_response_) {
+  if ((!has_cached_data_ || ShouldPrefetchUnlocked()) && !end_of_data_ && !waiting_for_response_) {
     return SendRequestUnlocked();
   }
   return Status::OK();
@@ -187,8 +193,10 @@ void PgDocOp::HandleResponseStatus(client::YBPgsqlOp* op) {
 
 PgDocReadOp::PgDocReadOp(
     PgSession::ScopedRefPtr pg_session,
-    client::YBPgsqlReadOp *read_op)
-    : PgDocOp(std::move(pg_session)), read_op_(read_op) {
+    PgTableDesc::ScopedRefPtr table_desc)
+    : PgDocOp(std::move(pg_session)),
+      table_desc_(std::move(table_desc)),
+      read_op_(table_desc_->NewPgsqlSelect()) {
 }
 
 PgDocReadOp::~PgDocReadOp() {
@@ -198,6 +206,69 @@ void PgDocReadOp::InitUnlocked(std::unique_lock<std::mutex>* lock) {
   PgDocOp::InitUnlocked(lock);
 
   read_op_->mutable_request()->set_return_paging_state(true);
+
+  InitParallelScanUnlocked();
+}
+
+bool PgDocReadOp::CanScanInParallel() const {
+  if (FLAGS_ysql_scan_parallelism <= 1) {
+    return false;
+  }
+
+  // Only full scans of hash partitioned tables are split. Rows of such tables are returned in hash
+  // order, so the executor does not expect any order across tablets. Index scans and backward
+  // scans could rely on the order of rows, so they are executed sequentially.
+  // Scans with pushed down aggregates are split as well. Each response carries partial aggregate
+  // values of the rows it covers, and the executor combines values of all responses, the same way
+  // it does for responses of different tablets in a sequential scan.
+  const PgsqlReadRequestPB& req = read_op_->request();
+  const auto& table = *table_desc_->table();
+  return table.partition_schema().IsHashPartitioning() &&
+         table.GetPartitions().size() > 1 &&
+         req.is_forward_scan() &&
+         !req.has_index_request() &&
+         !req.has_paging_state() &&
+         req.partition_column_values().empty() &&
+         IsNull(req.ybctid_column_value().value()) &&
+         !req.has_hash_code() &&
+         !req.has_max_hash_code();
+}
+
+void PgDocReadOp::InitParallelScanUnlocked() {
+  active_partition_ops_.clear();
+  pending_partition_ops_.clear();
+  parallel_scan_ = CanScanInParallel();
+  if (!parallel_scan_) {
+    return;
+  }
+
+  const auto& partitions = table_desc_->table()->GetPartitions();
+  for (size_t i = 0; i != partitions.size(); ++i) {
+    PartitionReadOp partition_op;
+    partition_op.op.reset(table_desc_->NewPgsqlSelect());
+    *partition_op.op->mutable_request() = read_op_->request();
+    partition_op.op->set_yb_consistency_level(read_op_->yb_consistency_level());
+    partition_op.op->set_max_staleness(read_op_->max_staleness());
+    partition_op.op->SetReadTime(read_op_->read_time());
+    // Paging state with just the partition key routes the request to the beginning of the
+    // partition, the same way as it is done when scan moves to the next tablet.
+    if (!partitions[i].empty()) {
+      partition_op.op->mutable_request()->mutable_paging_state()->set_next_partition_key(
+          partitions[i]);
+    }
+    if (i + 1 != partitions.size()) {
+      partition_op.partition_key_end = partitions[i + 1];
+    }
+    pending_partition_ops_.push_back(std::move(partition_op));
+  }
+  VLOG(1) << "Scan " << read_op_->request().table_id() << " in parallel, partitions: "
+          << partitions.size() << ", parallelism: " << FLAGS_ysql_scan_parallelism;
+}
+
+bool PgDocReadOp::ShouldPrefetchUnlocked() const {
+  // Keep next batch of partition reads in flight while the executor consumes cached rows,
+  // but do not let the cache grow beyond one batch.
+  return parallel_scan_ && result_cache_.size() < static_cast<size_t>(FLAGS_ysql_scan_parallelism);
 }
 
 void PgDocReadOp::SetRequestPrefetchLimit() {
@@ -239,6 +310,10 @@ Status PgDocReadOp::SendRequestUnlocked() {
   SetRequestPrefetchLimit();
   SetRowMark();
 
+  if (parallel_scan_) {
+    return SendParallelRequestsUnlocked();
+  }
+
   auto apply_outcome = VERIFY_RESULT(pg_session_->PgApplyAsync(read_op_, &read_time_));
   SCHECK_EQ(apply_outcome.buffered, OpBuffered::kFalse,
             IllegalState, "YSQL read operation should not be buffered");
@@ -302,6 +377,95 @@ void PgDocReadOp::ReceiveResponse(Status exec_status) {
   }
 }
 
+Status PgDocReadOp::SendParallelRequestsUnlocked() {
+  while (active_partition_ops_.size() < static_cast<size_t>(FLAGS_ysql_scan_parallelism) &&
+         !pending_partition_ops_.empty()) {
+    active_partition_ops_.push_back(std::move(pending_partition_ops_.front()));
+    pending_partition_ops_.pop_front();
+  }
+
+  // Prefetch limit is split between partitions that are read concurrently, so the batch does not
+  // fetch more rows than a sequential scan would.
+  const PgsqlReadRequestPB& template_req = read_op_->request();
+  DCHECK(!active_partition_ops_.empty());
+  const int64_t num_ops = active_partition_ops_.size();
+  const int64_t partition_limit = std::max<int64_t>(
+      1, (static_cast<int64_t>(template_req.limit()) + num_ops - 1) / num_ops);
+  client::YBSessionPtr yb_session;
+  for (auto& partition_op : active_partition_ops_) {
+    PgsqlReadRequestPB* req = partition_op.op->mutable_request();
+    req->set_limit(partition_limit);
+    if (template_req.has_row_mark_type()) {
+      req->set_row_mark_type(template_req.row_mark_type());
+    } else {
+      req->clear_row_mark_type();
+    }
+
+    auto apply_outcome = VERIFY_RESULT(pg_session_->PgApplyAsync(partition_op.op, &read_time_));
+    SCHECK_EQ(apply_outcome.buffered, OpBuffered::kFalse,
+              IllegalState, "YSQL read operation should not be buffered");
+    DCHECK(!yb_session || yb_session == apply_outcome.yb_session);
+    yb_session = apply_outcome.yb_session;
+  }
+
+  // All partitions are flushed in one batch, so requests to different tablets are sent
+  // concurrently.
+  waiting_for_response_ = true;
+  Status s = pg_session_->PgFlushAsync([self = shared_from(this)](const Status& s) {
+                                         self->ReceiveParallelResponse(s);
+                                       }, yb_session);
+  if (!s.ok()) {
+    waiting_for_response_ = false;
+    return s;
+  }
+  return Status::OK();
+}
+
+void PgDocReadOp::ReceiveParallelResponse(Status exec_status) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  CHECK(waiting_for_response_);
+  cv_.notify_all();
+  waiting_for_response_ = false;
+  exec_status_ = exec_status;
+
+  if (exec_status.ok()) {
+    for (const auto& partition_op : active_partition_ops_) {
+      HandleResponseStatus(partition_op.op.get());
+      if (!exec_status_.ok()) {
+        break;
+      }
+    }
+  }
+
+  if (!exec_status_.ok() || is_canceled_) {
+    end_of_data_ = true;
+    return;
+  }
+
+  auto write_iterator = active_partition_ops_.begin();
+  for (auto& partition_op : active_partition_ops_) {
+    WriteToCacheUnlocked(partition_op.op);
+
+    // Partition is done when there is no paging state, or when the paging state points to
+    // the next partition.
+    const PgsqlResponsePB& res = partition_op.op->response();
+    if (!res.has_paging_state() ||
+        (!partition_op.partition_key_end.empty() &&
+         res.paging_state().next_partition_key() >= partition_op.partition_key_end)) {
+      continue;
+    }
+
+    PgsqlReadRequestPB *req = partition_op.op->mutable_request();
+    *req->mutable_paging_state() = res.paging_state();
+    req->clear_ysql_catalog_version();
+    *write_iterator = std::move(partition_op);
+    ++write_iterator;
+  }
+  active_partition_ops_.erase(write_iterator, active_partition_ops_.end());
+
+  end_of_data_ = active_partition_ops_.empty() && pending_partition_ops_.empty();
+}
+
 //--------------------------------------------------------------------------------------------------
 
 PgDocWriteOp::PgDocWriteOp(PgSession::ScopedRefPtr pg_session, client::YBPgsqlWriteOp *write_op)
@@ -15,6 +15,7 @@
 #ifndef YB_YQL_PGGATE_PG_DOC_OP_H_
 #define YB_YQL_PGGATE_PG_DOC_OP_H_
 
+#include <deque>
 #include <mutex>
 #include <condition_variable>
 
@@ -52,8 +53,10 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
   // Execute the op. Return true if the request has been sent and is awaiting the result.
   virtual Result<RequestSent> Execute();
 
-  // Get the result of the op.
-  virtual CHECKED_STATUS GetResult(string *result_set);
+  // Get the result of the op. Encoding of the result is stored in rows_data_format when it is not
+  // null.
+  virtual CHECKED_STATUS GetResult(string *result_set,
+                                   PgsqlRowsDataFormat *rows_data_format = nullptr);
 
   // Access functions.
   Status exec_status() {
@@ -71,12 +74,17 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
 
   // Caching and reading return result.
   void WriteToCacheUnlocked(std::shared_ptr<client::YBPgsqlOp> yb_op);
-  void ReadFromCacheUnlocked(string* result);
+  void ReadFromCacheUnlocked(string* result, PgsqlRowsDataFormat* rows_data_format);
 
   // Send another request if no request is pending and we've already consumed
   // all data in the cache.
   CHECKED_STATUS SendRequestIfNeededUnlocked();
 
+  // Whether the next request should be sent before all data in the cache is consumed.
+  virtual bool ShouldPrefetchUnlocked() const {
+    return false;
+  }
+
   // Sets exec_status_ based on the operation result.
   void HandleResponseStatus(client::YBPgsqlOp* op);
 
@@ -109,7 +117,11 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
   bool is_canceled_ = false;
 
   // Caching state variables.
-  std::list<string> result_cache_;
+  struct CachedResult {
+    string rows_data;
+    PgsqlRowsDataFormat rows_data_format;
+  };
+  std::list<CachedResult> result_cache_;
 
   // Exec control parameters.
   PgExecParameters exec_params_;
@@ -130,7 +142,7 @@ class PgDocReadOp : public PgDocOp {
   typedef scoped_refptr<PgDocReadOp> ScopedRefPtr;
 
   // Constructors & Destructors.
-  PgDocReadOp(PgSession::ScopedRefPtr pg_session, client::YBPgsqlReadOp *read_op);
+  PgDocReadOp(PgSession::ScopedRefPtr pg_session, PgTableDesc::ScopedRefPtr table_desc);
   virtual ~PgDocReadOp();
 
   // Access function.
@@ -142,6 +154,7 @@ class PgDocReadOp : public PgDocOp {
   // Process response from DocDB.
   void InitUnlocked(std::unique_lock<std::mutex>* lock) override;
   CHECKED_STATUS SendRequestUnlocked() override;
+  bool ShouldPrefetchUnlocked() const override;
   virtual void ReceiveResponse(Status exec_status);
 
   // Analyze options and pick the appropriate prefetch limit.
@@ -150,8 +163,38 @@ class PgDocReadOp : public PgDocOp {
   // Set the row_mark_type field of our read request based on our exec control parameter.
   void SetRowMark();
 
+  // Whether the request scans the whole table without any ordering requirements, so its tablets
+  // could be read concurrently.
+  bool CanScanInParallel() const;
+
+  // Split the scan into one read operation per table partition.
+  void InitParallelScanUnlocked();
+
+  // Send requests for up to ysql_scan_parallelism partitions in one batch.
+  CHECKED_STATUS SendParallelRequestsUnlocked();
+  void ReceiveParallelResponse(Status exec_status);
+
+  // Read operation restricted to a single table partition, used by parallel scan.
+  struct PartitionReadOp {
+    std::shared_ptr<client::YBPgsqlReadOp> op;
+    // Exclusive end of the partition, empty for the last partition.
+    std::string partition_key_end;
+  };
+
+  // Table descriptor.
+  PgTableDesc::ScopedRefPtr table_desc_;
+
   // Operator.
   std::shared_ptr<client::YBPgsqlReadOp> read_op_;
+
+  // Whether the scan is executed by partition read ops instead of read_op_.
+  bool parallel_scan_ = false;
+
+  // Partitions that are being read, i.e. were sent at least once and have more data.
+  std::vector<PartitionReadOp> active_partition_ops_;
+
+  // Partitions that were not sent yet.
+  std::deque<PartitionReadOp> pending_partition_ops_;
 };
 
 class PgDocWriteOp : public PgDocOp {
@@ -205,7 +248,8 @@ class PgDocCompoundOp : public PgDocOp {
   virtual Result<RequestSent> Execute() {
     return RequestSent::kTrue;
   }
-  virtual CHECKED_STATUS GetResult(string *result_set) {
+  virtual CHECKED_STATUS GetResult(string *result_set,
+                                   PgsqlRowsDataFormat *rows_data_format = nullptr) {
     return Status::OK();
   }
 
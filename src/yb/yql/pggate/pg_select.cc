@@ -14,6 +14,7 @@
 //--------------------------------------------------------------------------------------------------
 
 #include "yb/yql/pggate/pg_select.h"
+#include "yb/yql/pggate/pggate_flags.h"
 #include "yb/yql/pggate/util/pg_doc_data.h"
 #include "yb/client/yb_op.h"
 #include "yb/docdb/primitive_value.h"
@@ -50,9 +51,11 @@ Status PgSelect::Prepare() {
   }
 
   // Allocate READ/SELECT operation.
-  auto doc_op = make_shared<PgDocReadOp>(
-      pg_session_, table_desc_->NewPgsqlSelect());
+  auto doc_op = make_shared<PgDocReadOp>(pg_session_, table_desc_);
   read_req_ = doc_op->read_op()->mutable_request();
+  if (FLAGS_ysql_columnar_rows_data) {
+    read_req_->set_rows_data_format(PGSQL_ROWS_DATA_COLUMNAR);
+  }
   if (index_id_.IsValid()) {
     index_req_ = read_req_->mutable_index_request();
     index_req_->set_table_id(index_id_.GetYBTableId());
@@ -566,6 +566,14 @@ Result<PgApplyOutcome> PgSession::PgApplyAsync(
 
 
   auto session = VERIFY_RESULT(GetSessionForOp(op));
+  if (op->type() == YBOperation::Type::PGSQL_READ && session != session_.get()) {
+    auto follower_read_staleness = pg_txn_manager_->follower_read_staleness();
+    if (follower_read_staleness.Initialized()) {
+      auto* read_op = down_cast<client::YBPgsqlReadOp*>(op.get());
+      read_op->set_yb_consistency_level(YBConsistencyLevel::BOUNDED_STALENESS);
+      read_op->set_max_staleness(follower_read_staleness);
+    }
+  }
   if (read_time && session != session_.get()) {
     if (!*read_time) {
       *read_time = clock_->Now().ToUint64();
@@ -19,6 +19,7 @@
 #include "yb/client/transaction.h"
 
 #include "yb/common/common.pb.h"
+#include "yb/common/read_hybrid_time.h"
 
 #include "yb/tserver/tserver_shared_mem.h"
 #include "yb/tserver/tserver_service.proxy.h"
@@ -30,6 +31,7 @@ namespace {
 
 uint64_t txn_priority_lower_bound = 0;
 uint64_t txn_priority_upper_bound = std::numeric_limits<uint64_t>::max();
+int follower_read_staleness_ms = 0;
 
 // Converts double value in range 0..1 to uint64_t value in range
 // 0..std::numeric_limits<uint64_t>::max()
@@ -55,6 +57,10 @@ void YBCAssignTransactionPriorityUpperBound(double newval, void* extra) {
   txn_priority_upper_bound = ConvertBound(newval);
 }
 
+void YBCAssignFollowerReadStalenessMs(int newval, void* extra) {
+  follower_read_staleness_ms = newval;
+}
+
 }
 
 using namespace std::literals;
@@ -144,6 +150,14 @@ Status PgTxnManager::BeginWriteTransactionIfNecessary(bool read_only_op) {
     if (defer) {
       // This call is idempotent, meaning it has no affect after the first call.
       session_->DeferReadPoint();
+    } else if (read_only_ && follower_read_staleness_ms > 0 &&
+               !follower_read_staleness_.Initialized()) {
+      // Read only transaction could read from the closest replica at the time that is stale by
+      // the configured bound, see BOUNDED_STALENESS. Read time is picked once per transaction,
+      // so all tablets are read at the same consistent snapshot.
+      follower_read_staleness_ = MonoDelta::FromMilliseconds(follower_read_staleness_ms);
+      session_->SetReadPoint(ReadHybridTime::FromMicros(
+          clock_->Now().GetPhysicalValueMicros() - follower_read_staleness_.ToMicroseconds()));
     }
   } else {
     if (tserver_shared_object_) {
@@ -266,6 +280,7 @@ void PgTxnManager::ResetTxnAndSession() {
   txn_in_progress_ = false;
   session_ = nullptr;
   txn_ = nullptr;
+  follower_read_staleness_ = MonoDelta();
   can_restart_.store(true, std::memory_order_release);
 }
 
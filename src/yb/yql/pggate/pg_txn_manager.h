@@ -24,6 +24,7 @@
 #include "yb/common/clock.h"
 #include "yb/gutil/ref_counted.h"
 #include "yb/tserver/tserver_util_fwd.h"
+#include "yb/util/monotime.h"
 #include "yb/util/result.h"
 
 namespace yb {
@@ -71,6 +72,10 @@ class PgTxnManager : public RefCountedThreadSafe<PgTxnManager> {
 
   bool IsDdlMode() const { return ddl_session_.get() != nullptr; }
 
+  // Staleness bound of the current read only transaction that reads from followers, not
+  // initialized otherwise.
+  MonoDelta follower_read_staleness() const { return follower_read_staleness_; }
+
  private:
 
   client::TransactionManager* GetOrCreateTransactionManager();
@@ -93,6 +98,7 @@ class PgTxnManager : public RefCountedThreadSafe<PgTxnManager> {
   PgIsolationLevel isolation_level_ = PgIsolationLevel::REPEATABLE_READ;
   bool read_only_ = false;
   bool deferrable_ = false;
+  MonoDelta follower_read_staleness_;
 
   client::YBTransactionPtr ddl_txn_;
   client::YBSessionPtr ddl_session_;
@@ -51,6 +51,13 @@ DEFINE_int32(ysql_prefetch_limit, 1024,
 DEFINE_double(ysql_backward_prefetch_scale_factor, 0.0625 /* 1/16th */,
               "Scale factor to reduce ysql_prefetch_limit for backward scan");
 
+DEFINE_int32(ysql_scan_parallelism, 1,
+             "Maximum number of tablets that a full table scan of a hash partitioned table reads "
+             "concurrently. 1 means that tablets are read one by one.");
+
+DEFINE_bool(ysql_columnar_rows_data, false,
+            "Request tablet servers to return rows of YSQL reads in columnar format.");
+
 DEFINE_int32(ysql_session_max_batch_size, 512,
              "Maximum batch size for buffered writes between PostgreSQL server and YugaByte DocDB "
              "services");
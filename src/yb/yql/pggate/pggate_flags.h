@@ -25,6 +25,8 @@ DECLARE_int32(pggate_tserver_shm_fd);
 DECLARE_bool(pggate_ignore_tserver_shm);
 DECLARE_int32(ysql_prefetch_limit);
 DECLARE_double(ysql_backward_prefetch_scale_factor);
+DECLARE_int32(ysql_scan_parallelism);
+DECLARE_bool(ysql_columnar_rows_data);
 DECLARE_int32(ysql_session_max_batch_size);
 DECLARE_bool(ysql_non_txn_copy);
 DECLARE_int32(ysql_max_read_restart_attempts);
@@ -0,0 +1,192 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/yql/pggate/util/pg_doc_data.h"
+
+#include "yb/common/ql_value.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace pggate {
+
+namespace {
+
+constexpr int kNumColumns = 4;
+
+// Fills result set with rows of (int64, int32, double, text) columns, where every 7th value of
+// the int32 column is NULL.
+void FillResultSet(int num_rows, PgsqlResultSet* result_set) {
+  for (int i = 0; i != num_rows; ++i) {
+    auto* row = result_set->AllocateRSRow(kNumColumns);
+    row->rscol(0)->set_int64_value(i);
+    if (i % 7 != 0) {
+      row->rscol(1)->set_int32_value(i * 3);
+    }
+    row->rscol(2)->set_double_value(i / 2.0);
+    row->rscol(3)->set_string_value(std::string("value_") + std::to_string(i));
+  }
+}
+
+// Sums numeric values and text lengths, so decoding of all values is not optimized out.
+struct Checksum {
+  int64_t int64_sum = 0;
+  int64_t int32_sum = 0;
+  double double_sum = 0;
+  int64_t text_size = 0;
+  int64_t nulls = 0;
+
+  bool operator==(const Checksum& rhs) const {
+    return int64_sum == rhs.int64_sum && int32_sum == rhs.int32_sum &&
+           double_sum == rhs.double_sum && text_size == rhs.text_size && nulls == rhs.nulls;
+  }
+
+  void Add(int column, const PgWireDataHeader& header, Slice* cursor) {
+    if (header.is_null()) {
+      ++nulls;
+      return;
+    }
+    switch (column) {
+      case 0: {
+        int64_t value;
+        cursor->remove_prefix(PgWire::ReadNumber(cursor, &value));
+        int64_sum += value;
+        return;
+      }
+      case 1: {
+        int32_t value;
+        cursor->remove_prefix(PgWire::ReadNumber(cursor, &value));
+        int32_sum += value;
+        return;
+      }
+      case 2: {
+        double value;
+        cursor->remove_prefix(PgWire::ReadNumber(cursor, &value));
+        double_sum += value;
+        return;
+      }
+      case 3: {
+        int64_t size;
+        cursor->remove_prefix(PgWire::ReadNumber(cursor, &size));
+        cursor->remove_prefix(size);
+        text_size += size;
+        return;
+      }
+    }
+    FAIL() << "Unexpected column: " << column;
+  }
+};
+
+Checksum DecodeRowwise(const string& data) {
+  Checksum result;
+  Slice cursor;
+  int64_t row_count;
+  CHECK_OK(PgDocData::LoadCache(data, &row_count, &cursor));
+  for (int64_t row = 0; row != row_count; ++row) {
+    for (int column = 0; column != kNumColumns; ++column) {
+      auto header = PgDocData::ReadDataHeader(&cursor);
+      result.Add(column, header, &cursor);
+    }
+  }
+  CHECK(cursor.empty());
+  return result;
+}
+
+Checksum DecodeColumnar(const string& data) {
+  Checksum result;
+  PgColumnarCursor cursor;
+  int64_t row_count;
+  CHECK_OK(cursor.Load(data, &row_count));
+  CHECK_EQ(cursor.column_count(), static_cast<size_t>(kNumColumns));
+  for (int64_t row = 0; row != row_count; ++row) {
+    for (int column = 0; column != kNumColumns; ++column) {
+      result.Add(column, cursor.ReadDataHeader(column), cursor.column_cursor(column));
+    }
+    cursor.NextRow();
+  }
+  CHECK(cursor.empty());
+  return result;
+}
+
+} // namespace
+
+class PgDocDataTest : public YBTest {
+};
+
+TEST_F(PgDocDataTest, Columnar) {
+  for (int num_rows : {0, 1, 7, 8, 9, 1000}) {
+    PgsqlResultSet result_set;
+    FillResultSet(num_rows, &result_set);
+
+    faststring rowwise;
+    ASSERT_OK(PgDocData::WriteTuples(result_set, &rowwise));
+    faststring columnar;
+    ASSERT_OK(PgDocData::WriteColumnarTuples(result_set, &columnar));
+
+    ASSERT_EQ(DecodeRowwise(rowwise.ToString()), DecodeColumnar(columnar.ToString()))
+        << "Rows: " << num_rows;
+  }
+}
+
+TEST_F(PgDocDataTest, Truncated) {
+  PgsqlResultSet result_set;
+  FillResultSet(100, &result_set);
+  faststring columnar;
+  ASSERT_OK(PgDocData::WriteColumnarTuples(result_set, &columnar));
+
+  auto data = columnar.ToString();
+  data.resize(data.size() - 1);
+  PgColumnarCursor cursor;
+  int64_t row_count;
+  ASSERT_NOK(cursor.Load(data, &row_count));
+  ASSERT_TRUE(cursor.empty());
+}
+
+// Compares size and decode time of rowwise and columnar formats.
+TEST_F(PgDocDataTest, YB_DISABLE_TEST_IN_TSAN(Benchmark)) {
+  constexpr int kNumRows = 1024;
+  constexpr int kIterations = 2000;
+
+  PgsqlResultSet result_set;
+  FillResultSet(kNumRows, &result_set);
+
+  faststring rowwise_buffer;
+  ASSERT_OK(PgDocData::WriteTuples(result_set, &rowwise_buffer));
+  faststring columnar_buffer;
+  ASSERT_OK(PgDocData::WriteColumnarTuples(result_set, &columnar_buffer));
+  const auto rowwise = rowwise_buffer.ToString();
+  const auto columnar = columnar_buffer.ToString();
+
+  auto measure = [](const string& data, Checksum (*decode)(const string&)) {
+    auto start = MonoTime::Now();
+    Checksum checksum;
+    for (int i = 0; i != kIterations; ++i) {
+      checksum = decode(data);
+    }
+    return std::make_pair(MonoTime::Now() - start, checksum);
+  };
+
+  auto rowwise_result = measure(rowwise, &DecodeRowwise);
+  auto columnar_result = measure(columnar, &DecodeColumnar);
+  ASSERT_EQ(rowwise_result.second, columnar_result.second);
+
+  LOG(INFO) << "Rowwise: " << rowwise.size() << " bytes, decode time: "
+            << rowwise_result.first / kIterations;
+  LOG(INFO) << "Columnar: " << columnar.size() << " bytes, decode time: "
+            << columnar_result.first / kIterations;
+}
+
+} // namespace pggate
+} // namespace yb
@@ -60,6 +60,10 @@ Status PgDocData::WriteColumn(const QLValue& col_value, faststring *buffer) {
     return Status::OK();
   }
 
+  return WriteValue(col_value, buffer);
+}
+
+Status PgDocData::WriteValue(const QLValue& col_value, faststring *buffer) {
   switch (col_value.type()) {
     case InternalType::VALUE_NOT_SET:
       break;
@@ -124,6 +128,46 @@ Status PgDocData::WriteColumn(const QLValue& col_value, faststring *buffer) {
   return Status::OK();
 }
 
+//--------------------------------------------------------------------------------------------------
+// Write Tuple Routine in columnar format.
+//--------------------------------------------------------------------------------------------------
+Status PgDocData::WriteColumnarTuples(const PgsqlResultSet& tuples, faststring *buffer) {
+  const auto& rows = tuples.rsrows();
+  const size_t row_count = rows.size();
+  const size_t column_count = row_count == 0 ? 0 : rows.front().rscol_count();
+  WriteInt64(row_count, buffer);
+  WriteInt32(column_count, buffer);
+
+  const size_t bitmap_size = NullBitmapSize(row_count);
+  for (size_t column = 0; column != column_count; ++column) {
+    // Null bitmap.
+    const size_t bitmap_start = buffer->size();
+    buffer->resize(bitmap_start + bitmap_size);
+    memset(buffer->data() + bitmap_start, 0, bitmap_size);
+    for (size_t row = 0; row != row_count; ++row) {
+      if (rows[row].rscol_value(column).IsNull()) {
+        buffer->data()[bitmap_start + row / 8] |= 1 << (row % 8);
+      }
+    }
+
+    // Size of column data is written before the data, so reader could find start of each column
+    // without parsing values. Patched after the data is written.
+    const size_t size_start = buffer->size();
+    WriteUint32(0, buffer);
+    const size_t data_start = buffer->size();
+    for (const auto& row : rows) {
+      const QLValue& value = row.rscol_value(column);
+      if (!value.IsNull()) {
+        RETURN_NOT_OK(WriteValue(value, buffer));
+      }
+    }
+    faststring data_size;
+    WriteUint32(buffer->size() - data_start, &data_size);
+    memcpy(buffer->data() + size_start, data_size.data(), data_size.size());
+  }
+  return Status::OK();
+}
+
 //--------------------------------------------------------------------------------------------------
 // Read Tuple Routine in DocDB Format (wire_protocol).
 //--------------------------------------------------------------------------------------------------
@@ -151,5 +195,46 @@ PgWireDataHeader PgDocData::ReadDataHeader(Slice *cursor) {
   return PgWireDataHeader(header_data);
 }
 
+//--------------------------------------------------------------------------------------------------
+// Read Tuple Routine in columnar format.
+//--------------------------------------------------------------------------------------------------
+
+Status PgColumnarCursor::Load(const string& data, int64_t *row_count) {
+  CHECK(empty()) << "Existing cache is not yet fully read";
+  Slice cursor(data);
+  columns_.clear();
+  next_row_ = 0;
+  row_count_ = 0;
+
+  if (cursor.size() < sizeof(int64_t) + sizeof(int32_t)) {
+    return STATUS(Corruption, "Columnar rows data is too short");
+  }
+  int64_t rows;
+  cursor.remove_prefix(PgWire::ReadNumber(&cursor, &rows));
+  int32_t column_count;
+  cursor.remove_prefix(PgWire::ReadNumber(&cursor, &column_count));
+
+  const size_t bitmap_size = NullBitmapSize(rows);
+  columns_.reserve(column_count);
+  for (int32_t i = 0; i != column_count; ++i) {
+    if (cursor.size() < bitmap_size + sizeof(uint32_t)) {
+      return STATUS_FORMAT(Corruption, "Columnar rows data is truncated at column $0", i);
+    }
+    const uint8_t* null_bitmap = cursor.data();
+    cursor.remove_prefix(bitmap_size);
+    uint32_t data_size;
+    cursor.remove_prefix(PgWire::ReadNumber(&cursor, &data_size));
+    if (cursor.size() < data_size) {
+      return STATUS_FORMAT(Corruption, "Columnar rows data is truncated at column $0", i);
+    }
+    columns_.push_back(Column{null_bitmap, Slice(cursor.data(), data_size)});
+    cursor.remove_prefix(data_size);
+  }
+
+  row_count_ = rows;
+  *row_count = rows;
+  return Status::OK();
+}
+
 }  // namespace pggate
 }  // namespace yb
@@ -29,9 +29,73 @@ class PgDocData : public PgWire {
 
   static CHECKED_STATUS WriteColumn(const QLValue& col_value, faststring *buffer);
 
+  // Writes value without data header.
+  static CHECKED_STATUS WriteValue(const QLValue& col_value, faststring *buffer);
+
+  // Writes tuples in column major order, see PgColumnarCursor for details.
+  static CHECKED_STATUS WriteColumnarTuples(const PgsqlResultSet& tuples, faststring *buffer);
+
   static CHECKED_STATUS LoadCache(const string& data, int64_t *total_row_count, Slice *cursor);
 
   static PgWireDataHeader ReadDataHeader(Slice *cursor);
+
+  static size_t NullBitmapSize(size_t row_count) {
+    return (row_count + 7) / 8;
+  }
+};
+
+// Reads tuples written by PgDocData::WriteColumnarTuples.
+//
+// Format:
+//   int64 row count, int32 column count, then for each column:
+//   - Null bitmap, one bit per row, set for NULL values.
+//   - uint32 size of column data.
+//   - Column data: non-null values of the column without data headers. Values are encoded as in
+//     the rowwise format, so fixed width values are packed contiguously and the same translate
+//     functions could read them.
+//
+// Each column has its own cursor, so reading a value does not require parsing preceding columns
+// and headers of the row.
+class PgColumnarCursor {
+ public:
+  CHECKED_STATUS Load(const string& data, int64_t *row_count);
+
+  // Whether all loaded rows were read.
+  bool empty() const {
+    return next_row_ >= row_count_;
+  }
+
+  // Header of the value of the current row in specified column.
+  PgWireDataHeader ReadDataHeader(size_t column) const {
+    PgWireDataHeader header;
+    if ((columns_[column].null_bitmap[next_row_ / 8] >> (next_row_ % 8)) & 1) {
+      header.set_null();
+    }
+    return header;
+  }
+
+  // Cursor pointing to the value of the current row in specified column, when it is not null.
+  Slice* column_cursor(size_t column) {
+    return &columns_[column].cursor;
+  }
+
+  size_t column_count() const {
+    return columns_.size();
+  }
+
+  void NextRow() {
+    ++next_row_;
+  }
+
+ private:
+  struct Column {
+    const uint8_t* null_bitmap;
+    Slice cursor;
+  };
+
+  std::vector<Column> columns_;
+  int64_t next_row_ = 0;
+  int64_t row_count_ = 0;
 };
 
 }  // namespace pggate
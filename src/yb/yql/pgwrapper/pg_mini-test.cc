@@ -938,5 +938,65 @@ TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(DropDBWithTables)) {
   ASSERT_EQ(num_tables_before, num_tables_after);
 }
 
+class PgMiniParallelScanTest : public PgMiniTest {
+ protected:
+  void BeforePgProcessStart() override {
+    // Several tablets per server and small prefetch limit, so the scan reads several batches of
+    // partitions, each of them in several pages.
+    FLAGS_ysql_num_shards_per_tserver = 3;
+    FLAGS_ysql_scan_parallelism = 4;
+    FLAGS_ysql_prefetch_limit = 64;
+  }
+};
+
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ParallelScan), PgMiniParallelScanTest) {
+  constexpr int kNumRows = 1000;
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (k INT PRIMARY KEY, v INT)"));
+  ASSERT_OK(conn.Execute("CREATE TABLE r (k INT, v INT, PRIMARY KEY (k ASC))"));
+  for (const auto* table : {"t", "r"}) {
+    ASSERT_OK(conn.ExecuteFormat(
+        "INSERT INTO $0 SELECT i, i * 2 FROM generate_series(0, $1) AS i", table, kNumRows - 1));
+  }
+
+  // Full scan of hash partitioned table returns every row once.
+  {
+    auto res = ASSERT_RESULT(conn.Fetch("SELECT k, v FROM t"));
+    ASSERT_EQ(kNumRows, PQntuples(res.get()));
+    std::vector<bool> seen(kNumRows);
+    for (int i = 0; i != kNumRows; ++i) {
+      auto k = ASSERT_RESULT(GetInt32(res.get(), i, 0));
+      ASSERT_EQ(k * 2, ASSERT_RESULT(GetInt32(res.get(), i, 1)));
+      ASSERT_GE(k, 0);
+      ASSERT_LT(k, kNumRows);
+      ASSERT_FALSE(seen[k]) << "Duplicate key: " << k;
+      seen[k] = true;
+    }
+  }
+
+  // Pushed down aggregates are combined across partitions.
+  ASSERT_EQ(kNumRows, ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")));
+  ASSERT_EQ(kNumRows * (kNumRows - 1),
+            ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT SUM(v) FROM t")));
+
+  // Limit is applied to the combined result.
+  {
+    auto res = ASSERT_RESULT(conn.Fetch("SELECT k FROM t LIMIT 10"));
+    ASSERT_EQ(10, PQntuples(res.get()));
+  }
+
+  // Ordered results keep their order: sort in executor, range partitioned table and backward scan.
+  for (const auto* query : {"SELECT k FROM t ORDER BY k",
+                            "SELECT k FROM r",
+                            "SELECT k FROM r ORDER BY k DESC"}) {
+    auto res = ASSERT_RESULT(conn.Fetch(query));
+    ASSERT_EQ(kNumRows, PQntuples(res.get())) << query;
+    const bool desc = strstr(query, "DESC") != nullptr;
+    for (int i = 0; i != kNumRows; ++i) {
+      ASSERT_EQ(desc ? kNumRows - 1 - i : i, ASSERT_RESULT(GetInt32(res.get(), i, 0))) << query;
+    }
+  }
+}
+
 } // namespace pgwrapper
 } // namespace yb
@@ -686,6 +686,8 @@ class RenameData : public std::enable_shared_from_this<RenameData> {
   }
 
   void Respond(RedisResponsePB* response) {
+    // Rename completes asynchronously, so values read while it was executed are dropped here.
+    data_.context()->service_data()->ClearReadCache();
     data_.Respond(response);
     if (src_functor_) {
       src_functor_(Status::OK());
@@ -1087,6 +1089,7 @@ void FlushDBs(LocalCommandData data, const vector<string> ids) {
     resp.set_code(RedisResponsePB_RedisStatusCode_SERVER_ERROR);
     resp.set_error_message(message.data(), message.size());
   }
+  data.context()->service_data()->ClearReadCache();
   data.Respond(&resp);
 }
 
@@ -1201,6 +1204,7 @@ void HandleDeleteDB(LocalCommandData data) {
   const auto table_name = RedisServiceData::GetYBTableNameForRedisDatabase(db_name);
 
   Status s = data.client()->DeleteTable(table_name, /* wait */ true);
+  data.context()->service_data()->ClearReadCache();
   if (s.ok()) {
     resp.set_code(RedisResponsePB_RedisStatusCode_OK);
   } else if (s.IsNotFound()) {
@@ -1300,6 +1304,39 @@ void RespondWithFailure(
   call->RespondFailure(idx, STATUS_FORMAT(InvalidCommand, "$0 $1: $2", redis_code, cmd, error));
 }
 
+#define READ_KIND RedisCommandKind::kRead
+#define WRITE_KIND RedisCommandKind::kWrite
+#define LOCAL_KIND RedisCommandKind::kLocal
+#define CLUSTER_KIND RedisCommandKind::kLocal
+
+#define DO_POPULATE_KIND(name, cname, arity, type) \
+  result.emplace(BOOST_PP_STRINGIZE(name), BOOST_PP_CAT(type, _KIND));
+#define POPULATE_KIND(z, data, elem) DO_POPULATE_KIND elem
+
+RedisCommandKind GetRedisCommandKind(const Slice& name) {
+  static const std::unordered_map<Slice, RedisCommandKind, Slice::Hash> kinds = [] {
+    std::unordered_map<Slice, RedisCommandKind, Slice::Hash> result;
+    BOOST_PP_SEQ_FOR_EACH(POPULATE_KIND, ~, REDIS_COMMANDS);
+    return result;
+  }();
+  constexpr size_t kMaxNameSize = 32;
+  if (name.size() > kMaxNameSize) {
+    return RedisCommandKind::kLocal;
+  }
+  char lower_name[kMaxNameSize];
+  for (size_t i = 0; i != name.size(); ++i) {
+    lower_name[i] = std::tolower(name[i]);
+  }
+  auto it = kinds.find(Slice(lower_name, name.size()));
+  return it != kinds.end() ? it->second : RedisCommandKind::kLocal;
+}
+
+void AppendRedisCommandKeys(const RedisClientCommand& command, std::vector<Slice>* keys) {
+  if (command.size() > 1) {
+    keys->push_back(command[1]);
+  }
+}
+
 void FillRedisCommands(const scoped_refptr<MetricEntity>& metric_entity,
                        const std::function<void(const RedisCommandInfo& info)>& setup_method) {
   BOOST_PP_SEQ_FOR_EACH(POPULATE_HANDLER, ~, REDIS_COMMANDS);
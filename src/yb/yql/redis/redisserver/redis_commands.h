@@ -24,6 +24,7 @@
 
 #include "yb/rpc/rpc_fwd.h"
 #include "yb/rpc/service_if.h"
+#include "yb/util/enums.h"
 #include "yb/util/result.h"
 
 #include "yb/yql/redis/redisserver/redis_fwd.h"
@@ -70,6 +71,9 @@ class RedisServiceData {
   virtual yb::Result<std::shared_ptr<client::YBTable>> GetYBTableForDB(
       const std::string& db_name) = 0;
 
+  // Used for commands that modify unknown set of keys, when they complete.
+  virtual void ClearReadCache() = 0;
+
   static client::YBTableName GetYBTableNameForRedisDatabase(const std::string& db_name);
 
   virtual ~RedisServiceData() {}
@@ -128,6 +132,18 @@ struct RedisCommandInfo {
 
 typedef std::shared_ptr<RedisCommandInfo> RedisCommandInfoPtr;
 
+YB_DEFINE_ENUM(RedisCommandKind, (kRead)(kWrite)(kLocal));
+
+// Returns kind of command with specified name, case insensitive. Local commands are executed by
+// the proxy itself and could change state of the connection. Unknown commands are reported as
+// local.
+RedisCommandKind GetRedisCommandKind(const Slice& name);
+
+// Appends keys accessed by the specified read or write command to keys. Supported read and write
+// commands access only the key passed as their first argument, MGET and MSET are rejected by the
+// parser.
+void AppendRedisCommandKeys(const RedisClientCommand& command, std::vector<Slice>* keys);
+
 void RespondWithFailure(
     std::shared_ptr<RedisInboundCall> call,
     size_t idx,
@@ -0,0 +1,210 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/yql/redis/redisserver/redis_read_cache.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/metrics.h"
+
+using namespace std::literals;
+
+DEFINE_uint64(redis_read_cache_size_bytes, 0,
+              "Size of the proxy side cache of GET results for hot keys. 0 to disable the cache.");
+TAG_FLAG(redis_read_cache_size_bytes, advanced);
+
+DEFINE_int32(redis_read_cache_ttl_ms, 100,
+             "Max time for which GET result is served from the proxy side cache. Writes done "
+             "through other proxies become visible to cached reads after at most this time.");
+TAG_FLAG(redis_read_cache_ttl_ms, advanced);
+TAG_FLAG(redis_read_cache_ttl_ms, runtime);
+
+DEFINE_int32(redis_read_cache_max_value_size, 4096,
+             "Max size of the value that could be stored in the proxy side cache.");
+TAG_FLAG(redis_read_cache_max_value_size, advanced);
+TAG_FLAG(redis_read_cache_max_value_size, runtime);
+
+METRIC_DEFINE_counter(server, redis_read_cache_hits, "Redis read cache hits",
+                      yb::MetricUnit::kRequests,
+                      "Number of GET commands served from the proxy side cache");
+METRIC_DEFINE_counter(server, redis_read_cache_misses, "Redis read cache misses",
+                      yb::MetricUnit::kRequests,
+                      "Number of GET commands that were not found in the proxy side cache");
+
+namespace yb {
+namespace redisserver {
+
+namespace {
+
+// Approximate memory used by list node and hash map entry.
+constexpr size_t kEntryOverhead = 64;
+
+} // namespace
+
+RedisReadCache::RedisReadCache(
+    size_t capacity, const MemTrackerPtr& parent_mem_tracker,
+    const scoped_refptr<MetricEntity>& metric_entity)
+    : capacity_(capacity),
+      mem_tracker_(MemTracker::FindOrCreateTracker(
+          capacity, "Redis read cache", parent_mem_tracker)) {
+  if (metric_entity) {
+    hits_ = METRIC_redis_read_cache_hits.Instantiate(metric_entity);
+    misses_ = METRIC_redis_read_cache_misses.Instantiate(metric_entity);
+  }
+}
+
+RedisReadCache::~RedisReadCache() {
+  mem_tracker_->Release(size_);
+}
+
+bool RedisReadCache::Enabled() {
+  return FLAGS_redis_read_cache_size_bytes > 0;
+}
+
+uint64_t RedisReadCache::ReadStarted() const {
+  return invalidations_.load(std::memory_order_acquire);
+}
+
+std::string RedisReadCache::MakeKey(const std::string& db_name, const Slice& key) {
+  // Database name is prefixed with its size, so keys of different databases never match.
+  std::string result = std::to_string(db_name.size());
+  result.reserve(result.size() + 1 + db_name.size() + key.size());
+  result += ':';
+  result += db_name;
+  result.append(key.cdata(), key.size());
+  return result;
+}
+
+bool RedisReadCache::Lookup(
+    const std::string& db_name, const Slice& key, RedisResponsePB* response) {
+  auto cache_key = MakeKey(db_name, key);
+  bool found = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = map_.find(Slice(cache_key));
+    if (it != map_.end() && it->second->cached &&
+        it->second->expiration <= CoarseMonoClock::now()) {
+      // Lease expired, the entry is created again to wait for the result of the new read.
+      EraseUnlocked(it->second);
+    }
+    auto entry = FindOrCreateUnlocked(std::move(cache_key));
+    if (entry->cached) {
+      *response = entry->response;
+      found = true;
+    } else {
+      EvictUnlocked();
+    }
+  }
+  auto& counter = found ? hits_ : misses_;
+  if (counter) {
+    counter->Increment();
+  }
+  return found;
+}
+
+void RedisReadCache::Insert(
+    const std::string& db_name, const Slice& key, const RedisResponsePB& response,
+    uint64_t read_start, CoarseTimePoint read_start_time) {
+  if (response.code() != RedisResponsePB::OK && response.code() != RedisResponsePB::NIL) {
+    return;
+  }
+  if (response.string_response().size() >
+          static_cast<size_t>(FLAGS_redis_read_cache_max_value_size)) {
+    return;
+  }
+  auto expiration = read_start_time + FLAGS_redis_read_cache_ttl_ms * 1ms;
+  auto cache_key = MakeKey(db_name, key);
+  size_t charge = sizeof(Entry) + kEntryOverhead + cache_key.size() +
+                  response.string_response().size();
+  if (charge > capacity_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = map_.find(Slice(cache_key));
+  if (it == map_.end()) {
+    // Key was invalidated or evicted since the read was started.
+    return;
+  }
+  auto entry = it->second;
+  if (entry->created_at > read_start || entry->expiration > expiration) {
+    // Key was invalidated after the read was started, or there is fresher result already.
+    return;
+  }
+  entry->response = response;
+  entry->expiration = expiration;
+  entry->cached = true;
+  SetChargeUnlocked(&*entry, charge);
+  EvictUnlocked();
+}
+
+void RedisReadCache::Invalidate(const std::string& db_name, const Slice& key) {
+  auto cache_key = MakeKey(db_name, key);
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Advanced even when there is no entry, since the entry of the read that is in progress could
+  // have been evicted and created again by another read.
+  invalidations_.fetch_add(1, std::memory_order_acq_rel);
+  auto it = map_.find(Slice(cache_key));
+  if (it != map_.end()) {
+    EraseUnlocked(it->second);
+  }
+}
+
+void RedisReadCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  invalidations_.fetch_add(1, std::memory_order_acq_rel);
+  map_.clear();
+  entries_.clear();
+  mem_tracker_->Release(size_);
+  size_ = 0;
+}
+
+RedisReadCache::Entries::iterator RedisReadCache::FindOrCreateUnlocked(std::string key) {
+  auto it = map_.find(Slice(key));
+  if (it != map_.end()) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second;
+  }
+  entries_.emplace_front();
+  auto result = entries_.begin();
+  result->key = std::move(key);
+  result->created_at = invalidations_.load(std::memory_order_acquire);
+  map_.emplace(Slice(result->key), result);
+  SetChargeUnlocked(&*result, sizeof(Entry) + kEntryOverhead + result->key.size());
+  return result;
+}
+
+void RedisReadCache::SetChargeUnlocked(Entry* entry, size_t charge) {
+  if (charge > entry->charge) {
+    mem_tracker_->Consume(charge - entry->charge);
+  } else {
+    mem_tracker_->Release(entry->charge - charge);
+  }
+  size_ = size_ + charge - entry->charge;
+  entry->charge = charge;
+}
+
+void RedisReadCache::EraseUnlocked(Entries::iterator it) {
+  SetChargeUnlocked(&*it, 0);
+  map_.erase(Slice(it->key));
+  entries_.erase(it);
+}
+
+void RedisReadCache::EvictUnlocked() {
+  while (size_ > capacity_ && !entries_.empty()) {
+    EraseUnlocked(std::prev(entries_.end()));
+  }
+}
+
+} // namespace redisserver
+} // namespace yb
@@ -0,0 +1,121 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_YQL_REDIS_REDISSERVER_REDIS_READ_CACHE_H
+#define YB_YQL_REDIS_REDISSERVER_REDIS_READ_CACHE_H
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "yb/common/redis_protocol.pb.h"
+
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/mem_tracker.h"
+#include "yb/util/monotime.h"
+#include "yb/util/slice.h"
+
+namespace yb {
+
+class Counter;
+class MetricEntity;
+
+namespace redisserver {
+
+// Proxy side cache of GET results for hot keys.
+//
+// Each entry is leased for redis_read_cache_ttl_ms since the start of the read that filled it, so
+// writes made through other proxies become visible after at most that time.
+// Writes made through this proxy invalidate the key when they are sent and when they complete.
+// A read fills the cache only if its key was not invalidated after the read was started. To track
+// that without storing every written key, a miss creates an entry that waits for the result of the
+// read, and invalidation just removes the entry of the key when there is one.
+class RedisReadCache {
+ public:
+  RedisReadCache(size_t capacity, const MemTrackerPtr& parent_mem_tracker,
+                 const scoped_refptr<MetricEntity>& metric_entity);
+  ~RedisReadCache();
+
+  // Whether the cache is turned on by redis_read_cache_size_bytes.
+  static bool Enabled();
+
+  // Position of the read that is started now in the sequence of invalidations.
+  // Should be passed to Insert when the read completes.
+  uint64_t ReadStarted() const;
+
+  // Fills response with cached result of GET for the key of the database.
+  // Returns false if the key is not cached or its lease expired, in this case the entry that waits
+  // for the result of the read is created.
+  bool Lookup(const std::string& db_name, const Slice& key, RedisResponsePB* response);
+
+  // Caches result of GET that was started at read_start, see ReadStarted.
+  void Insert(const std::string& db_name, const Slice& key, const RedisResponsePB& response,
+              uint64_t read_start, CoarseTimePoint read_start_time);
+
+  // Invalidates the key of the database, so it is not returned from the cache and reads that are
+  // in progress don't fill the cache with its old value.
+  // Only the key that is cached or being read has an entry to remove.
+  void Invalidate(const std::string& db_name, const Slice& key);
+
+  // Invalidates all keys, used by commands that modify unknown set of keys, like FLUSHDB.
+  void Clear();
+
+ private:
+  struct Entry {
+    std::string key;
+    RedisResponsePB response;
+    CoarseTimePoint expiration;
+    // Position in the sequence of invalidations when the entry was created. Reads started before
+    // it could have missed invalidation of the key, so they don't fill the entry.
+    uint64_t created_at = 0;
+    // Whether the entry stores result of the read, instead of waiting for it.
+    bool cached = false;
+    size_t charge = 0;
+  };
+
+  typedef std::list<Entry> Entries;
+
+  static std::string MakeKey(const std::string& db_name, const Slice& key);
+
+  // Returns entry for the key, creating an empty one when there is no such entry.
+  Entries::iterator FindOrCreateUnlocked(std::string key);
+
+  void SetChargeUnlocked(Entry* entry, size_t charge);
+  void EraseUnlocked(Entries::iterator it);
+  void EvictUnlocked();
+
+  const size_t capacity_;
+  const MemTrackerPtr mem_tracker_;
+
+  scoped_refptr<Counter> hits_;
+  scoped_refptr<Counter> misses_;
+
+  std::atomic<uint64_t> invalidations_{0};
+
+  std::mutex mutex_;
+  // Entries LRU list (least recently used one at the end).
+  Entries entries_;
+  std::unordered_map<Slice, Entries::iterator, Slice::Hash> map_;
+  size_t size_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(RedisReadCache);
+};
+
+} // namespace redisserver
+} // namespace yb
+
+#endif // YB_YQL_REDIS_REDISSERVER_REDIS_READ_CACHE_H
@@ -19,6 +19,7 @@
 
 #include "yb/common/redis_protocol.pb.h"
 
+#include "yb/yql/redis/redisserver/redis_commands.h"
 #include "yb/yql/redis/redisserver/redis_encoding.h"
 #include "yb/yql/redis/redisserver/redis_parser.h"
 
@@ -38,11 +39,14 @@ using namespace std::literals;
 using namespace std::placeholders;
 using namespace yb::size_literals;
 
+DECLARE_bool(redis_safe_batch);
 DECLARE_bool(rpc_dump_all_traces);
 DECLARE_int32(rpc_slow_query_threshold_ms);
 DEFINE_uint64(redis_max_concurrent_commands, 1,
-              "Max number of redis commands received from single connection, "
-              "that could be processed concurrently");
+              "Max number of redis command batches received from single connection, "
+              "that could be processed concurrently. With redis_safe_batch, batch waits for "
+              "earlier batches that access the same keys or contain local commands, and "
+              "responses are always sent in request order.");
 DEFINE_uint64(redis_max_batch, 500, "Max number of redis commands that forms batch");
 DEFINE_int32(rpcz_max_redis_query_dump_size, 4_KB,
              "The maximum size of the Redis query string in the RPCZ dump.");
@@ -241,10 +245,74 @@ Status RedisInboundCall::ParseFrom(
                          end_of_command, request_data_.size());
   }
 
+  if (FLAGS_redis_safe_batch) {
+    FillKeys();
+  }
+
   parsed_.store(true, std::memory_order_release);
   return Status::OK();
 }
 
+namespace {
+
+bool SliceLess(const Slice& lhs, const Slice& rhs) {
+  return lhs.compare(rhs) < 0;
+}
+
+void SortAndUnique(std::vector<Slice>* keys) {
+  std::sort(keys->begin(), keys->end(), SliceLess);
+  keys->erase(std::unique(keys->begin(), keys->end()), keys->end());
+}
+
+bool HaveCommonKeys(const std::vector<Slice>& lhs, const std::vector<Slice>& rhs) {
+  auto lhs_it = lhs.begin();
+  auto rhs_it = rhs.begin();
+  while (lhs_it != lhs.end() && rhs_it != rhs.end()) {
+    int cmp = lhs_it->compare(*rhs_it);
+    if (cmp == 0) {
+      return true;
+    }
+    if (cmp < 0) {
+      ++lhs_it;
+    } else {
+      ++rhs_it;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+void RedisInboundCall::FillKeys() {
+  for (const auto& command : client_batch_) {
+    switch (GetRedisCommandKind(command[0])) {
+      case RedisCommandKind::kRead:
+        AppendRedisCommandKeys(command, &read_keys_);
+        break;
+      case RedisCommandKind::kWrite:
+        AppendRedisCommandKeys(command, &write_keys_);
+        break;
+      case RedisCommandKind::kLocal:
+        has_local_commands_ = true;
+        read_keys_.clear();
+        write_keys_.clear();
+        return;
+    }
+  }
+  SortAndUnique(&read_keys_);
+  SortAndUnique(&write_keys_);
+}
+
+bool RedisInboundCall::ConflictsWith(const rpc::QueueableInboundCall& earlier) const {
+  const auto& earlier_call = down_cast<const RedisInboundCall&>(earlier);
+  if (has_local_commands_ || earlier_call.has_local_commands_) {
+    return true;
+  }
+  return HaveCommonKeys(write_keys_, earlier_call.write_keys_) ||
+         HaveCommonKeys(write_keys_, earlier_call.read_keys_) ||
+         HaveCommonKeys(read_keys_, earlier_call.write_keys_);
+}
+
 const std::string& RedisInboundCall::service_name() const {
   static std::string result = "yb.redisserver.RedisServerService"s;
   return result;
@@ -139,6 +139,8 @@ class RedisInboundCall : public rpc::QueueableInboundCall {
                       RedisResponsePB* resp);
   void MarkForClose() { quit_.store(true, std::memory_order_release); }
 
+  bool ConflictsWith(const rpc::QueueableInboundCall& earlier) const override;
+
   size_t ObjectSize() const override { return sizeof(*this); }
 
   size_t DynamicMemoryUsage() const override {
@@ -147,6 +149,8 @@ class RedisInboundCall : public rpc::QueueableInboundCall {
   }
 
  private:
+  // Fills keys accessed by the batch, used to detect conflicts with other batches.
+  void FillKeys();
 
   // The connection on which this inbound call arrived.
   static constexpr size_t batch_capacity = RedisClientBatch::static_capacity;
@@ -163,6 +167,15 @@ class RedisInboundCall : public rpc::QueueableInboundCall {
   std::atomic<bool> quit_ = {false};
 
   ScopedTrackedConsumption consumption_;
+
+  // Sorted keys read and written by commands of this batch.
+  // Used to check whether batch could be processed concurrently with other batches of the same
+  // connection.
+  std::vector<Slice> read_keys_;
+  std::vector<Slice> write_keys_;
+
+  // Batch contains local command, that should not be processed concurrently with other batches.
+  bool has_local_commands_ = false;
 };
 
 } // namespace redisserver
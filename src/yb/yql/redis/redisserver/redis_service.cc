@@ -45,6 +45,7 @@
 #include "yb/yql/redis/redisserver/redis_constants.h"
 #include "yb/yql/redis/redisserver/redis_encoding.h"
 #include "yb/yql/redis/redisserver/redis_parser.h"
+#include "yb/yql/redis/redisserver/redis_read_cache.h"
 #include "yb/yql/redis/redisserver/redis_rpc.h"
 
 #include "yb/rpc/connection.h"
@@ -123,6 +124,7 @@ DEFINE_int32(redis_password_caching_duration_ms, 5000,
 DEFINE_bool(redis_safe_batch, true, "Use safe batching with Redis service");
 DEFINE_bool(enable_redis_auth, true, "Enable AUTH for the Redis service");
 
+DECLARE_uint64(redis_read_cache_size_bytes);
 DECLARE_string(placement_cloud);
 DECLARE_string(placement_region);
 DECLARE_string(placement_zone);
@@ -266,6 +268,15 @@ class Operation {
     return *call_;
   }
 
+  // Makes operation update the read cache when it completes. Results of reads are stored in
+  // the cache, while keys of writes are invalidated.
+  void UseReadCache(RedisReadCache* read_cache, const std::string* db_name) {
+    read_cache_ = read_cache;
+    db_name_ = db_name;
+    read_start_ = read_cache->ReadStarted();
+    read_start_time_ = CoarseMonoClock::now();
+  }
+
   void GetKeys(RedisKeyList* keys) const {
     if (FLAGS_redis_safe_batch) {
       keys->emplace_back(operation_ ? operation_->GetKey() : Slice());
@@ -299,6 +310,9 @@ class Operation {
 
   void Respond(const Status& status) {
     responded_.store(true, std::memory_order_release);
+    if (read_cache_) {
+      UpdateReadCache(status);
+    }
     if (manual_response_) {
       return;
     }
@@ -323,6 +337,16 @@ class Operation {
   }
 
  private:
+  void UpdateReadCache(const Status& status) {
+    // Write could be applied even when it failed, for instance because of timeout.
+    if (type_ == OperationType::kWrite) {
+      read_cache_->Invalidate(*db_name_, operation_->GetKey());
+    } else if (status.ok()) {
+      read_cache_->Insert(
+          *db_name_, operation_->GetKey(), response(), read_start_, read_start_time_);
+    }
+  }
+
   OperationType type_;
   std::shared_ptr<RedisInboundCall> call_;
   size_t index_;
@@ -333,6 +357,10 @@ class Operation {
   ManualResponse manual_response_;
   client::internal::RemoteTabletPtr tablet_;
   std::atomic<bool> responded_{false};
+  RedisReadCache* read_cache_ = nullptr;
+  const std::string* db_name_ = nullptr;
+  uint64_t read_start_ = 0;
+  CoarseTimePoint read_start_time_;
 };
 
 class SessionPool {
@@ -756,6 +784,7 @@ struct RedisServiceImplData : public RedisServiceData {
   void RemoveFromMonitors(Connection* conn) override;
   void LogToMonitors(const string& end, const string& db, const RedisClientCommand& cmd) override;
   yb::Result<std::shared_ptr<client::YBTable>> GetYBTableForDB(const string& db_name) override;
+  void ClearReadCache() override;
 
   void CleanYBTableFromCacheForDB(const string& table);
 
@@ -794,6 +823,8 @@ struct RedisServiceImplData : public RedisServiceData {
   SessionPool session_pool_;
   std::unordered_map<std::string, std::shared_ptr<client::YBTable>> db_to_opened_table_;
   std::shared_ptr<client::YBMetaDataCache> tables_cache_;
+  // Null when proxy side cache of GET results is disabled.
+  std::unique_ptr<RedisReadCache> read_cache_;
 
   rw_semaphore pubsub_mutex_;
   std::unordered_map<std::string, std::unordered_set<Connection*>> channels_to_clients_;
@@ -893,14 +924,34 @@ class BatchContextImpl : public BatchContext {
       size_t index,
       std::shared_ptr<client::YBRedisReadOp> operation,
       const rpc::RpcMethodMetrics& metrics) override {
-    DoApply(index, std::move(operation), metrics);
+    auto* read_cache = impl_data_->read_cache_.get();
+    if (!read_cache || !IsCacheableRead(*operation)) {
+      DoApply(index, std::move(operation), metrics);
+      return;
+    }
+    RedisResponsePB response;
+    if (read_cache->Lookup(db_name_, operation->GetKey(), &response)) {
+      call_->RespondSuccess(index, metrics, &response);
+      return;
+    }
+    if (DoApply(index, std::move(operation), metrics)) {
+      operations_.back().UseReadCache(read_cache, &db_name_);
+    }
   }
 
   void Apply(
       size_t index,
       std::shared_ptr<client::YBRedisWriteOp> operation,
       const rpc::RpcMethodMetrics& metrics) override {
-    DoApply(index, std::move(operation), metrics);
+    auto* read_cache = impl_data_->read_cache_.get();
+    if (read_cache) {
+      read_cache->Invalidate(db_name_, operation->GetKey());
+    }
+    if (DoApply(index, std::move(operation), metrics) && read_cache) {
+      // Invalidate key again when write completes, so reads that were started before it
+      // completed don't fill the cache with the old value.
+      operations_.back().UseReadCache(read_cache, &db_name_);
+    }
   }
 
   void Apply(
@@ -917,14 +968,22 @@ class BatchContextImpl : public BatchContext {
   }
 
  private:
+  static bool IsCacheableRead(const client::YBRedisReadOp& operation) {
+    const auto& request = operation.request();
+    return request.has_get_request() &&
+           request.get_request().request_type() == RedisGetRequestPB_GetRequestType_GET;
+  }
+
+  // Returns true if operation was added, false if it was responded immediately.
   template <class... Args>
-  void DoApply(Args&&... args) {
+  bool DoApply(Args&&... args) {
     operations_.emplace_back(call_, std::forward<Args>(args)...);
     if (PREDICT_FALSE(operations_.back().responded())) {
       operations_.pop_back();
-    } else {
-      consumption_.Add(operations_.back().space_used_by_request());
+      return false;
     }
+    consumption_.Add(operations_.back().space_used_by_request());
+    return true;
   }
 
   void LookupDone(
@@ -1045,6 +1104,12 @@ RedisServiceImplData::RedisServiceImplData(RedisServer* server, string&& yb_tier
       initialized_(false),
       server_(server) {}
 
+void RedisServiceImplData::ClearReadCache() {
+  if (read_cache_) {
+    read_cache_->Clear();
+  }
+}
+
 yb::Result<std::shared_ptr<client::YBTable>> RedisServiceImplData::GetYBTableForDB(
     const string& db_name) {
   std::shared_ptr<client::YBTable> table;
@@ -1390,6 +1455,10 @@ Status RedisServiceImplData::Initialize() {
     tables_cache_ = std::make_shared<YBMetaDataCache>(
         client_.get(), false /* Update roles permissions cache */);
     session_pool_.Init(client_.get(), server_->metric_entity());
+    if (RedisReadCache::Enabled()) {
+      read_cache_ = std::make_unique<RedisReadCache>(
+          FLAGS_redis_read_cache_size_bytes, server_->mem_tracker(), server_->metric_entity());
+    }
 
     initialized_.store(true, std::memory_order_release);
   }
@@ -1455,6 +1524,11 @@ RedisServiceImpl::Impl::Impl(RedisServer* server, string yb_tier_master_addresse
   PopulateHandlers();
 }
 
+bool ModifiesUnknownKeys(const RedisCommandInfo& info) {
+  static std::unordered_set<string> commands = {"flushdb", "flushall", "deletedb", "rename"};
+  return commands.find(info.name) != commands.end();
+}
+
 bool AllowedInClientMode(const RedisCommandInfo* info, RedisClientMode mode) {
   if (mode == RedisClientMode::kMonitoring) {
     static std::unordered_set<string> allowed = {"quit"};
@@ -1545,6 +1619,12 @@ void RedisServiceImpl::Impl::Handle(rpc::InboundCallPtr call_ptr) {
         data_.LogToMonitors(remote, db_name, c);
       }
 
+      // Commands that modify unknown set of keys invalidate the whole read cache. Their handlers
+      // do it again when they complete, to drop values read while they were executed.
+      if (ModifiesUnknownKeys(*cmd_info)) {
+        data_.ClearReadCache();
+      }
+
       // Handle the call.
       cmd_info->functor(*cmd_info, idx, context.get());
 
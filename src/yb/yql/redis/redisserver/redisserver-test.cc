@@ -38,6 +38,7 @@
 
 #include "yb/util/cast.h"
 #include "yb/util/enums.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/util/protobuf.h"
 #include "yb/util/test_util.h"
 #include "yb/util/value_changer.h"
@@ -62,6 +63,8 @@ DECLARE_int32(rpc_max_message_size);
 DECLARE_int32(consensus_max_batch_size_bytes);
 DECLARE_int32(consensus_rpc_timeout_ms);
 DECLARE_int64(max_time_in_queue_ms);
+DECLARE_uint64(redis_read_cache_size_bytes);
+DECLARE_int32(redis_read_cache_ttl_ms);
 
 DEFINE_uint64(test_redis_max_concurrent_commands, 20,
     "Value of redis_max_concurrent_commands for pipeline test");
@@ -71,6 +74,8 @@ DEFINE_uint64(test_redis_max_batch, 250,
 METRIC_DECLARE_gauge_uint64(redis_available_sessions);
 METRIC_DECLARE_gauge_uint64(redis_allocated_sessions);
 METRIC_DECLARE_gauge_uint64(redis_monitoring_clients);
+METRIC_DECLARE_counter(redis_read_cache_hits);
+METRIC_DECLARE_counter(redis_read_cache_misses);
 
 using namespace std::literals;
 using namespace std::placeholders;
@@ -1337,6 +1342,122 @@ TEST_F_EX(TestRedisService, SafeBatchPipeline, TestRedisServiceSafeBatch) {
   LOG(INFO) << yb::Format("Safe set: $0ms, get: $1ms", set_time.count(), get_time.count());
 }
 
+class TestRedisServiceSafePipelined : public TestRedisService {
+ public:
+  void SetUp() override {
+    FLAGS_redis_safe_batch = true;
+    FLAGS_redis_max_concurrent_commands = FLAGS_test_redis_max_concurrent_commands;
+    FLAGS_redis_max_batch = 1;
+    TestRedisService::SetUp();
+  }
+};
+
+// Each command forms its own batch, so batches of the same connection are processed concurrently,
+// unless they access the same keys or contain local commands.
+TEST_F_EX(TestRedisService, SafePipeline, TestRedisServiceSafePipelined) {
+  constexpr int kKeys = 10;
+  constexpr int kIterations = 500;
+  std::string command;
+  std::string response;
+  for (int i = 0; i != kIterations; ++i) {
+    auto value = std::to_string(i);
+    command += yb::Format("set key_$0 $1\r\nget key_$0\r\n", i % kKeys, value);
+    response += yb::Format("+OK\r\n$$$0\r\n$1\r\n", value.length(), value);
+    if (i % 100 == 99) {
+      command += "echo foo\r\n";
+      response += "$3\r\nfoo\r\n";
+    }
+  }
+  auto start = std::chrono::steady_clock::now();
+  SendCommandAndExpectResponse(__LINE__, command, response);
+  auto time = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  LOG(INFO) << yb::Format("Safe pipeline: $0ms", time.count());
+}
+
+class TestRedisServiceReadCache : public TestRedisService {
+ public:
+  void SetUp() override {
+    FLAGS_redis_read_cache_size_bytes = 1024 * 1024;
+    FLAGS_redis_read_cache_ttl_ms = 60000;
+    TestRedisService::SetUp();
+  }
+};
+
+TEST_F_EX(TestRedisService, ReadCache, TestRedisServiceReadCache) {
+  auto hits = METRIC_redis_read_cache_hits.Instantiate(server_->metric_entity());
+  auto misses = METRIC_redis_read_cache_misses.Instantiate(server_->metric_entity());
+
+  DoRedisTestOk(__LINE__, {"SET", "key", "v1"});
+  SyncClient();
+  // The first GET fills the cache, the following ones are served from it.
+  for (int i = 0; i != 3; ++i) {
+    DoRedisTestBulkString(__LINE__, {"GET", "key"}, "v1");
+    SyncClient();
+  }
+  ASSERT_EQ(1, misses->value());
+  ASSERT_EQ(2, hits->value());
+
+  // Write made through the proxy invalidates the cached value.
+  DoRedisTestOk(__LINE__, {"SET", "key", "v2"});
+  SyncClient();
+  for (int i = 0; i != 2; ++i) {
+    DoRedisTestBulkString(__LINE__, {"GET", "key"}, "v2");
+    SyncClient();
+  }
+  ASSERT_EQ(2, misses->value());
+  ASSERT_EQ(3, hits->value());
+
+  // Write followed by read in the same batch.
+  SendCommandAndExpectResponse(__LINE__, "set key v3\r\nget key\r\n", "+OK\r\n$2\r\nv3\r\n");
+
+  // FLUSHDB drops all cached values.
+  DoRedisTestOk(__LINE__, {"FLUSHDB"});
+  SyncClient();
+  DoRedisTestNull(__LINE__, {"GET", "key"});
+  SyncClient();
+
+  // RENAME drops cached values of both keys when it completes.
+  DoRedisTestOk(__LINE__, {"SET", "key", "v4"});
+  SyncClient();
+  DoRedisTestBulkString(__LINE__, {"GET", "key"}, "v4");
+  SyncClient();
+  DoRedisTestNull(__LINE__, {"GET", "key2"});
+  SyncClient();
+  DoRedisTestOk(__LINE__, {"RENAME", "key", "key2"});
+  SyncClient();
+  DoRedisTestNull(__LINE__, {"GET", "key"});
+  SyncClient();
+  DoRedisTestBulkString(__LINE__, {"GET", "key2"}, "v4");
+  SyncClient();
+
+  // Writes of keys that are not cached don't use the cache memory.
+  auto mem_tracker = MemTracker::FindTracker("Redis read cache", server_->mem_tracker());
+  ASSERT_NE(nullptr, mem_tracker);
+  auto consumption = mem_tracker->consumption();
+  for (int i = 0; i != 10; ++i) {
+    DoRedisTestOk(__LINE__, {"SET", yb::Format("other_key_$0", i), "v"});
+  }
+  SyncClient();
+  ASSERT_EQ(consumption, mem_tracker->consumption());
+
+  VerifyCallbacks();
+}
+
+// Different commands that access the same key conflict, so they are executed in order.
+TEST_F_EX(TestRedisService, SafePipelineSameKey, TestRedisServiceSafePipelined) {
+  constexpr int kIterations = 200;
+  std::string command;
+  std::string response;
+  for (int i = 1; i <= kIterations; ++i) {
+    auto value = std::to_string(i);
+    command += "incr counter\r\nget counter\r\nhincrby hash field 1\r\nhget hash field\r\n";
+    response += yb::Format(
+        ":$0\r\n$$$1\r\n$0\r\n:$0\r\n$$$1\r\n$0\r\n", value, value.length());
+  }
+  SendCommandAndExpectResponse(__LINE__, command, response);
+}
+
 TEST_F(TestRedisService, BatchedCommandMulti) {
   SendCommandAndExpectResponse(
       __LINE__,